@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "reone/game/navmesh.h"
+
+#include "../../test/fixtures/game.h"
+
+using namespace reone;
+using namespace reone::game;
+using namespace reone::graphics;
+
+static constexpr uint32_t kWalkable = 1;
+static constexpr uint32_t kObstacle = 2;
+
+static std::unique_ptr<Walkmesh> makeRandomWalkmesh(int size, std::mt19937 &random) {
+    std::bernoulli_distribution obstacle(0.15);
+
+    std::vector<std::string> rows(size, std::string(size, '.'));
+    for (auto &row : rows) {
+        for (auto &square : row) {
+            if (obstacle(random)) {
+                square = '#';
+            }
+        }
+    }
+    return makeGridWalkmesh(rows, kWalkable, kObstacle);
+}
+
+static void BM_NavMesh_build(benchmark::State &state) {
+    int size = static_cast<int>(state.range(0));
+    std::mt19937 random(42);
+    auto walkmesh = makeRandomWalkmesh(size, random);
+
+    for (auto _ : state) {
+        NavMesh navMesh;
+        navMesh.add(*walkmesh, {kWalkable});
+        navMesh.build();
+        benchmark::DoNotOptimize(navMesh.numFaces());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_NavMesh_findPath(benchmark::State &state) {
+    int size = static_cast<int>(state.range(0));
+    std::mt19937 random(42);
+    auto walkmesh = makeRandomWalkmesh(size, random);
+    NavMesh navMesh;
+    navMesh.add(*walkmesh, {kWalkable});
+    navMesh.build();
+
+    std::uniform_real_distribution<float> coord(0.0f, static_cast<float>(size));
+    std::vector<std::pair<glm::vec3, glm::vec3>> queries;
+    while (queries.size() < 64) {
+        glm::vec3 from(coord(random), coord(random), 0.0f);
+        glm::vec3 to(coord(random), coord(random), 0.0f);
+        if (navMesh.findFace(from) != -1 && navMesh.findFace(to) != -1) {
+            queries.push_back(std::make_pair(from, to));
+        }
+    }
+
+    std::vector<glm::vec3> path;
+    size_t i = 0;
+    for (auto _ : state) {
+        auto &query = queries[i++ % queries.size()];
+        benchmark::DoNotOptimize(navMesh.findPath(query.first, query.second, path));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_NavMesh_build)->Arg(32)->Arg(128);
+BENCHMARK(BM_NavMesh_findPath)->Arg(32)->Arg(128);
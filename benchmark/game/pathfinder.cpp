@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "reone/game/pathfinder.h"
+
+#include "../../test/fixtures/game.h"
+
+using namespace reone;
+using namespace reone::game;
+using namespace reone::resource;
+
+static void BM_Pathfinder_findPath(benchmark::State &state) {
+    int size = static_cast<int>(state.range(0));
+    std::mt19937 random(42);
+    auto points = makeRandomGridGraph(size, random);
+    Pathfinder pathfinder;
+    pathfinder.load(points, std::unordered_map<int, float>());
+
+    std::uniform_real_distribution<float> coord(0.0f, size - 1.0f);
+    std::vector<std::pair<glm::vec3, glm::vec3>> queries;
+    for (int i = 0; i < 64; ++i) {
+        queries.push_back(std::make_pair(
+            glm::vec3(coord(random), coord(random), 0.0f),
+            glm::vec3(coord(random), coord(random), 0.0f)));
+    }
+
+    size_t i = 0;
+    for (auto _ : state) {
+        auto &query = queries[i++ % queries.size()];
+        benchmark::DoNotOptimize(pathfinder.findPath(query.first, query.second));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_Pathfinder_findPathNearby(benchmark::State &state) {
+    int size = static_cast<int>(state.range(0));
+    std::mt19937 random(42);
+    auto points = makeRandomGridGraph(size, random);
+    Pathfinder pathfinder;
+    pathfinder.load(points, std::unordered_map<int, float>());
+
+    // Short re-paths, typical of creatures following a moving target
+    std::uniform_real_distribution<float> coord(0.0f, size - 1.0f);
+    std::uniform_real_distribution<float> offset(-4.0f, 4.0f);
+    std::vector<std::pair<glm::vec3, glm::vec3>> queries;
+    for (int i = 0; i < 64; ++i) {
+        glm::vec3 from(coord(random), coord(random), 0.0f);
+        queries.push_back(std::make_pair(from, from + glm::vec3(offset(random), offset(random), 0.0f)));
+    }
+
+    size_t i = 0;
+    for (auto _ : state) {
+        auto &query = queries[i++ % queries.size()];
+        benchmark::DoNotOptimize(pathfinder.findPath(query.first, query.second));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_Pathfinder_findPath)->Arg(32)->Arg(128);
+BENCHMARK(BM_Pathfinder_findPathNearby)->Arg(32)->Arg(128);
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "reone/game/lineofsightcache.h"
+#include "reone/game/perceptionscheduler.h"
+
+using namespace reone;
+using namespace reone::game;
+
+static constexpr int kNumCreatures = 48;
+static constexpr int kNumWalkmeshFaces = 512;
+static constexpr int kNumFrames = 300;
+static constexpr int kFramesPerInterval = 60;
+
+/**
+ * Synthetic area: creatures wandering over a plane with a number of wall
+ * triangles, line of sight tested against every triangle, like the scene
+ * graph does for walkmeshes.
+ */
+struct PerceptionWorld {
+    std::vector<glm::vec3> positions;
+    std::vector<std::array<glm::vec3, 3>> faces;
+    std::vector<std::vector<bool>> seen;
+
+    PerceptionWorld() {
+        for (int i = 0; i < kNumCreatures; ++i) {
+            positions.push_back(glm::vec3((i * 37 % 61) - 30.0f, (i * 53 % 59) - 29.0f, 0.0f));
+        }
+        for (int i = 0; i < kNumWalkmeshFaces; ++i) {
+            glm::vec3 base((i * 31 % 97) - 48.0f, (i * 17 % 89) - 44.0f, 0.0f);
+            faces.push_back({base, base + glm::vec3(1.0f, 0.0f, 0.0f), base + glm::vec3(0.0f, 0.0f, 3.0f)});
+        }
+        seen.resize(kNumCreatures, std::vector<bool>(kNumCreatures, false));
+    }
+
+    void move(int frame) {
+        // A few creatures walk every frame, the rest stand still
+        for (int i = 0; i < kNumCreatures; i += 8) {
+            float angle = 0.05f * (frame + i);
+            positions[i] += glm::vec3(0.05f * glm::cos(angle), 0.05f * glm::sin(angle), 0.0f);
+        }
+    }
+
+    bool testLineOfSight(int observer, int target) const {
+        glm::vec3 origin(positions[observer] + glm::vec3(0.0f, 0.0f, 1.7f));
+        glm::vec3 dest(positions[target] + glm::vec3(0.0f, 0.0f, 1.7f));
+        glm::vec3 dir(glm::normalize(dest - origin));
+        float maxDistance = glm::distance(origin, dest);
+        for (auto &face : faces) {
+            glm::vec2 baryPosition(0.0f);
+            float distance = 0.0f;
+            if (glm::intersectRayTriangle(origin, dir, face[0], face[1], face[2], baryPosition, distance) && distance < maxDistance) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+static void reportFrameTimes(benchmark::State &state, std::vector<double> &frameTimes) {
+    std::sort(frameTimes.begin(), frameTimes.end());
+    auto percentile = [&frameTimes](double p) {
+        return frameTimes[static_cast<size_t>(p * (frameTimes.size() - 1))];
+    };
+    state.counters["p50_us"] = percentile(0.5);
+    state.counters["p95_us"] = percentile(0.95);
+    state.counters["p99_us"] = percentile(0.99);
+    state.counters["max_us"] = frameTimes.back();
+}
+
+static double getMicroseconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void BM_Perception_allAtOnce(benchmark::State &state) {
+    PerceptionWorld world;
+    std::vector<double> frameTimes;
+    for (auto _ : state) {
+        for (int frame = 0; frame < kNumFrames; ++frame) {
+            world.move(frame);
+            auto start = std::chrono::steady_clock::now();
+            if (frame % kFramesPerInterval == 0) {
+                for (int observer = 0; observer < kNumCreatures; ++observer) {
+                    for (int target = 0; target < kNumCreatures; ++target) {
+                        if (target != observer) {
+                            world.seen[observer][target] = world.testLineOfSight(observer, target);
+                        }
+                    }
+                }
+            }
+            frameTimes.push_back(getMicroseconds(start));
+        }
+    }
+    reportFrameTimes(state, frameTimes);
+}
+
+static void BM_Perception_timeSliced(benchmark::State &state) {
+    PerceptionWorld world;
+    std::vector<double> frameTimes;
+    PerceptionScheduler scheduler(static_cast<int>(state.range(0)));
+    LineOfSightCache cache;
+    std::vector<uint32_t> observerIds;
+    for (int i = 0; i < kNumCreatures; ++i) {
+        observerIds.push_back(i);
+    }
+    for (auto _ : state) {
+        for (int frame = 0; frame < kNumFrames; ++frame) {
+            world.move(frame);
+            auto start = std::chrono::steady_clock::now();
+            if (scheduler.isIdle() && frame % kFramesPerInterval == 0) {
+                scheduler.schedule(observerIds);
+            }
+            scheduler.update([&world, &cache](uint32_t observer) {
+                int rays = 0;
+                for (uint32_t target = 0; target < kNumCreatures; ++target) {
+                    if (target == observer) {
+                        continue;
+                    }
+                    bool visible = false;
+                    if (!cache.get(observer, world.positions[observer], target, world.positions[target], visible)) {
+                        visible = world.testLineOfSight(observer, target);
+                        cache.put(observer, world.positions[observer], target, world.positions[target], visible);
+                        ++rays;
+                    }
+                    world.seen[observer][target] = visible;
+                }
+                return rays;
+            });
+            frameTimes.push_back(getMicroseconds(start));
+        }
+    }
+    reportFrameTimes(state, frameTimes);
+}
+
+BENCHMARK(BM_Perception_allAtOnce);
+BENCHMARK(BM_Perception_timeSliced)->Arg(16)->Arg(64)->Arg(256);
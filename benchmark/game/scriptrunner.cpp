@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "reone/game/script/runner.h"
+#include "reone/resource/provider/scripts.h"
+#include "reone/script/executioncontext.h"
+#include "reone/script/program.h"
+#include "reone/script/routine.h"
+#include "reone/script/routines.h"
+#include "reone/script/verifier.h"
+#include "reone/script/virtualmachine.h"
+
+using namespace reone;
+using namespace reone::game;
+using namespace reone::resource;
+using namespace reone::script;
+
+static constexpr int kNumInvocations = 10000;
+
+// Allocation counting. Replaces global operator new for the whole benchmarks
+// executable, so allocations are only counted on the benchmark thread while
+// counting is enabled, and other benchmarks only pay for a thread-local check.
+
+static thread_local bool t_countAllocations {false};
+static thread_local size_t t_numAllocations {0};
+
+void *operator new(size_t size) {
+    if (t_countAllocations) {
+        ++t_numAllocations;
+    }
+    void *ptr = std::malloc(size);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t size) noexcept {
+    std::free(ptr);
+}
+
+/**
+ * Counts allocations made on the calling thread during its lifetime.
+ */
+class AllocationCounter : boost::noncopyable {
+public:
+    AllocationCounter() {
+        t_numAllocations = 0;
+        t_countAllocations = true;
+    }
+
+    ~AllocationCounter() {
+        t_countAllocations = false;
+    }
+
+    size_t numAllocations() const { return t_numAllocations; }
+};
+
+// END Allocation counting
+
+class BenchmarkRoutines : public IRoutines {
+public:
+    BenchmarkRoutines() {
+        auto returnTrue = [](auto &args, auto &ctx) { return Variable::ofInt(1); };
+        _routines.emplace_back("GetIsObjectValid", VariableType::Int, Variable::ofInt(0), std::vector<VariableType> {VariableType::Object}, returnTrue);
+        _routines.emplace_back("GetLocalBoolean", VariableType::Int, Variable::ofInt(0), std::vector<VariableType> {VariableType::Object, VariableType::Int}, returnTrue);
+    }
+
+    Routine &get(int index) override { return _routines[index]; }
+
+    int getNumRoutines() const override { return static_cast<int>(_routines.size()); }
+    int getIndexByName(const std::string &name) const override { return -1; }
+
+private:
+    std::vector<Routine> _routines;
+};
+
+class BenchmarkScripts : public IScripts {
+public:
+    BenchmarkScripts(std::shared_ptr<ScriptProgram> program) :
+        _program(std::move(program)) {
+    }
+
+    void clear() override {}
+    void enableVerification(IRoutines &routines) override {}
+
+    std::shared_ptr<ScriptProgram> get(const std::string &key) override { return _program; }
+
+private:
+    std::shared_ptr<ScriptProgram> _program;
+};
+
+/**
+ * Mirrors a typical heartbeat script: validate OBJECT_SELF, then query a
+ * local boolean on it.
+ */
+static std::shared_ptr<ScriptProgram> makeHeartbeatProgram(IRoutines &routines) {
+    auto program = std::make_shared<ScriptProgram>("k_def_heartbt01");
+    program->add(Instruction::newCONSTO(kObjectSelf)); // 13
+    program->add(Instruction::newACTION(0, 1));        // 19
+    program->add(Instruction::newJZ(29));              // 24
+    program->add(Instruction::newCONSTI(10));          // 30
+    program->add(Instruction::newCONSTO(kObjectSelf)); // 36
+    program->add(Instruction::newACTION(1, 2));        // 42
+    program->add(Instruction::newMOVSP(-4));           // 47
+    program->add(Instruction::newCONSTI(0));           // 53
+    program->add(Instruction(InstructionType::RETN));  // 59
+    ScriptVerifier(routines).verify(*program);
+    program->setVerified(true);
+    return program;
+}
+
+static void BM_ScriptRunner_heartbeats(benchmark::State &state) {
+    auto routines = BenchmarkRoutines();
+    auto scripts = BenchmarkScripts(makeHeartbeatProgram(routines));
+    auto runner = ScriptRunner(routines, scripts);
+
+    size_t numAllocations = 0;
+    for (auto _ : state) {
+        auto counter = AllocationCounter();
+        for (int i = 0; i < kNumInvocations; ++i) {
+            benchmark::DoNotOptimize(runner.run("k_def_heartbt01", i + 1));
+        }
+        numAllocations += counter.numAllocations();
+    }
+    int64_t numCalls = state.iterations() * kNumInvocations;
+    state.SetItemsProcessed(numCalls);
+    state.counters["allocs_per_call"] = static_cast<double>(numAllocations) / numCalls;
+}
+
+static void BM_ScriptRunner_heartbeatsUnpooled(benchmark::State &state) {
+    auto routines = BenchmarkRoutines();
+    auto program = makeHeartbeatProgram(routines);
+
+    size_t numAllocations = 0;
+    for (auto _ : state) {
+        auto counter = AllocationCounter();
+        for (int i = 0; i < kNumInvocations; ++i) {
+            auto ctx = std::make_unique<ExecutionContext>();
+            ctx->routines = &routines;
+            ctx->callerId = i + 1;
+            benchmark::DoNotOptimize(VirtualMachine(program, std::move(ctx)).run());
+        }
+        numAllocations += counter.numAllocations();
+    }
+    int64_t numCalls = state.iterations() * kNumInvocations;
+    state.SetItemsProcessed(numCalls);
+    state.counters["allocs_per_call"] = static_cast<double>(numAllocations) / numCalls;
+}
+
+BENCHMARK(BM_ScriptRunner_heartbeats);
+BENCHMARK(BM_ScriptRunner_heartbeatsUnpooled);
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "reone/graphics/keyframetrack.h"
+
+using namespace reone;
+using namespace reone::graphics;
+
+static constexpr float kFrameRate = 30.0f;
+static constexpr float kSampleStep = 1.0f / 60.0f;
+
+// Tracks are laid out the way MdlMdxReader fills them: keys sampled at the
+// frame rate, positions in model units, orientations unit length.
+
+static KeyframeTrack<glm::vec3> makePositionTrack(int numKeyframes, std::mt19937 &random) {
+    std::uniform_real_distribution<float> offset(-0.1f, 0.1f);
+    KeyframeTrack<glm::vec3> track;
+    for (int i = 0; i < numKeyframes; ++i) {
+        track.add(i / kFrameRate, glm::vec3(offset(random), offset(random), offset(random)));
+    }
+    track.update();
+    return track;
+}
+
+static KeyframeTrack<glm::quat> makeOrientationTrack(int numKeyframes, std::mt19937 &random) {
+    std::uniform_real_distribution<float> angle(-glm::half_pi<float>(), glm::half_pi<float>());
+    KeyframeTrack<glm::quat> track;
+    for (int i = 0; i < numKeyframes; ++i) {
+        track.add(i / kFrameRate, glm::quat(glm::vec3(angle(random), angle(random), angle(random))));
+    }
+    track.update();
+    return track;
+}
+
+/**
+ * Baseline: keyframe track as it was before keyframe cursors, searching
+ * keyframes by linear scan from the first one.
+ */
+template <class Value>
+class LinearScanTrack {
+public:
+    LinearScanTrack(const KeyframeTrack<Value> &track) {
+        for (size_t i = 0; i < track.size(); ++i) {
+            _keyframes.push_back(Keyframe {track.times()[i], track.values()[i]});
+        }
+    }
+
+    bool valueAtTime(float time, Value &value) const {
+        if (_keyframes.empty()) {
+            return false;
+        }
+        if (_keyframes.size() == 1ll || _keyframes[0].time >= time) {
+            value = _keyframes[0].value;
+            return true;
+        }
+        int rightKfIdx;
+        for (int i = 1; i < _keyframes.size(); ++i) {
+            rightKfIdx = i;
+            if (_keyframes[i].time >= time) {
+                break;
+            }
+        }
+        int leftKfIdx = rightKfIdx - 1;
+        const auto &leftKeyframe = _keyframes[leftKfIdx];
+        const auto &rightKeyframe = _keyframes[rightKfIdx];
+        if (leftKeyframe.time == rightKeyframe.time) {
+            value = leftKeyframe.value;
+        } else {
+            float factor = (time - leftKeyframe.time) / (rightKeyframe.time - leftKeyframe.time);
+            value = glm::mix(leftKeyframe.value, rightKeyframe.value, factor);
+        }
+        return true;
+    }
+
+private:
+    struct Keyframe {
+        float time {0.0f};
+        Value value {Value()};
+    };
+
+    std::vector<Keyframe> _keyframes;
+};
+
+template <class Value, class Sample>
+static void sampleTrack(benchmark::State &state, const KeyframeTrack<Value> &track, const Sample &sample) {
+    float length = track.times().back();
+    float time = 0.0f;
+    Value value;
+    for (auto _ : state) {
+        sample(time, value);
+        benchmark::DoNotOptimize(value);
+        time += kSampleStep;
+        if (time > length) {
+            time = 0.0f;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <class Value>
+static void sampleTrackByLinearScan(benchmark::State &state, const KeyframeTrack<Value> &track) {
+    auto baseline = LinearScanTrack<Value>(track);
+    sampleTrack(state, track, [&baseline](float time, Value &value) {
+        baseline.valueAtTime(time, value);
+    });
+}
+
+template <class Value>
+static void sampleTrackByBinarySearch(benchmark::State &state, const KeyframeTrack<Value> &track) {
+    sampleTrack(state, track, [&track](float time, Value &value) {
+        track.valueAtTime(time, value);
+    });
+}
+
+template <class Value>
+static void sampleTrackWithCursor(benchmark::State &state, const KeyframeTrack<Value> &track) {
+    KeyframeCursor cursor;
+    sampleTrack(state, track, [&track, &cursor](float time, Value &value) {
+        track.valueAtTime(time, value, cursor);
+    });
+}
+
+static void BM_KeyframeTrack_samplePositionLinearScan(benchmark::State &state) {
+    std::mt19937 random(42);
+    auto track = makePositionTrack(static_cast<int>(state.range(0)), random);
+    sampleTrackByLinearScan(state, track);
+}
+
+static void BM_KeyframeTrack_samplePosition(benchmark::State &state) {
+    std::mt19937 random(42);
+    auto track = makePositionTrack(static_cast<int>(state.range(0)), random);
+    sampleTrackByBinarySearch(state, track);
+}
+
+static void BM_KeyframeTrack_samplePositionWithCursor(benchmark::State &state) {
+    std::mt19937 random(42);
+    auto track = makePositionTrack(static_cast<int>(state.range(0)), random);
+    sampleTrackWithCursor(state, track);
+}
+
+static void BM_KeyframeTrack_sampleOrientationLinearScan(benchmark::State &state) {
+    std::mt19937 random(42);
+    auto track = makeOrientationTrack(static_cast<int>(state.range(0)), random);
+    sampleTrackByLinearScan(state, track);
+}
+
+static void BM_KeyframeTrack_sampleOrientation(benchmark::State &state) {
+    std::mt19937 random(42);
+    auto track = makeOrientationTrack(static_cast<int>(state.range(0)), random);
+    sampleTrackByBinarySearch(state, track);
+}
+
+static void BM_KeyframeTrack_sampleOrientationWithCursor(benchmark::State &state) {
+    std::mt19937 random(42);
+    auto track = makeOrientationTrack(static_cast<int>(state.range(0)), random);
+    sampleTrackWithCursor(state, track);
+}
+
+BENCHMARK(BM_KeyframeTrack_samplePositionLinearScan)->Arg(30)->Arg(300);
+BENCHMARK(BM_KeyframeTrack_samplePosition)->Arg(30)->Arg(300);
+BENCHMARK(BM_KeyframeTrack_samplePositionWithCursor)->Arg(30)->Arg(300);
+BENCHMARK(BM_KeyframeTrack_sampleOrientationLinearScan)->Arg(30)->Arg(300);
+BENCHMARK(BM_KeyframeTrack_sampleOrientation)->Arg(30)->Arg(300);
+BENCHMARK(BM_KeyframeTrack_sampleOrientationWithCursor)->Arg(30)->Arg(300);
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "reone/graphics/walkmesh.h"
+
+using namespace reone;
+using namespace reone::graphics;
+
+static std::unique_ptr<Walkmesh> makeTerrainWalkmesh(int size, std::mt19937 &random) {
+    std::uniform_real_distribution<float> height(0.0f, 1.0f);
+
+    auto walkmesh = std::make_unique<Walkmesh>();
+    std::vector<std::shared_ptr<Walkmesh::AABB>> nodes;
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            glm::vec3 v00(x, y, height(random));
+            glm::vec3 v10(x + 1.0f, y, height(random));
+            glm::vec3 v01(x, y + 1.0f, height(random));
+            glm::vec3 v11(x + 1.0f, y + 1.0f, height(random));
+            for (auto &vertices : {std::array<glm::vec3, 3> {v00, v10, v11}, std::array<glm::vec3, 3> {v00, v11, v01}}) {
+                Walkmesh::Face face;
+                face.index = static_cast<int>(nodes.size());
+                face.material = face.index % 4;
+                face.vertices = vertices;
+                face.normal = glm::vec3(0.0f, 0.0f, 1.0f);
+                auto leaf = std::make_shared<Walkmesh::AABB>();
+                leaf->faceIdx = face.index;
+                nodes.push_back(std::move(leaf));
+                walkmesh->add(std::move(face));
+            }
+        }
+    }
+    // Pair neighbouring nodes bottom-up, like a tree built by median splits
+    while (nodes.size() > 1) {
+        std::vector<std::shared_ptr<Walkmesh::AABB>> parents;
+        for (size_t i = 0; i + 1 < nodes.size(); i += 2) {
+            auto parent = std::make_shared<Walkmesh::AABB>();
+            parent->left = nodes[i];
+            parent->right = nodes[i + 1];
+            parents.push_back(std::move(parent));
+        }
+        if (nodes.size() % 2 == 1) {
+            parents.push_back(nodes.back());
+        }
+        nodes = std::move(parents);
+    }
+    walkmesh->setRootAABB(nodes.front());
+    return walkmesh;
+}
+
+static void BM_Walkmesh_raycastElevation(benchmark::State &state) {
+    int size = static_cast<int>(state.range(0));
+    std::mt19937 random(42);
+    auto walkmesh = makeTerrainWalkmesh(size, random);
+    auto surfaces = Walkmesh::getSurfaceMask({0, 1, 2});
+
+    std::uniform_real_distribution<float> coord(0.0f, static_cast<float>(size));
+    std::vector<glm::vec3> origins;
+    for (int i = 0; i < 256; ++i) {
+        origins.push_back(glm::vec3(coord(random), coord(random), 2.0f));
+    }
+
+    size_t i = 0;
+    float distance = 0.0f;
+    for (auto _ : state) {
+        auto &origin = origins[i++ % origins.size()];
+        benchmark::DoNotOptimize(walkmesh->raycast(surfaces, origin, glm::vec3(0.0f, 0.0f, -1.0f), 4.0f, distance));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_Walkmesh_raycastWalk(benchmark::State &state) {
+    int size = static_cast<int>(state.range(0));
+    std::mt19937 random(42);
+    auto walkmesh = makeTerrainWalkmesh(size, random);
+    auto surfaces = Walkmesh::getSurfaceMask({0, 1, 2});
+
+    std::uniform_real_distribution<float> coord(0.0f, static_cast<float>(size));
+    std::uniform_real_distribution<float> angle(0.0f, glm::two_pi<float>());
+    std::vector<std::pair<glm::vec3, glm::vec3>> rays;
+    for (int i = 0; i < 256; ++i) {
+        float a = angle(random);
+        rays.push_back(std::make_pair(glm::vec3(coord(random), coord(random), 1.0f), glm::vec3(glm::cos(a), glm::sin(a), -0.1f)));
+    }
+
+    size_t i = 0;
+    float distance = 0.0f;
+    for (auto _ : state) {
+        auto &ray = rays[i++ % rays.size()];
+        benchmark::DoNotOptimize(walkmesh->raycast(surfaces, ray.first, ray.second, 8.0f, distance));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_Walkmesh_raycastElevation)->Arg(16)->Arg(64);
+BENCHMARK(BM_Walkmesh_raycastWalk)->Arg(16)->Arg(64);
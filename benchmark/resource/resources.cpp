@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "reone/resource/container/memory.h"
+#include "reone/resource/resources.h"
+
+using namespace reone;
+using namespace reone::resource;
+
+static constexpr int kNumResourcesPerContainer = 2000;
+
+static void initResources(Resources &resources, int numContainers, std::vector<ResourceId> &ids) {
+    for (int i = 0; i < numContainers; ++i) {
+        auto container = std::make_unique<MemoryResourceContainer>();
+        for (int j = 0; j < kNumResourcesPerContainer; ++j) {
+            auto id = ResourceId(str(boost::format("res_%d_%d") % i % j), ResType::Gff);
+            container->add(id, ByteBuffer {'x'});
+            ids.push_back(std::move(id));
+        }
+        resources.add(std::move(container), i % 2 == 1);
+    }
+}
+
+static void BM_Resources_findIndexed(benchmark::State &state) {
+    auto resources = Resources();
+    auto ids = std::vector<ResourceId>();
+    initResources(resources, static_cast<int>(state.range(0)), ids);
+
+    size_t idx = 0;
+    for (auto _ : state) {
+        auto res = resources.find(ids[idx]);
+        benchmark::DoNotOptimize(res);
+        idx = (idx + 1) % ids.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_Resources_findListWalk(benchmark::State &state) {
+    auto resources = Resources();
+    auto ids = std::vector<ResourceId>();
+    initResources(resources, static_cast<int>(state.range(0)), ids);
+
+    size_t idx = 0;
+    for (auto _ : state) {
+        std::optional<Resource> res;
+        for (auto &[provider, local] : resources.containers()) {
+            auto data = provider->findResourceData(ids[idx]);
+            if (data) {
+                res = Resource {std::move(*data), local};
+                break;
+            }
+        }
+        benchmark::DoNotOptimize(res);
+        idx = (idx + 1) % ids.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_Resources_findIndexed)->Arg(1)->Arg(4)->Arg(16);
+BENCHMARK(BM_Resources_findListWalk)->Arg(1)->Arg(4)->Arg(16);
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "reone/graphics/modelnode.h"
+#include "reone/scene/node/dummy.h"
+
+#include "../../test/fixtures/audio.h"
+#include "../../test/fixtures/graphics.h"
+#include "../../test/fixtures/resource.h"
+#include "../../test/fixtures/scene.h"
+
+using namespace reone;
+using namespace reone::audio;
+using namespace reone::graphics;
+using namespace reone::resource;
+using namespace reone::scene;
+
+/**
+ * Chain of dummy scene nodes, like a creature skeleton going from the root
+ * through the spine down to the fingers.
+ */
+struct NodeHierarchy {
+    TestGraphicsModule graphicsModule;
+    TestAudioModule audioModule;
+    TestResourceModule resourceModule;
+    MockSceneGraph sceneGraph;
+    std::unique_ptr<ModelNode> modelNode;
+    std::vector<std::unique_ptr<DummySceneNode>> nodes;
+
+    NodeHierarchy(int depth) {
+        graphicsModule.init();
+        audioModule.init();
+        resourceModule.init();
+        modelNode = std::make_unique<ModelNode>(0, "node", glm::vec3(0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), false, nullptr);
+        for (int i = 0; i < depth; ++i) {
+            auto node = std::make_unique<DummySceneNode>(*modelNode, sceneGraph, graphicsModule.services(), audioModule.services(), resourceModule.services());
+            if (!nodes.empty()) {
+                nodes.back()->addChild(*node);
+            }
+            nodes.push_back(std::move(node));
+        }
+    }
+};
+
+static void BM_SceneNode_animateHierarchy(benchmark::State &state) {
+    // Every node is transformed top-down, as when applying animation states,
+    // then every absolute transform is read, as when rendering
+    NodeHierarchy hierarchy(static_cast<int>(state.range(0)));
+    float angle = 0.0f;
+    for (auto _ : state) {
+        angle += 0.01f;
+        for (auto &node : hierarchy.nodes) {
+            node->setLocalTransform(glm::translate(glm::vec3(0.0f, 0.1f, 0.0f)) * glm::mat4_cast(glm::angleAxis(angle, glm::vec3(0.0f, 0.0f, 1.0f))));
+        }
+        for (auto &node : hierarchy.nodes) {
+            benchmark::DoNotOptimize(node->absoluteTransform());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * hierarchy.nodes.size());
+}
+
+static void BM_SceneNode_moveRoot(benchmark::State &state) {
+    // Root is moved several times per frame, as when an object is moved,
+    // then only the deepest node is queried, as when testing collision
+    NodeHierarchy hierarchy(static_cast<int>(state.range(0)));
+    float offset = 0.0f;
+    for (auto _ : state) {
+        for (int i = 0; i < 4; ++i) {
+            offset += 0.01f;
+            hierarchy.nodes.front()->setLocalTransform(glm::translate(glm::vec3(offset, 0.0f, 0.0f)));
+        }
+        benchmark::DoNotOptimize(hierarchy.nodes.back()->absoluteTransformInverse());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_SceneNode_animateHierarchy)->Arg(16)->Arg(64);
+BENCHMARK(BM_SceneNode_moveRoot)->Arg(16)->Arg(64);
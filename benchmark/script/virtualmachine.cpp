@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "reone/script/executioncontext.h"
+#include "reone/script/instrutil.h"
+#include "reone/script/program.h"
+#include "reone/script/virtualmachine.h"
+
+using namespace reone;
+using namespace reone::script;
+
+/**
+ * Builds a counting loop around body, mirroring the for-loop shape emitted
+ * by the NWScript compiler: counter on the stack, LTII/JZ guard, INCISP and
+ * a backward JMP.
+ */
+static std::shared_ptr<ScriptProgram> makeLoopProgram(int numIterations, const std::vector<Instruction> &body) {
+    static constexpr int kGuardSize = 8 + 6 + 2; // CPTOPSP, CONSTI, LTII
+    static constexpr int kJumpSize = 6;          // JZ, JMP, INCISP
+
+    int bodySize = 0;
+    for (auto &ins : body) {
+        bodySize += getInstructionSize(ins);
+    }
+
+    auto program = std::make_shared<ScriptProgram>("benchmark");
+    program->add(Instruction::newCONSTI(0));
+    program->add(Instruction::newCPTOPSP(-4, 4));
+    program->add(Instruction::newCONSTI(numIterations));
+    program->add(Instruction(InstructionType::LTII));
+    program->add(Instruction::newJZ(kJumpSize + bodySize + 2 * kJumpSize));
+    for (auto &ins : body) {
+        program->add(ins);
+    }
+    program->add(Instruction::newINCISP(-4));
+    program->add(Instruction::newJMP(-(kGuardSize + kJumpSize + bodySize + kJumpSize)));
+    program->add(Instruction::newMOVSP(-4));
+
+    return program;
+}
+
+static void runProgram(benchmark::State &state, const std::shared_ptr<ScriptProgram> &program) {
+    for (auto _ : state) {
+        auto machine = VirtualMachine(program, std::make_unique<ExecutionContext>());
+        benchmark::DoNotOptimize(machine.run());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_VirtualMachine_arithmeticLoop(benchmark::State &state) {
+    auto program = makeLoopProgram(
+        static_cast<int>(state.range(0)),
+        {Instruction::newCPTOPSP(-4, 4),
+         Instruction::newCONSTI(3),
+         Instruction(InstructionType::MULII),
+         Instruction::newMOVSP(-4)});
+    runProgram(state, program);
+}
+
+static void BM_VirtualMachine_stringLoop(benchmark::State &state) {
+    auto program = makeLoopProgram(
+        static_cast<int>(state.range(0)),
+        {Instruction::newCONSTS("k_trg_"),
+         Instruction::newCONSTS("enter"),
+         Instruction(InstructionType::ADDSS),
+         Instruction::newCONSTS("k_trg_enter"),
+         Instruction(InstructionType::EQUALSS),
+         Instruction::newMOVSP(-4)});
+    runProgram(state, program);
+}
+
+static void BM_VirtualMachine_frameLoop(benchmark::State &state) {
+    auto program = makeLoopProgram(
+        static_cast<int>(state.range(0)),
+        {Instruction(InstructionType::RSADDI),
+         Instruction(InstructionType::RSADDF),
+         Instruction(InstructionType::RSADDS),
+         Instruction(InstructionType::RSADDO),
+         Instruction(InstructionType::RSADDEFF),
+         Instruction::newCPTOPSP(-20, 4),
+         Instruction::newCPDOWNSP(-8, 4),
+         Instruction::newMOVSP(-24)});
+    runProgram(state, program);
+}
+
+BENCHMARK(BM_VirtualMachine_arithmeticLoop)->Arg(1000);
+BENCHMARK(BM_VirtualMachine_stringLoop)->Arg(1000);
+BENCHMARK(BM_VirtualMachine_frameLoop)->Arg(1000);
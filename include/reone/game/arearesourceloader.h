@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "reone/resource/parser/gff/are.h"
+#include "reone/resource/parser/gff/git.h"
+#include "reone/system/loadpipeline.h"
+
+namespace reone {
+
+namespace graphics {
+
+class Model;
+
+}
+
+namespace resource {
+
+struct ResourceServices;
+
+}
+
+namespace game {
+
+/**
+ * Loads resources of an area into resource caches in stages: blueprints of
+ * GIT objects, then models and walkmeshes of LYT rooms, then textures of
+ * room models.
+ */
+class AreaResourceLoader : boost::noncopyable {
+public:
+    AreaResourceLoader(resource::ResourceServices &resourceSvc, IThreadPool &threadPool) :
+        _resourceSvc(resourceSvc),
+        _threadPool(threadPool) {
+    }
+
+    void load(
+        const std::string &areaName,
+        const resource::generated::ARE &are,
+        const resource::generated::GIT &git,
+        LoadPipeline::ProgressCallback progress = nullptr);
+
+    const std::vector<LoadPipeline::StageTimings> &timings() const { return _timings; }
+
+private:
+    resource::ResourceServices &_resourceSvc;
+    IThreadPool &_threadPool;
+
+    std::vector<LoadPipeline::StageTimings> _timings;
+
+    void resolveBlueprints(const resource::generated::GIT &git, LoadPipeline::Stage &stage);
+    void resolveRooms(const std::string &areaName, std::vector<std::shared_ptr<graphics::Model>> &roomModels, LoadPipeline::Stage &stage);
+    void resolveTextures(const resource::generated::ARE &are, const std::vector<std::shared_ptr<graphics::Model>> &roomModels, LoadPipeline::Stage &stage);
+};
+
+} // namespace game
+
+} // namespace reone
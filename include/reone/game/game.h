@@ -58,6 +58,7 @@
 #include "object/store.h"
 #include "object/trigger.h"
 #include "object/waypoint.h"
+#include "objectregistry.h"
 #include "options.h"
 #include "party.h"
 #include "script/runner.h"
@@ -184,6 +185,13 @@ public:
 
     void scheduleModuleTransition(const std::string &moduleName, const std::string &entry);
 
+    /**
+     * Advances the loading screen progress bar while a module is loading.
+     *
+     * @param progress fraction of the area resources loaded, in [0, 1]
+     */
+    void reportModuleLoadProgress(float progress);
+
     // END Module loading
 
     // Objects
@@ -255,14 +263,22 @@ public:
 
     template <class T>
     inline std::shared_ptr<T> getObjectById(uint32_t id) const {
-        return std::dynamic_pointer_cast<T>(getObjectById(id));
+        if constexpr (ObjectTypeOf<T>::value != ObjectType::Invalid) {
+            if (id == script::kObjectSelf) {
+                throw std::invalid_argument("Invalid id: " + std::to_string(id));
+            }
+            return std::static_pointer_cast<T>(_objects.get(id, ObjectTypeOf<T>::value));
+        } else {
+            return std::dynamic_pointer_cast<T>(getObjectById(id));
+        }
     }
 
     template <class T, class... Args>
     inline std::shared_ptr<T> newObject(Args &&...args) {
-        auto object = std::make_shared<T>(_nextObjectId++, std::forward<Args>(args)...);
-        auto [inserted, _] = _objectById.insert(std::make_pair(object->id(), std::move(object)));
-        return std::static_pointer_cast<T>(inserted->second);
+        uint32_t id = _objects.allocate();
+        auto object = std::make_shared<T>(id, std::forward<Args>(args)...);
+        _objects.set(id, object);
+        return object;
     }
 
     template <class T, class... Args>
@@ -330,8 +346,7 @@ private:
     bool _quitRequested {false};
     bool _relativeMouseMode {false};
 
-    uint32_t _nextObjectId {2}; // ids 0 and 1 are reserved
-    std::map<uint32_t, std::shared_ptr<Object>> _objectById;
+    ObjectRegistry<Object> _objects;
 
     // Services
 
@@ -368,6 +383,7 @@ private:
     std::string _nextEntry;
     std::shared_ptr<Module> _module;
     std::map<std::string, std::shared_ptr<Module>> _loadedModules;
+    int _moduleLoadProgress {0};
 
     // END Modules
 
@@ -428,6 +444,7 @@ private:
     void changeScreen(Screen screen);
 
     void withLoadingScreen(const std::string &imageResRef, const std::function<void()> &block);
+    void setLoadingProgress(int progress);
 
     template <class T>
     std::unique_ptr<T> tryLoadGUI() {
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+namespace reone {
+
+class IClock;
+
+namespace game {
+
+const int kHeartbeatScriptBudget = 8;
+
+/**
+ * Spreads heartbeat scripts of area objects over the heartbeat interval. Each
+ * object is assigned a phase within the interval, so that phases are evenly
+ * distributed. Objects whose phase has passed are run in the order they became
+ * due, until a per-frame budget of scripts is exhausted. At least one script is
+ * run per frame when any is due.
+ */
+class HeartbeatScheduler : boost::noncopyable {
+public:
+    struct FrameStats {
+        int numRun {0};
+        int numPending {0};
+        uint64_t scriptTime {0}; /**< microseconds */
+    };
+
+    HeartbeatScheduler(IClock &clock, float interval, int scriptBudget = kHeartbeatScriptBudget) :
+        _clock(clock),
+        _interval(interval),
+        _scriptBudget(scriptBudget) {
+    }
+
+    void add(uint32_t objectId);
+    void remove(uint32_t objectId);
+    void clear();
+
+    /**
+     * Advances time and runs heartbeats that are due, within the script budget.
+     *
+     * @param run function that runs a heartbeat script of an object
+     */
+    void update(float dt, const std::function<void(uint32_t)> &run);
+
+    const FrameStats &frameStats() const { return _frameStats; }
+
+    int scriptBudget() const { return _scriptBudget; }
+
+    void setScriptBudget(int budget) { _scriptBudget = budget; }
+
+private:
+    struct Entry {
+        uint32_t objectId {0};
+        float phase {0.0f};
+    };
+
+    IClock &_clock;
+    float _interval;
+    int _scriptBudget;
+
+    std::vector<Entry> _entries; /**< sorted by phase */
+    std::deque<uint32_t> _dueIds;
+    std::unordered_set<uint32_t> _dueIdSet;
+    float _time {0.0f};
+    size_t _next {0};
+    uint32_t _numAdded {0};
+    FrameStats _frameStats;
+
+    void enqueueDue(float until);
+};
+
+} // namespace game
+
+} // namespace reone
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+namespace reone {
+
+namespace game {
+
+const float kLineOfSightCacheEpsilon = 0.25f;
+
+/**
+ * Caches line of sight test results between pairs of objects. Cached result
+ * stays valid until either object moves farther than epsilon from the position
+ * it was tested at, or the cache is invalidated as a whole, e.g. when a door
+ * or a placeable walkmesh changes.
+ */
+class LineOfSightCache : boost::noncopyable {
+public:
+    LineOfSightCache(float epsilon = kLineOfSightCacheEpsilon) :
+        _epsilon2(epsilon * epsilon) {
+    }
+
+    /**
+     * @return true if there is a valid cached result, false otherwise
+     */
+    bool get(uint32_t observerId, const glm::vec3 &observerPosition, uint32_t targetId, const glm::vec3 &targetPosition, bool &outVisible) const;
+
+    void put(uint32_t observerId, const glm::vec3 &observerPosition, uint32_t targetId, const glm::vec3 &targetPosition, bool visible);
+
+    void invalidate();
+
+    /**
+     * Removes results involving the specified object.
+     */
+    void remove(uint32_t objectId);
+
+    int size() const { return static_cast<int>(_entries.size()); }
+
+private:
+    struct Entry {
+        glm::vec3 observerPosition {0.0f};
+        glm::vec3 targetPosition {0.0f};
+        bool visible {false};
+    };
+
+    float _epsilon2;
+
+    std::unordered_map<uint64_t, Entry> _entries;
+
+    static uint64_t getKey(uint32_t observerId, uint32_t targetId) {
+        return (static_cast<uint64_t>(observerId) << 32) | targetId;
+    }
+};
+
+} // namespace game
+
+} // namespace reone
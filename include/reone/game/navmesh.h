@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "reone/graphics/walkmesh.h"
+
+#include "spatialgrid.h"
+
+namespace reone {
+
+namespace game {
+
+/**
+ * Navigation mesh built from walkable faces of area walkmeshes. Paths are
+ * found by A* over adjacent faces, then straightened by pulling a string
+ * through the portals between them (funnel algorithm).
+ */
+class NavMesh : boost::noncopyable {
+public:
+    /**
+     * Adds faces of the walkmesh having one of walkable surface materials.
+     * Walkmesh vertices must be in world space.
+     */
+    void add(const graphics::Walkmesh &walkmesh, const std::set<uint32_t> &walkableSurfaces);
+
+    /**
+     * Links faces sharing edges. Must be called after adding all walkmeshes.
+     */
+    void build();
+
+    /**
+     * Finds a path between two points on this navigation mesh. Safe to call
+     * from multiple threads.
+     *
+     * @return true if path was found, false if either point is off mesh or points are not connected
+     */
+    bool findPath(const glm::vec3 &from, const glm::vec3 &to, std::vector<glm::vec3> &outPoints) const;
+
+    /**
+     * @return index of a face containing point on XY plane and nearest to it by Z, or -1 if none
+     */
+    int findFace(const glm::vec3 &point) const;
+
+    int numFaces() const { return static_cast<int>(_faces.size()); }
+    int numVertices() const { return static_cast<int>(_vertices.size()); }
+
+private:
+    struct Face {
+        std::array<uint32_t, 3> vertices {0, 0, 0};        /**< counter-clockwise on XY plane */
+        std::array<int, 3> neighbours {-1, -1, -1};        /**< neighbour across edge (i, i + 1) */
+        glm::vec3 centroid {0.0f};
+    };
+
+    struct Portal {
+        glm::vec3 left {0.0f};
+        glm::vec3 right {0.0f};
+    };
+
+    /**
+     * Per-thread search state, reused between searches.
+     */
+    struct Context {
+        std::vector<float> distances;
+        std::vector<int> parents;
+        std::vector<uint32_t> stamps;
+        uint32_t stamp {0};
+        std::vector<std::pair<float, int>> open;
+        std::vector<int> corridor;
+        std::vector<Portal> portals;
+
+        void reset(size_t numFaces);
+    };
+
+    static thread_local Context _context;
+
+    std::vector<glm::vec3> _vertices;
+    std::vector<Face> _faces;
+    std::unordered_map<uint64_t, uint32_t> _vertexByKey;
+    SpatialGrid<int> _faceGrid;
+
+    uint32_t addVertex(const glm::vec3 &vertex);
+
+    bool findCorridor(int fromFace, int toFace, const glm::vec3 &to, Context &ctx) const;
+    void getPortal(int face, int nextFace, Portal &outPortal) const;
+    void pullString(const glm::vec3 &from, const glm::vec3 &to, const std::vector<Portal> &portals, std::vector<glm::vec3> &outPoints) const;
+};
+
+} // namespace game
+
+} // namespace reone
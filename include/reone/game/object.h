@@ -26,6 +26,7 @@
 #include "action.h"
 #include "action/playanimation.h"
 #include "effect.h"
+#include "spatialgrid.h"
 #include "types.h"
 
 namespace reone {
@@ -37,8 +38,12 @@ struct ServicesView;
 class Action;
 class Game;
 class Item;
+class Object;
+class ObjectUpdateList;
 class Room;
 
+using ObjectGrid = SpatialGrid<std::shared_ptr<Object>>;
+
 class Object : public scene::IUser, boost::noncopyable {
 public:
     virtual ~Object() = default;
@@ -53,6 +58,20 @@ public:
     bool contains(const glm::vec3 &point) const;
 
     virtual bool isSelectable() const;
+
+    /**
+     * Must be called whenever state that isSelectable depends on changes.
+     */
+    void invalidateSelectable() {
+        _selectableDirty = true;
+        wake();
+    }
+
+    /**
+     * @return true if base update would do nothing, i.e. there are no pending actions, no temporary effects and selectability is up to date
+     */
+    bool isIdle() const;
+
     bool isOpen() const { return _open; }
     bool isInLineOfSight(const Object &other, float fov) const;
 
@@ -89,6 +108,8 @@ public:
     void setCommandable(bool commandable) { _commandable = commandable; }
 
     void setRoom(Room *room);
+    void setGrid(ObjectGrid *grid) { _grid = grid; }
+    void setUpdateList(ObjectUpdateList *list);
     void setPosition(const glm::vec3 &position);
     void setFacing(float facing);
     void setVisible(bool visible);
@@ -102,6 +123,22 @@ public:
 
     // END Animation
 
+    // Update list
+
+    /**
+     * Appends this object to its update list, unless already there.
+     */
+    void wake();
+
+    /**
+     * Marks this object as removed from its update list, if it is idle.
+     *
+     * @return true if object was put to sleep, false otherwise
+     */
+    bool sleep();
+
+    // END Update list
+
     // Inventory
 
     std::shared_ptr<Item> addItem(const std::string &resRef, int stackSize = 1, bool dropable = true);
@@ -199,7 +236,7 @@ public:
 protected:
     struct DelayedAction {
         std::shared_ptr<Action> action;
-        std::unique_ptr<Timer> timer;
+        float timeLeft {0.0f};
     };
 
     struct AppliedEffect {
@@ -233,14 +270,21 @@ protected:
     glm::mat4 _transform {1.0f};
     bool _visible {true};
     Room *_room {nullptr};
+    ObjectGrid *_grid {nullptr};
+    ObjectUpdateList *_updateList {nullptr};
+    bool _awake {false};
     std::vector<std::shared_ptr<Item>> _items;
     std::deque<AppliedEffect> _effects;
+    int _numTemporaryEffects {0};
     bool _open {false};
     bool _stunt {false};
     std::string _activeAnimName;
 
     std::shared_ptr<scene::SceneNode> _sceneNode;
 
+    bool _selectableDirty {true};
+    scene::SceneNode *_pickableSceneNode {nullptr}; /**< scene node pickability was last applied to */
+
     int _itemIndex {0};
     int _effectIndex {0};
 
@@ -297,6 +341,8 @@ protected:
     void applyInstantEffect(Effect &effect);
 
     // END Effects
+
+    void updatePickable();
 };
 
 } // namespace game
@@ -32,7 +32,13 @@
 #include "../object/camera/firstperson.h"
 #include "../object/camera/static.h"
 #include "../object/camera/thirdperson.h"
+#include "../heartbeatscheduler.h"
+#include "../lineofsightcache.h"
+#include "../navmesh.h"
+#include "../objectupdatelist.h"
 #include "../pathfinder.h"
+#include "../pathrequests.h"
+#include "../perceptionscheduler.h"
 #include "../types.h"
 
 namespace reone {
@@ -68,6 +74,8 @@ public:
         Game &game,
         ServicesView &services);
 
+    ~Area();
+
     void load(std::string name, const resource::Gff &are, const resource::Gff &git, bool fromSave = false);
 
     bool handle(const input::Event &event);
@@ -95,7 +103,8 @@ public:
     const CameraStyle &camStyleDefault() const { return _camStyleDefault; }
     const std::string &music() const { return _music; }
     const ObjectList &objects() const { return _objects; }
-    const Pathfinder &pathfinder() const { return _pathfinder; }
+    const Pathfinder &pathfinder() const { return *_pathfinder; }
+    PathRequests &pathRequests() { return _pathRequests; }
     const std::string &localizedName() const { return _localizedName; }
     const RoomMap &rooms() const { return _rooms; }
     const Grass &grass() const { return _grass; }
@@ -163,8 +172,24 @@ public:
 
     void updatePerception(float dt);
 
+    /**
+     * Discards cached line of sight test results. Must be called whenever
+     * walkmeshes change, e.g. when a door is opened or closed.
+     */
+    void invalidateLineOfSight();
+
+    void setPerceptionRayBudget(int budget) { _perceptionScheduler.setRayBudget(budget); }
+
     // END Perception
 
+    // Heartbeats
+
+    const HeartbeatScheduler::FrameStats &heartbeatStats() const { return _heartbeatScheduler.frameStats(); }
+
+    void setHeartbeatScriptBudget(int budget) { _heartbeatScheduler.setScriptBudget(budget); }
+
+    // END Heartbeats
+
     // Object Selection
 
     void hilightObject(std::shared_ptr<Object> object);
@@ -210,18 +235,22 @@ public:
 private:
     std::string _sceneName;
 
-    Pathfinder _pathfinder;
+    std::shared_ptr<Pathfinder> _pathfinder;
+    std::shared_ptr<NavMesh> _navMesh;
+    PathRequests _pathRequests;
     std::string _localizedName;
     RoomMap _rooms;
     resource::Visibility _visibility;
     CameraStyle _camStyleDefault;
     CameraStyle _camStyleCombat;
     std::string _music;
-    Timer _heartbeatTimer;
+    HeartbeatScheduler _heartbeatScheduler;
     bool _unescapable {false};
     Grass _grass;
     glm::vec3 _ambientColor {0.0f};
     Timer _perceptionTimer;
+    PerceptionScheduler _perceptionScheduler;
+    LineOfSightCache _lineOfSightCache;
     std::shared_ptr<Object> _hilightedObject;
     std::shared_ptr<Object> _selectedObject;
 
@@ -247,10 +276,14 @@ private:
     // Objects
 
     ObjectList _objects;
+    ObjectUpdateList _updateList; /**< objects to update, idle ones excluded */
     std::unordered_map<ObjectType, ObjectList> _objectsByType;
     std::unordered_map<std::string, ObjectList> _objectsByTag;
     std::set<uint32_t> _objectsToDestroy;
 
+    ObjectGrid _objectGrid;
+    ObjectGrid _triggerGrid;
+
     // END Objects
 
     // Stealth
@@ -276,14 +309,21 @@ private:
     void loadLYT();
     void loadVIS();
     void loadPTH();
+    void loadNavMesh();
+
+    void loadResources(const resource::generated::ARE &are, const resource::generated::GIT &git);
 
     void add(const std::shared_ptr<Object> &object);
     void doDestroyObject(uint32_t objectId);
     void doDestroyObjects();
     void updateVisibility();
     void updateHeartbeat(float dt);
+    void applySolvedPaths();
+
+    void schedulePerception();
+    int updateCreaturePerception(uint32_t creatureId);
+    bool testLineOfSight(const Object &subject, const Object &object) const;
 
-    void doUpdatePerception();
     void updateObjectSelection();
 
     bool matchesCriterias(const Creature &creature, const SearchCriteriaList &criterias, std::shared_ptr<Object> target = nullptr) const;
@@ -28,6 +28,8 @@ namespace reone {
 
 namespace game {
 
+class LineOfSightCache;
+
 class Door : public Object {
 public:
     Door(
@@ -65,6 +67,11 @@ public:
 
     void setLocked(bool locked);
 
+    /**
+     * Sets a line of sight cache to invalidate when this door opens or closes.
+     */
+    void setLineOfSightCache(LineOfSightCache *cache) { _lineOfSightCache = cache; }
+
     // Walkmeshes
 
     std::shared_ptr<scene::WalkmeshSceneNode> walkmeshOpen1() const { return _walkmeshOpen1; }
@@ -88,6 +95,7 @@ private:
     int _fortitude {0};
     bool _lockable {false};
     std::string _keyName;
+    LineOfSightCache *_lineOfSightCache {nullptr};
 
     // Walkmeshes
 
@@ -115,6 +123,8 @@ private:
     void loadTransformFromGIT(const resource::generated::GIT_Door_List &git);
 
     void updateTransform() override;
+
+    void invalidateLineOfSight();
 };
 
 } // namespace game
@@ -52,12 +52,22 @@ public:
     bool isIn(const glm::vec2 &point) const;
     bool isTenant(const std::shared_ptr<Object> &object) const;
 
+    /**
+     * @return radius of a circle around trigger position, that encloses its geometry on XY plane
+     */
+    float getBoundingRadius() const;
+
     const std::string &getOnEnter() const { return _onEnter; }
     const std::string &getOnExit() const { return _onExit; }
 
     const std::string &linkedToModule() const { return _linkedToModule; }
     const std::string &linkedTo() const { return _linkedTo; }
 
+    /**
+     * Sets a grid of trigger extents to keep in sync with trigger position.
+     */
+    void setTriggerGrid(ObjectGrid *grid) { _triggerGrid = grid; }
+
 private:
     std::string _transitionDestin;
     std::string _linkedToModule;
@@ -75,6 +85,7 @@ private:
     std::vector<glm::vec3> _geometry;
     std::set<std::shared_ptr<Object>> _tenants;
     std::string _keyName;
+    ObjectGrid *_triggerGrid {nullptr};
 
     // Scripts
 
@@ -89,6 +100,8 @@ private:
     void loadGeometryFromGIT(const resource::generated::GIT_TriggerList &git);
 
     void loadUTT(const resource::generated::UTT &utt);
+
+    void updateTransform() override;
 };
 
 } // namespace game
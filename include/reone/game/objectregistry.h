@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "types.h"
+
+namespace reone {
+
+namespace game {
+
+class Area;
+class Creature;
+class Door;
+class Encounter;
+class Item;
+class Module;
+class Placeable;
+class Sound;
+class Store;
+class Trigger;
+class Waypoint;
+
+/**
+ * Maps an object class to its ObjectType, for classes that are the only ones
+ * of their type. Other classes map to ObjectType::Invalid.
+ */
+template <class T>
+struct ObjectTypeOf {
+    static constexpr ObjectType value = ObjectType::Invalid;
+};
+
+template <>
+struct ObjectTypeOf<Area> {
+    static constexpr ObjectType value = ObjectType::Area;
+};
+
+template <>
+struct ObjectTypeOf<Creature> {
+    static constexpr ObjectType value = ObjectType::Creature;
+};
+
+template <>
+struct ObjectTypeOf<Door> {
+    static constexpr ObjectType value = ObjectType::Door;
+};
+
+template <>
+struct ObjectTypeOf<Encounter> {
+    static constexpr ObjectType value = ObjectType::Encounter;
+};
+
+template <>
+struct ObjectTypeOf<Item> {
+    static constexpr ObjectType value = ObjectType::Item;
+};
+
+template <>
+struct ObjectTypeOf<Module> {
+    static constexpr ObjectType value = ObjectType::Module;
+};
+
+template <>
+struct ObjectTypeOf<Placeable> {
+    static constexpr ObjectType value = ObjectType::Placeable;
+};
+
+template <>
+struct ObjectTypeOf<Sound> {
+    static constexpr ObjectType value = ObjectType::Sound;
+};
+
+template <>
+struct ObjectTypeOf<Store> {
+    static constexpr ObjectType value = ObjectType::Store;
+};
+
+template <>
+struct ObjectTypeOf<Trigger> {
+    static constexpr ObjectType value = ObjectType::Trigger;
+};
+
+template <>
+struct ObjectTypeOf<Waypoint> {
+    static constexpr ObjectType value = ObjectType::Waypoint;
+};
+
+/**
+ * Generational slot map of objects. Object id is a slot index in the lower 24
+ * bits and a slot generation in the upper 8 bits. Generation is incremented
+ * whenever an object is removed, so that ids of removed objects never resolve
+ * to objects that reuse their slot.
+ *
+ * Slots 0 and 1 are reserved for kObjectSelf and kObjectInvalid. As long as no
+ * object is removed, ids are allocated sequentially, starting from 2.
+ */
+template <class T>
+class ObjectRegistry : boost::noncopyable {
+public:
+    static constexpr int kIndexBits = 24;
+    static constexpr uint32_t kIndexMask = (1 << kIndexBits) - 1;
+    static constexpr uint32_t kMaxGeneration = 0xff;
+    static constexpr uint32_t kNumReservedSlots = 2;
+
+    ObjectRegistry() {
+        clear();
+    }
+
+    void clear() {
+        _objects.assign(kNumReservedSlots, nullptr);
+        _types.assign(kNumReservedSlots, ObjectType::Invalid);
+        _generations.assign(kNumReservedSlots, 0);
+        _freeSlots.clear();
+        _size = 0;
+    }
+
+    /**
+     * @return id of a new empty slot, to be filled by set
+     */
+    uint32_t allocate() {
+        if (!_freeSlots.empty()) {
+            uint32_t index = _freeSlots.front();
+            _freeSlots.pop_front();
+            return makeId(index, _generations[index]);
+        }
+        uint32_t index = static_cast<uint32_t>(_objects.size());
+        if (index > kIndexMask) {
+            throw std::overflow_error("Object registry is full");
+        }
+        _objects.push_back(nullptr);
+        _types.push_back(ObjectType::Invalid);
+        _generations.push_back(0);
+        return makeId(index, 0);
+    }
+
+    void set(uint32_t id, std::shared_ptr<T> object) {
+        uint32_t index = getIndex(id);
+        if (!isAllocated(index, getGeneration(id))) {
+            throw std::invalid_argument("Object id not allocated: " + std::to_string(id));
+        }
+        if (!_objects[index]) {
+            ++_size;
+        }
+        _types[index] = object->type();
+        _objects[index] = std::move(object);
+    }
+
+    void remove(uint32_t id) {
+        uint32_t index = getIndex(id);
+        if (!isAllocated(index, getGeneration(id))) {
+            return;
+        }
+        if (_objects[index]) {
+            --_size;
+        }
+        _objects[index].reset();
+        _types[index] = ObjectType::Invalid;
+        // Slots that ran out of generations are retired
+        if (++_generations[index] <= kMaxGeneration) {
+            _freeSlots.push_back(index);
+        }
+    }
+
+    std::shared_ptr<T> get(uint32_t id) const {
+        uint32_t index = getIndex(id);
+        if (!isAllocated(index, getGeneration(id))) {
+            return nullptr;
+        }
+        return _objects[index];
+    }
+
+    /**
+     * @return object if its type matches, nullptr otherwise
+     */
+    std::shared_ptr<T> get(uint32_t id, ObjectType type) const {
+        uint32_t index = getIndex(id);
+        if (!isAllocated(index, getGeneration(id)) || _types[index] != type) {
+            return nullptr;
+        }
+        return _objects[index];
+    }
+
+    bool contains(uint32_t id) const {
+        return static_cast<bool>(get(id));
+    }
+
+    int size() const { return _size; }
+
+    static uint32_t getIndex(uint32_t id) { return id & kIndexMask; }
+    static uint32_t getGeneration(uint32_t id) { return id >> kIndexBits; }
+
+private:
+    std::vector<std::shared_ptr<T>> _objects;
+    std::vector<ObjectType> _types;
+    std::vector<uint32_t> _generations;
+    std::deque<uint32_t> _freeSlots; /**< reused in FIFO order, to delay generation reuse */
+    int _size {0};
+
+    bool isAllocated(uint32_t index, uint32_t generation) const {
+        return index >= kNumReservedSlots &&
+               index < _objects.size() &&
+               _generations[index] == generation;
+    }
+
+    static uint32_t makeId(uint32_t index, uint32_t generation) {
+        return (generation << kIndexBits) | index;
+    }
+};
+
+} // namespace game
+
+} // namespace reone
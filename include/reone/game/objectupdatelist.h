@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+namespace reone {
+
+namespace game {
+
+class Object;
+
+/**
+ * Dense list of objects to update every frame. Objects join it by waking up.
+ * After each update, idle objects of types whose update does nothing beyond
+ * base object update fall asleep and leave the list.
+ */
+class ObjectUpdateList : boost::noncopyable {
+public:
+    void add(Object &object);
+
+    /**
+     * Clears entry of the object rather than erasing it, so that objects can
+     * be removed during update.
+     */
+    void remove(Object &object);
+
+    /**
+     * Updates listed objects, including ones woken up during update, then
+     * removes cleared entries and objects that fell asleep.
+     */
+    void update(float dt);
+
+    bool contains(const Object &object) const;
+
+    int size() const { return static_cast<int>(_objects.size()); }
+
+private:
+    std::vector<Object *> _objects;
+};
+
+} // namespace game
+
+} // namespace reone
@@ -29,6 +29,7 @@ struct GameOptions {
     std::filesystem::path path;
     bool developer {false};
     bool neo {false};
+    bool navmesh {false};
 };
 
 struct OptionsView {
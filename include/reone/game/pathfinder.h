@@ -28,31 +28,77 @@ namespace game {
  */
 class Pathfinder : boost::noncopyable {
 public:
+    static constexpr uint16_t kInvalidVertex = 0xffff;
+
     void load(const std::vector<resource::Path::Point> &points, const std::unordered_map<int, float> &pointZ);
 
     const std::vector<glm::vec3> findPath(const glm::vec3 &from, const glm::vec3 &to) const;
 
-private:
-    struct ContextVertex {
-        uint16_t index {0};
-        uint16_t parentIndex {0xffff};
-        float distance {0.0f};
-        float heuristic {0.0f};
-        float totalCost {0.0f};
-    };
+    /**
+     * Finds a path between two vertices. Safe to call from multiple threads.
+     *
+     * @return positions of path vertices, or an empty list if vertices are the same or not connected
+     */
+    std::vector<glm::vec3> findPath(uint16_t fromVertex, uint16_t toVertex) const;
+
+    /**
+     * @return index of the vertex nearest to point, or kInvalidVertex if there are no vertices
+     */
+    uint16_t getNearestVertex(const glm::vec3 &point) const;
 
+private:
+    /**
+     * Per-thread search state, reused between searches. Vertex state is
+     * considered stale unless its search stamp matches the current one, which
+     * saves clearing buffers before every search.
+     */
     struct Context {
-        std::unordered_map<uint16_t, ContextVertex> vertices;
-        std::set<uint16_t> open;
-        std::set<uint16_t> closed;
+        std::vector<float> distances;
+        std::vector<uint16_t> parents;
+        std::vector<uint32_t> stamps;
+        std::vector<bool> closed;
+        uint32_t stamp {0};
+
+        // Open list is an indexed binary heap of vertices, ordered by total cost
+
+        std::vector<uint16_t> heap;
+        std::vector<float> heapCosts;
+        std::vector<uint32_t> heapPositions;
+
+        void reset(size_t numVertices);
+        bool isVisited(uint16_t vertex) const { return stamps[vertex] == stamp; }
+        void visit(uint16_t vertex);
 
-        const ContextVertex &getVertexWithLeastTotalCostFromOpen() const;
+        void push(uint16_t vertex, float totalCost);
+        void decreaseKey(uint16_t vertex, float totalCost);
+        uint16_t pop();
+        bool isOpen(uint16_t vertex) const { return isVisited(vertex) && heapPositions[vertex] != kNotInHeap; }
+
+        void siftUp(uint32_t position);
+        void siftDown(uint32_t position);
+        void swap(uint32_t left, uint32_t right);
     };
 
+    static constexpr uint32_t kNotInHeap = 0xffffffff;
+
+    static thread_local Context _context;
+
     std::vector<glm::vec3> _vertices;
-    std::unordered_map<uint16_t, std::vector<uint16_t>> _adjacentVertices;
 
-    uint16_t getNearestVertex(const glm::vec3 &point) const;
+    // Adjacency in compressed sparse row format: edges of vertex i are stored
+    // in the range [_edgeOffsets[i], _edgeOffsets[i + 1])
+
+    std::vector<uint32_t> _edgeOffsets;
+    std::vector<uint16_t> _edgeTargets;
+    std::vector<float> _edgeCosts;
+
+    // Balanced KD-tree over vertices: median of a range is its root, split
+    // axis alternates between X and Y with depth
+
+    std::vector<uint16_t> _kdTree;
+
+    void buildKdTree(int begin, int end, int depth);
+    void findNearestInKdTree(const glm::vec3 &point, int begin, int end, int depth, uint16_t &nearest, float &nearestDist2) const;
 };
 
 } // namespace game
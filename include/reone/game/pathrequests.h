@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "reone/system/threadpool.h"
+
+#include "navmesh.h"
+#include "pathfinder.h"
+
+namespace reone {
+
+namespace game {
+
+const int kMaxCachedPaths = 256;
+
+/**
+ * Solves path requests asynchronously. Requests made during a frame are
+ * solved as a single batch on a thread pool, against an immutable pathfinder.
+ * Solved paths are handed back on the main thread, and memoized by pairs of
+ * nearest path vertices.
+ *
+ * When a navigation mesh is available, paths are searched on it first, falling
+ * back to path vertices when either point is off the mesh. Navigation mesh
+ * paths depend on exact points, and therefore are not memoized.
+ *
+ * All methods must be called from the main thread.
+ */
+class PathRequests : boost::noncopyable {
+public:
+    struct Result {
+        uint32_t requesterId {0};
+        glm::vec3 destination {0.0f};
+        std::vector<glm::vec3> points;
+    };
+
+    PathRequests(IThreadPool &threadPool) :
+        _threadPool(threadPool) {
+    }
+
+    ~PathRequests();
+
+    void init(std::shared_ptr<const Pathfinder> pathfinder, std::shared_ptr<const NavMesh> navMesh = nullptr);
+
+    /**
+     * Requests a path for the specified requester. Ignored if there is a pending
+     * request from the same requester.
+     */
+    void request(uint32_t requesterId, const glm::vec3 &from, const glm::vec3 &to);
+
+    /**
+     * Submits requests made since the last call to the thread pool.
+     */
+    void flush();
+
+    /**
+     * Invokes fn for every request solved since the last call.
+     */
+    void collect(const std::function<void(Result &)> &fn);
+
+    bool isPending(uint32_t requesterId) const { return _pending.count(requesterId) > 0; }
+
+    int numCachedPaths() const { return static_cast<int>(_cache.size()); }
+
+private:
+    struct Request {
+        Result result;
+        glm::vec3 origin {0.0f};
+        uint16_t fromVertex {Pathfinder::kInvalidVertex};
+        uint16_t toVertex {Pathfinder::kInvalidVertex};
+        bool viaNavMesh {false};
+    };
+
+    /**
+     * State shared with thread pool workers, so that it outlives this object.
+     */
+    struct Batches {
+        std::mutex mutex;
+        std::vector<Request> solved;
+        std::atomic_bool canceled {false};
+    };
+
+    IThreadPool &_threadPool;
+
+    std::shared_ptr<const Pathfinder> _pathfinder;
+    std::shared_ptr<const NavMesh> _navMesh;
+    std::shared_ptr<Batches> _batches;
+
+    std::vector<Request> _queued;
+    std::vector<Request> _ready;
+    std::set<uint32_t> _pending;
+
+    // Least recently used paths are at the back
+    std::list<std::pair<uint32_t, std::vector<glm::vec3>>> _cache;
+    std::unordered_map<uint32_t, decltype(_cache)::iterator> _cacheByKey;
+
+    bool getCachedPath(uint32_t key, std::vector<glm::vec3> &outPoints);
+    void cachePath(uint32_t key, const std::vector<glm::vec3> &points);
+
+    void complete(Request &request);
+
+    static uint32_t getCacheKey(uint16_t fromVertex, uint16_t toVertex) {
+        return (static_cast<uint32_t>(fromVertex) << 16) | toVertex;
+    }
+};
+
+} // namespace game
+
+} // namespace reone
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+namespace reone {
+
+namespace game {
+
+const int kPerceptionRayBudget = 32;
+
+/**
+ * Spreads perception updates over multiple frames. Observers of a cycle are
+ * evaluated in the order they were scheduled, until a per-frame budget of line
+ * of sight tests is exhausted. At least one observer is evaluated per frame.
+ */
+class PerceptionScheduler : boost::noncopyable {
+public:
+    PerceptionScheduler(int rayBudget = kPerceptionRayBudget) :
+        _rayBudget(rayBudget) {
+    }
+
+    /**
+     * Starts a new cycle, discarding observers not yet evaluated.
+     */
+    void schedule(std::vector<uint32_t> observerIds);
+
+    /**
+     * Evaluates pending observers until ray budget is exhausted.
+     *
+     * @param evaluate function that updates perception of an observer and returns a number of line of sight tests performed
+     */
+    void update(const std::function<int(uint32_t)> &evaluate);
+
+    bool isIdle() const { return _next >= _observerIds.size(); }
+
+    int rayBudget() const { return _rayBudget; }
+
+    void setRayBudget(int budget) { _rayBudget = budget; }
+
+private:
+    int _rayBudget;
+
+    std::vector<uint32_t> _observerIds;
+    size_t _next {0};
+};
+
+} // namespace game
+
+} // namespace reone
@@ -18,14 +18,18 @@
 #pragma once
 
 #include "reone/script/types.h"
+#include "reone/script/virtualmachine.h"
 
 namespace reone {
 
 namespace script {
 
+struct ExecutionContext;
+
 class IRoutines;
+class ScriptProgram;
 
-}
+} // namespace script
 
 namespace resource {
 
@@ -49,9 +53,23 @@ public:
         int userDefinedEventNumber = -1,
         int scriptVar = -1);
 
+    /**
+     * Resumes execution of a stored script state, e.g. one passed to DelayCommand.
+     */
+    int resume(const script::ExecutionContext &action, uint32_t callerId);
+
 private:
     script::IRoutines &_routines;
     resource::IScripts &_scripts;
+
+    /**
+     * Idle machines, reused across runs. Scripts can run other scripts, so a
+     * machine is checked out of the pool for the duration of a run.
+     */
+    std::vector<std::unique_ptr<script::VirtualMachine>> _idleMachines;
+
+    std::unique_ptr<script::VirtualMachine> acquireMachine(std::shared_ptr<script::ScriptProgram> program);
+    int runMachine(std::unique_ptr<script::VirtualMachine> machine);
 };
 
 } // namespace game
@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+namespace reone {
+
+namespace game {
+
+const float kSpatialGridCellSize = 8.0f;
+
+/**
+ * Uniform grid over XY plane, indexing values by their positions. Each value
+ * is identified by a unique id and may have a bounding radius, so that objects
+ * with extent (e.g. triggers) can be found by radius queries.
+ */
+template <class T>
+class SpatialGrid : boost::noncopyable {
+public:
+    SpatialGrid(float cellSize = kSpatialGridCellSize) :
+        _cellSize(cellSize) {
+    }
+
+    void clear() {
+        _cells.clear();
+        _cellById.clear();
+        _maxRadius = 0.0f;
+        _minCell = glm::ivec2(std::numeric_limits<int>::max());
+        _maxCell = glm::ivec2(std::numeric_limits<int>::min());
+    }
+
+    void add(uint32_t id, T value, const glm::vec3 &position, float radius = 0.0f) {
+        if (_cellById.count(id) > 0) {
+            remove(id);
+        }
+        auto cell = getCell(position);
+        _cells[getCellKey(cell)].push_back(Item {id, std::move(value), position, radius});
+        _cellById[id] = cell;
+        _maxRadius = std::max(_maxRadius, radius);
+        _minCell = glm::min(_minCell, cell);
+        _maxCell = glm::max(_maxCell, cell);
+    }
+
+    void remove(uint32_t id) {
+        auto maybeCell = _cellById.find(id);
+        if (maybeCell == _cellById.end()) {
+            return;
+        }
+        takeItem(getCellKey(maybeCell->second), id);
+        _cellById.erase(maybeCell);
+    }
+
+    /**
+     * Updates position of a value, moving it to another cell only when
+     * necessary.
+     */
+    void move(uint32_t id, const glm::vec3 &position) {
+        auto maybeCell = _cellById.find(id);
+        if (maybeCell == _cellById.end()) {
+            return;
+        }
+        auto cell = getCell(position);
+        auto oldKey = getCellKey(maybeCell->second);
+        if (cell == maybeCell->second) {
+            auto &items = _cells.find(oldKey)->second;
+            for (auto &item : items) {
+                if (item.id == id) {
+                    item.position = position;
+                    break;
+                }
+            }
+            return;
+        }
+        auto item = takeItem(oldKey, id);
+        item.position = position;
+        _cells[getCellKey(cell)].push_back(std::move(item));
+        maybeCell->second = cell;
+        _minCell = glm::min(_minCell, cell);
+        _maxCell = glm::max(_maxCell, cell);
+    }
+
+    bool contains(uint32_t id) const {
+        return _cellById.count(id) > 0;
+    }
+
+    int size() const {
+        return static_cast<int>(_cellById.size());
+    }
+
+    /**
+     * Invokes fn(value, position) for every value whose bounding circle
+     * intersects a circle of the specified radius around center, on XY plane.
+     */
+    template <class Fn>
+    void forEachInRadius(const glm::vec3 &center, float radius, Fn &&fn) const {
+        glm::ivec2 from, to;
+        if (!getCellRange(center, radius + _maxRadius, from, to)) {
+            return;
+        }
+        glm::vec2 center2d(center);
+        for (int y = from.y; y <= to.y; ++y) {
+            for (int x = from.x; x <= to.x; ++x) {
+                auto maybeItems = _cells.find(getCellKey(glm::ivec2(x, y)));
+                if (maybeItems == _cells.end()) {
+                    continue;
+                }
+                for (auto &item : maybeItems->second) {
+                    float reach = radius + item.radius;
+                    if (glm::distance2(glm::vec2(item.position), center2d) <= reach * reach) {
+                        fn(item.value, item.position);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * Finds up to count values nearest to origin, that satisfy the predicate.
+     * Visits cells in expanding rings around origin, stopping as soon as no
+     * unvisited cell can contain a nearer value.
+     *
+     * @return pairs of values and square distances to origin, sorted by distance
+     */
+    template <class Predicate>
+    std::vector<std::pair<T, float>> findNearest(const glm::vec3 &origin, int count, Predicate &&predicate) const {
+        std::vector<std::pair<T, float>> candidates;
+        if (count <= 0 || _cellById.empty()) {
+            return candidates;
+        }
+        auto compareDistance = [](auto &left, auto &right) { return left.second < right.second; };
+        auto center = getCell(origin);
+        int maxRing = std::max(
+            std::max(std::abs(center.x - _minCell.x), std::abs(_maxCell.x - center.x)),
+            std::max(std::abs(center.y - _minCell.y), std::abs(_maxCell.y - center.y)));
+        for (int ring = 0; ring <= maxRing; ++ring) {
+            for (int y = center.y - ring; y <= center.y + ring; ++y) {
+                bool edge = y == center.y - ring || y == center.y + ring;
+                int step = edge ? 1 : std::max(1, 2 * ring);
+                for (int x = center.x - ring; x <= center.x + ring; x += step) {
+                    auto maybeItems = _cells.find(getCellKey(glm::ivec2(x, y)));
+                    if (maybeItems == _cells.end()) {
+                        continue;
+                    }
+                    for (auto &item : maybeItems->second) {
+                        if (predicate(item.value)) {
+                            candidates.push_back(std::make_pair(item.value, glm::distance2(item.position, origin)));
+                        }
+                    }
+                }
+            }
+            if (candidates.size() < static_cast<size_t>(count)) {
+                continue;
+            }
+            // Values in unvisited cells are at least this far from origin
+            float bound = ring * _cellSize;
+            std::nth_element(candidates.begin(), candidates.begin() + (count - 1), candidates.end(), compareDistance);
+            if (candidates[count - 1].second <= bound * bound) {
+                break;
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(), compareDistance);
+        if (candidates.size() > static_cast<size_t>(count)) {
+            candidates.resize(count);
+        }
+        return candidates;
+    }
+
+private:
+    struct Item {
+        uint32_t id {0};
+        T value;
+        glm::vec3 position {0.0f};
+        float radius {0.0f};
+    };
+
+    float _cellSize;
+
+    std::unordered_map<uint64_t, std::vector<Item>> _cells;
+    std::unordered_map<uint32_t, glm::ivec2> _cellById;
+    float _maxRadius {0.0f};
+    glm::ivec2 _minCell {std::numeric_limits<int>::max()};
+    glm::ivec2 _maxCell {std::numeric_limits<int>::min()};
+
+    glm::ivec2 getCell(const glm::vec3 &position) const {
+        return glm::ivec2(
+            static_cast<int>(glm::floor(position.x / _cellSize)),
+            static_cast<int>(glm::floor(position.y / _cellSize)));
+    }
+
+    bool getCellRange(const glm::vec3 &center, float radius, glm::ivec2 &from, glm::ivec2 &to) const {
+        if (_cellById.empty()) {
+            return false;
+        }
+        from = glm::max(_minCell, getCell(center - glm::vec3(radius, radius, 0.0f)));
+        to = glm::min(_maxCell, getCell(center + glm::vec3(radius, radius, 0.0f)));
+        return from.x <= to.x && from.y <= to.y;
+    }
+
+    Item takeItem(uint64_t key, uint32_t id) {
+        auto maybeItems = _cells.find(key);
+        auto &items = maybeItems->second;
+        auto maybeItem = std::find_if(items.begin(), items.end(), [&id](auto &item) { return item.id == id; });
+        Item item(std::move(*maybeItem));
+        if (maybeItem != items.end() - 1) {
+            *maybeItem = std::move(items.back());
+        }
+        items.pop_back();
+        if (items.empty()) {
+            _cells.erase(maybeItems);
+        }
+        return item;
+    }
+
+    static uint64_t getCellKey(const glm::ivec2 &cell) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(cell.x)) << 32) | static_cast<uint32_t>(cell.y);
+    }
+};
+
+} // namespace game
+
+} // namespace reone
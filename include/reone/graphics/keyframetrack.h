@@ -21,66 +21,110 @@ namespace reone {
 
 namespace graphics {
 
+/**
+ * Playback position within a keyframe track. Owned by whoever samples the
+ * track, so that a shared track can be played back by many channels at once.
+ */
+struct KeyframeCursor {
+    uint32_t index {0}; /**< right keyframe of the last sampled interval, 0 if unset */
+};
+
 template <class Value>
 class KeyframeTrack {
 public:
-    struct Keyframe {
-        float time {0.0f};
-        Value value {Value()};
-    };
-
     void add(float time, Value value) {
-        Keyframe kf;
-        kf.time = time;
-        kf.value = std::move(value);
-        _keyframes.push_back(std::move(kf));
+        _times.push_back(time);
+        _values.push_back(std::move(value));
     }
 
     void update() {
-        std::sort(_keyframes.begin(), _keyframes.end(), [](const auto &lhs, const auto &rhs) {
-            return lhs.time < rhs.time;
+        if (std::is_sorted(_times.begin(), _times.end())) {
+            return;
+        }
+        std::vector<size_t> order(_times.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [this](auto lhs, auto rhs) {
+            return _times[lhs] < _times[rhs];
         });
+        std::vector<float> times;
+        std::vector<Value> values;
+        times.reserve(order.size());
+        values.reserve(order.size());
+        for (auto idx : order) {
+            times.push_back(_times[idx]);
+            values.push_back(std::move(_values[idx]));
+        }
+        _times = std::move(times);
+        _values = std::move(values);
     }
 
     bool valueAtTime(float time, Value &value) const {
-        if (_keyframes.empty()) {
+        KeyframeCursor cursor;
+        return valueAtTime(time, value, cursor);
+    }
+
+    /**
+     * Samples this track, resuming the keyframe search from cursor. Sampling
+     * at non-decreasing times is amortized constant time, seeks fall back to
+     * binary search.
+     */
+    bool valueAtTime(float time, Value &value, KeyframeCursor &cursor) const {
+        if (_times.empty()) {
             return false;
         }
-        if (_keyframes.size() == 1ll || _keyframes[0].time >= time) {
-            value = _keyframes[0].value;
+        if (_times.size() == 1ll || _times[0] >= time) {
+            value = _values[0];
             return true;
         }
-        int rightKfIdx;
-        for (int i = 1; i < _keyframes.size(); ++i) {
-            rightKfIdx = i;
-            if (_keyframes[i].time >= time) {
-                break;
-            }
-        }
-        int leftKfIdx = rightKfIdx - 1;
-        const auto &leftKeyframe = _keyframes[leftKfIdx];
-        const auto &rightKeyframe = _keyframes[rightKfIdx];
-        if (leftKeyframe.time == rightKeyframe.time) {
-            value = leftKeyframe.value;
+        size_t rightKfIdx = seek(time, cursor);
+        size_t leftKfIdx = rightKfIdx - 1;
+        float leftTime = _times[leftKfIdx];
+        float rightTime = _times[rightKfIdx];
+        if (leftTime == rightTime) {
+            value = _values[leftKfIdx];
         } else {
-            float factor = (time - leftKeyframe.time) / (rightKeyframe.time - leftKeyframe.time);
-            value = interpolateKeyframes(leftKeyframe, rightKeyframe, factor);
+            float factor = (time - leftTime) / (rightTime - leftTime);
+            value = glm::mix(_values[leftKfIdx], _values[rightKfIdx], factor);
         }
         return true;
     }
 
-    const std::vector<Keyframe> &keyframes() const {
-        return _keyframes;
-    }
+    bool empty() const { return _times.empty(); }
+    size_t size() const { return _times.size(); }
+
+    const std::vector<float> &times() const { return _times; }
+    const std::vector<Value> &values() const { return _values; }
 
 private:
-    std::vector<Keyframe> _keyframes;
+    static constexpr size_t kMaxCursorSteps = 4;
+
+    std::vector<float> _times;
+    std::vector<Value> _values;
 
-    Value interpolateKeyframes(const Keyframe &lhs, const Keyframe &rhs, float factor) const {
-        if (lhs.time == rhs.time) {
-            return lhs.value;
+    /**
+     * @return index of the first keyframe at or after time, excluding the first keyframe, or index of the last keyframe
+     */
+    size_t seek(float time, KeyframeCursor &cursor) const {
+        size_t lastIdx = _times.size() - 1;
+        size_t idx = cursor.index;
+        if (idx == 0 || idx > lastIdx || (idx > 1 && _times[idx - 1] >= time)) {
+            idx = lowerBound(1, time);
+        } else {
+            for (size_t steps = 0; idx < lastIdx && _times[idx] < time; ++steps) {
+                if (steps == kMaxCursorSteps) {
+                    idx = lowerBound(idx, time);
+                    break;
+                }
+                ++idx;
+            }
         }
-        return glm::mix(lhs.value, rhs.value, factor);
+        cursor.index = static_cast<uint32_t>(idx);
+        return idx;
+    }
+
+    size_t lowerBound(size_t first, float time) const {
+        auto it = std::lower_bound(_times.begin() + first, _times.end(), time);
+        return std::min(static_cast<size_t>(std::distance(_times.begin(), it)), _times.size() - 1);
     }
 };
 
@@ -28,6 +28,12 @@ class ModelNode;
 
 class Model : boost::noncopyable {
 public:
+    /**
+     * Animation node per model node, indexed by depth-first model node index.
+     * Entry is nullptr when animation does not affect that model node.
+     */
+    using AnimationBinding = std::vector<const ModelNode *>;
+
     Model(
         std::string name,
         int classification,
@@ -61,6 +67,11 @@ public:
     std::shared_ptr<ModelNode> getNodeByNameRecursive(const std::string &name) const;
     std::shared_ptr<ModelNode> getAABBNode() const;
 
+    /**
+     * @return model nodes in depth-first order
+     */
+    const std::vector<const ModelNode *> &nodes() const { return _nodes; }
+
     // END Nodes
 
     // Animations
@@ -68,6 +79,14 @@ public:
     std::vector<std::string> getAnimationNames() const;
     std::shared_ptr<Animation> getAnimation(const std::string &name) const;
 
+    /**
+     * Resolves animation nodes of this model. Results are cached for
+     * animations of this model and its supermodels. Animations of other
+     * models, e.g. propagated to attachments, are not owned by this model and
+     * are resolved on every call. Safe to call concurrently.
+     */
+    std::shared_ptr<const AnimationBinding> getAnimationBinding(const Animation &anim) const;
+
     const std::unordered_map<std::string, std::shared_ptr<Animation>> &animations() const {
         return _animations;
     }
@@ -86,9 +105,13 @@ private:
     bool _affectedByFog;
     std::shared_ptr<Model> _superModel;
 
+    std::vector<const ModelNode *> _nodes;
     std::unordered_map<uint16_t, std::shared_ptr<ModelNode>> _nodeByNumber;
     std::unordered_map<std::string, std::shared_ptr<ModelNode>> _nodeByName;
 
+    mutable std::unordered_map<const Animation *, std::shared_ptr<const AnimationBinding>> _animBindings; /**< only animations retained by this model */
+    mutable std::mutex _animBindingsMutex;
+
     void fillLookups(const std::shared_ptr<ModelNode> &node);
     void computeAABB();
 };
@@ -219,21 +219,21 @@ public:
 
     // Keyframe Tracks
 
-    inline bool positionAtTime(float time, glm::vec3 &position) const {
-        return vectorValueAtTime(ControllerTypes::position, time, position);
+    inline bool positionAtTime(float time, glm::vec3 &position, KeyframeCursor *cursor = nullptr) const {
+        return vectorValueAtTime(ControllerTypes::position, time, position, cursor);
     }
 
-    inline bool orientationAtTime(float time, glm::quat &orientation) const {
-        return quaternionValueAt(ControllerTypes::orientation, time, orientation);
+    inline bool orientationAtTime(float time, glm::quat &orientation, KeyframeCursor *cursor = nullptr) const {
+        return quaternionValueAt(ControllerTypes::orientation, time, orientation, cursor);
     }
 
-    inline bool scaleAtTime(float time, float &scale) const {
-        return floatValueAtTime(ControllerTypes::scale, time, scale);
+    inline bool scaleAtTime(float time, float &scale, KeyframeCursor *cursor = nullptr) const {
+        return floatValueAtTime(ControllerTypes::scale, time, scale, cursor);
     }
 
-    bool floatValueAtTime(ControllerType type, float time, float &value) const;
-    bool vectorValueAtTime(ControllerType type, float time, glm::vec3 &value) const;
-    bool quaternionValueAt(ControllerType type, float time, glm::quat &value) const;
+    bool floatValueAtTime(ControllerType type, float time, float &value, KeyframeCursor *cursor = nullptr) const;
+    bool vectorValueAtTime(ControllerType type, float time, glm::vec3 &value, KeyframeCursor *cursor = nullptr) const;
+    bool quaternionValueAt(ControllerType type, float time, glm::quat &value, KeyframeCursor *cursor = nullptr) const;
 
     KeyframeTrackMap<float> &floatTracks() { return _floatTracks; }
     KeyframeTrackMap<glm::vec3> &vectorTracks() { return _vectorTracks; }
@@ -24,15 +24,24 @@ namespace reone {
 
 namespace graphics {
 
+/**
+ * Bitmask of walkmesh materials. Bit N is set when material N is included.
+ */
+using SurfaceMask = uint64_t;
+
 class Walkmesh : boost::noncopyable {
 public:
     struct Face {
         int index {0};
         uint32_t material {0};
-        std::vector<glm::vec3> vertices;
+        std::array<glm::vec3, 3> vertices {glm::vec3(0.0f), glm::vec3(0.0f), glm::vec3(0.0f)};
         glm::vec3 normal {0.0f};
     };
 
+    /**
+     * AABB tree node, as stored in walkmesh files. Only used to build
+     * the flat bounding volume hierarchy.
+     */
     struct AABB {
         graphics::AABB value;
         int faceIdx {-1};
@@ -41,10 +50,10 @@ public:
     };
 
     /**
-     * @return pointer to intersected face or nullptr when no intersection
+     * @return pointer to nearest intersected face or nullptr when no intersection
      */
     const Walkmesh::Face *raycast(
-        std::set<uint32_t> walkcheckSurfaces,
+        SurfaceMask surfaces,
         const glm::vec3 &origin,
         const glm::vec3 &dir,
         float maxDistance,
@@ -54,36 +63,73 @@ public:
 
     bool isAreaWalkmesh() const { return _area; }
 
+    const graphics::AABB &aabb() const { return _aabb; }
+
     const std::vector<Face> &faces() const { return _faces; }
 
-    void add(Face &&face) {
-        _faces.push_back(face);
-    }
+    void add(Face &&face);
 
-    void setRootAABB(std::shared_ptr<AABB> aabb) {
-        _rootAabb = std::move(aabb);
+    /**
+     * Replaces brute force raycasting with a bounding volume hierarchy,
+     * flattened from the AABB tree. Must be called after adding all faces.
+     */
+    void setRootAABB(std::shared_ptr<AABB> aabb);
+
+    /**
+     * @return mask of surfaces, ignoring materials that do not fit into it
+     */
+    static SurfaceMask getSurfaceMask(const std::set<uint32_t> &surfaces);
+
+    static bool hasSurface(SurfaceMask surfaces, uint32_t material) {
+        return material < 8 * sizeof(SurfaceMask) && (surfaces & (static_cast<SurfaceMask>(1) << material)) != 0;
     }
 
 private:
+    /**
+     * Node of a flat bounding volume hierarchy. Nodes are in depth-first
+     * order, so that the first child of an inner node immediately follows
+     * it, and traversal can skip a subtree without a stack.
+     */
+    struct Node {
+        glm::vec3 min {0.0f};
+        uint32_t skip {0};  /**< index of the node following this subtree */
+        glm::vec3 max {0.0f};
+        uint32_t block {0}; /**< for leaves, index of triangle block plus one, zero otherwise */
+    };
+
+    /**
+     * Triangles in structure-of-arrays layout, in blocks of kTriangleBlockSize.
+     * Blocks are padded with triangles having an empty material bit.
+     */
+    struct Triangles {
+        std::vector<float> v0x, v0y, v0z;
+        std::vector<float> e1x, e1y, e1z;
+        std::vector<float> e2x, e2y, e2z;
+        std::vector<SurfaceMask> materialBits;
+        std::vector<int> faces;
+        size_t count {0};
+
+        void clear();
+        void push(const Face &face, int faceIdx);
+        void pad();
+        size_t size() const { return faces.size(); }
+    };
+
     std::vector<Face> _faces;
-    std::shared_ptr<AABB> _rootAabb;
+    std::vector<Node> _nodes;
+    Triangles _triangles;
+    graphics::AABB _aabb;
 
     bool _area {false};
 
-    const Walkmesh::Face *raycastAABB(
-        std::set<uint32_t> surfaces,
-        const glm::vec3 &origin,
-        const glm::vec3 &dir,
-        float maxDistance,
-        float &outDistance) const;
+    int flattenAABB(const AABB &aabb);
 
-    bool raycastFace(
-        std::set<uint32_t> surfaces,
-        const Walkmesh::Face &face,
+    int raycastBlock(
+        size_t block,
+        SurfaceMask surfaces,
         const glm::vec3 &origin,
         const glm::vec3 &dir,
-        float maxDistance,
-        float &outDistance) const;
+        float &inOutDistance) const;
 
     friend class BwmReader;
 };
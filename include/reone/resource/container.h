@@ -20,11 +20,16 @@
 #include "reone/system/types.h"
 
 #include "id.h"
+#include "resource.h"
 
 namespace reone {
 
 namespace resource {
 
+/**
+ * Implementations must allow findResourceData and findResourceView to be
+ * called concurrently from multiple threads.
+ */
 class IResourceContainer {
 public:
     virtual ~IResourceContainer() {
@@ -32,6 +37,24 @@ public:
 
     virtual std::optional<ByteBuffer> findResourceData(const ResourceId &id) = 0;
 
+    /**
+     * Default implementation copies resource data into a buffer owned by the
+     * returned view. Containers backed by memory-mapped files override this to
+     * return a view directly into the mapping.
+     */
+    virtual std::optional<ResourceView> findResourceView(const ResourceId &id) {
+        auto data = findResourceData(id);
+        if (!data) {
+            return std::nullopt;
+        }
+        auto buffer = std::make_shared<ByteBuffer>(std::move(*data));
+        auto view = ResourceView();
+        view.data = buffer->data();
+        view.size = buffer->size();
+        view.owner = std::move(buffer);
+        return view;
+    }
+
     virtual const std::unordered_set<ResourceId> &resourceIds() const = 0;
 };
 
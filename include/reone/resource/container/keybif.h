@@ -17,20 +17,21 @@
 
 #pragma once
 
+#include "reone/system/memorymappedfile.h"
 #include "reone/system/stream/fileinput.h"
 
 #include "../container.h"
+#include "../format/keyreader.h"
 
 namespace reone {
 
 namespace resource {
 
-class BifReader;
-
 class KeyBifResourceContainer : public IResourceContainer, boost::noncopyable {
 public:
-    KeyBifResourceContainer(std::filesystem::path keyPath) :
-        _keyPath(std::move(keyPath)) {
+    KeyBifResourceContainer(std::filesystem::path keyPath, bool mapped = false) :
+        _keyPath(std::move(keyPath)),
+        _mapped(mapped) {
     }
 
     void init();
@@ -38,6 +39,7 @@ public:
     // IResourceContainer
 
     std::optional<ByteBuffer> findResourceData(const ResourceId &id) override;
+    std::optional<ResourceView> findResourceView(const ResourceId &id) override;
 
     const std::unordered_set<ResourceId> &resourceIds() const override { return _resourceIds; }
 
@@ -51,11 +53,16 @@ private:
     };
 
     std::filesystem::path _keyPath;
+    bool _mapped;
 
     std::vector<std::unique_ptr<FileInputStream>> _bifs;
+    std::mutex _bifsMutex;
+    std::vector<std::shared_ptr<MemoryMappedFile>> _bifMappings;
 
     std::unordered_set<ResourceId> _resourceIds;
     std::unordered_map<ResourceId, Resource> _idToResource;
+
+    void loadBifResources(IInputStream &bif, const std::vector<const KeyReader::KeyEntry *> &keys);
 };
 
 } // namespace resource
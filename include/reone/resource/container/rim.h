@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "reone/system/memorymappedfile.h"
 #include "reone/system/stream/fileinput.h"
 
 #include "../container.h"
@@ -27,8 +28,9 @@ namespace resource {
 
 class RimResourceContainer : public IResourceContainer, boost::noncopyable {
 public:
-    RimResourceContainer(std::filesystem::path path) :
-        _path(std::move(path)) {
+    RimResourceContainer(std::filesystem::path path, bool mapped = false) :
+        _path(std::move(path)),
+        _mapped(mapped) {
     }
 
     void init();
@@ -36,6 +38,7 @@ public:
     // IResourceContainer
 
     std::optional<ByteBuffer> findResourceData(const ResourceId &id) override;
+    std::optional<ResourceView> findResourceView(const ResourceId &id) override;
 
     const std::unordered_set<ResourceId> &resourceIds() const override { return _resourceIds; }
 
@@ -49,10 +52,16 @@ private:
     };
 
     std::filesystem::path _path;
+    bool _mapped;
+
     std::unique_ptr<FileInputStream> _rim;
+    std::mutex _rimMutex;
+    std::shared_ptr<MemoryMappedFile> _mapping;
 
     std::unordered_set<ResourceId> _resourceIds;
     std::unordered_map<ResourceId, Resource> _idToResource;
+
+    void loadResources(IInputStream &rim);
 };
 
 } // namespace resource
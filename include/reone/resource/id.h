@@ -31,13 +31,13 @@ struct ResourceId {
 
     ResourceId() = default;
 
-    ResourceId(std::string resRef, ResType type) :
-        resRef(ResRef(std::move(resRef))),
+    ResourceId(const std::string &resRef, ResType type) :
+        resRef(ResRef(resRef)),
         type(type) {
     }
 
     ResourceId(ResRef resRef, ResType type) :
-        resRef(std::move(resRef)),
+        resRef(resRef),
         type(type) {
     }
 
@@ -46,8 +46,7 @@ struct ResourceId {
     }
 
     size_t hash() const {
-        size_t hash = 0;
-        boost::hash_combine(hash, resRef.value());
+        size_t hash = resRef.hash();
         boost::hash_combine(hash, type);
         return hash;
     }
@@ -36,6 +36,19 @@ public:
     virtual void clear() = 0;
 
     virtual std::shared_ptr<Gff> get(const std::string &resRef, ResType type) = 0;
+
+    // Staged loading
+
+    /**
+     * Reads a GFF without touching the cache. Safe to call concurrently.
+     */
+    virtual std::shared_ptr<Gff> decode(const ResourceId &id) = 0;
+
+    virtual void add(ResourceId id, std::shared_ptr<Gff> gff) = 0;
+
+    virtual bool contains(const ResourceId &id) const = 0;
+
+    // END Staged loading
 };
 
 class Gffs : public IGffs, boost::noncopyable {
@@ -50,6 +63,16 @@ public:
 
     std::shared_ptr<Gff> get(const std::string &resRef, ResType type) override;
 
+    std::shared_ptr<Gff> decode(const ResourceId &id) override;
+
+    void add(ResourceId id, std::shared_ptr<Gff> gff) override {
+        _cache.add(std::move(id), std::move(gff));
+    }
+
+    bool contains(const ResourceId &id) const override {
+        return _cache.contains(id);
+    }
+
 private:
     Resources &_resources;
 
@@ -39,6 +39,24 @@ public:
     }
 
     virtual std::shared_ptr<graphics::Model> get(const std::string &resRef) = 0;
+
+    // Staged loading
+
+    /**
+     * Reads a model without touching the cache or creating GPU objects. Safe
+     * to call concurrently.
+     */
+    virtual std::shared_ptr<graphics::Model> decode(const std::string &resRef) = 0;
+
+    /**
+     * Resolves the supermodel of a decoded model, uploads it to the GPU and
+     * adds it to the cache, unless already cached.
+     */
+    virtual void add(const std::string &resRef, std::shared_ptr<graphics::Model> model) = 0;
+
+    virtual bool contains(const std::string &resRef) const = 0;
+
+    // END Staged loading
 };
 
 class Models : public IModels, boost::noncopyable {
@@ -55,6 +73,10 @@ public:
 
     std::shared_ptr<graphics::Model> get(const std::string &resRef) override;
 
+    std::shared_ptr<graphics::Model> decode(const std::string &resRef) override;
+    void add(const std::string &resRef, std::shared_ptr<graphics::Model> model) override;
+    bool contains(const std::string &resRef) const override;
+
 private:
     Textures &_textures;
     Resources &_resources;
@@ -62,7 +84,7 @@ private:
 
     std::unordered_map<std::string, std::shared_ptr<graphics::Model>> _cache;
 
-    std::shared_ptr<graphics::Model> doGet(const std::string &resRef);
+    void finalize(graphics::Model &model);
 };
 
 } // namespace resource
@@ -18,11 +18,18 @@
 #pragma once
 
 #include "reone/script/program.h"
+#include "reone/script/verifier.h"
 
 #include "../resources.h"
 
 namespace reone {
 
+namespace script {
+
+class IRoutines;
+
+}
+
 namespace resource {
 
 class IScripts {
@@ -31,6 +38,11 @@ public:
 
     virtual void clear() = 0;
 
+    /**
+     * Enables load-time verification of programs against routines.
+     */
+    virtual void enableVerification(script::IRoutines &routines) = 0;
+
     virtual std::shared_ptr<script::ScriptProgram> get(const std::string &key) = 0;
 };
 
@@ -44,6 +56,8 @@ public:
         _objects.clear();
     }
 
+    void enableVerification(script::IRoutines &routines) override;
+
     std::shared_ptr<script::ScriptProgram> get(const std::string &key) override {
         auto maybeObject = _objects.find(key);
         if (maybeObject != _objects.end()) {
@@ -56,9 +70,13 @@ public:
 private:
     Resources &_resources;
 
+    std::unique_ptr<script::ScriptVerifier> _verifier;
+
     std::unordered_map<std::string, std::shared_ptr<script::ScriptProgram>> _objects;
 
     std::shared_ptr<script::ScriptProgram> doGet(std::string resRef);
+
+    void verify(script::ScriptProgram &program);
 };
 
 } // namespace resource
@@ -40,6 +40,24 @@ public:
     virtual void clear() = 0;
 
     virtual std::shared_ptr<graphics::Texture> get(const std::string &resRef, graphics::TextureUsage usage = graphics::TextureUsage::Default) = 0;
+
+    // Staged loading
+
+    /**
+     * Reads a texture without touching the cache or creating GPU objects. Safe
+     * to call concurrently.
+     */
+    virtual std::shared_ptr<graphics::Texture> decode(const std::string &resRef, graphics::TextureUsage usage = graphics::TextureUsage::Default) = 0;
+
+    /**
+     * Uploads a decoded texture to the GPU and adds it to the cache, unless
+     * already cached.
+     */
+    virtual void add(const std::string &resRef, std::shared_ptr<graphics::Texture> texture) = 0;
+
+    virtual bool contains(const std::string &resRef) const = 0;
+
+    // END Staged loading
 };
 
 class Textures : public ITextures, boost::noncopyable {
@@ -55,6 +73,10 @@ public:
 
     std::shared_ptr<graphics::Texture> get(const std::string &resRef, graphics::TextureUsage usage = graphics::TextureUsage::Default) override;
 
+    std::shared_ptr<graphics::Texture> decode(const std::string &resRef, graphics::TextureUsage usage = graphics::TextureUsage::Default) override;
+    void add(const std::string &resRef, std::shared_ptr<graphics::Texture> texture) override;
+    bool contains(const std::string &resRef) const override;
+
 private:
     int _activeUnit {0};
 
@@ -62,8 +84,6 @@ private:
     Resources &_resources;
 
     std::unordered_map<std::string, std::shared_ptr<graphics::Texture>> _cache;
-
-    std::shared_ptr<graphics::Texture> doGet(const std::string &resRef, graphics::TextureUsage usage);
 };
 
 } // namespace resource
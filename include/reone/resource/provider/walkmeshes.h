@@ -37,6 +37,19 @@ public:
     virtual void clear() = 0;
 
     virtual std::shared_ptr<graphics::Walkmesh> get(const std::string &resRef, ResType type) = 0;
+
+    // Staged loading
+
+    /**
+     * Reads a walkmesh without touching the cache. Safe to call concurrently.
+     */
+    virtual std::shared_ptr<graphics::Walkmesh> decode(const std::string &resRef, ResType type) = 0;
+
+    virtual void add(const std::string &resRef, std::shared_ptr<graphics::Walkmesh> walkmesh) = 0;
+
+    virtual bool contains(const std::string &resRef) const = 0;
+
+    // END Staged loading
 };
 
 class Walkmeshes : public IWalkmeshes, boost::noncopyable {
@@ -47,12 +60,14 @@ public:
 
     std::shared_ptr<graphics::Walkmesh> get(const std::string &resRef, ResType type) override;
 
+    std::shared_ptr<graphics::Walkmesh> decode(const std::string &resRef, ResType type) override;
+    void add(const std::string &resRef, std::shared_ptr<graphics::Walkmesh> walkmesh) override;
+    bool contains(const std::string &resRef) const override;
+
 private:
     resource::Resources &_resources;
 
     std::unordered_map<std::string, std::shared_ptr<graphics::Walkmesh>> _cache;
-
-    std::shared_ptr<graphics::Walkmesh> doGet(const std::string &resRef, ResType type);
 };
 
 } // namespace resource
@@ -28,6 +28,18 @@ struct Resource {
     bool local {false};
 };
 
+/**
+ * Read-only view of resource data. Unlike Resource, does not necessarily own
+ * the data: owner keeps the underlying storage (e.g. a memory-mapped archive)
+ * alive for as long as the view is in use.
+ */
+struct ResourceView {
+    const char *data {nullptr};
+    size_t size {0};
+    std::shared_ptr<const void> owner;
+    bool local {false};
+};
+
 } // namespace resource
 
 } // namespace reone
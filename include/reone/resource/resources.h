@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "reone/system/threadpool.h"
 #include "reone/system/types.h"
 
 #include "container.h"
@@ -49,24 +50,29 @@ public:
 
     virtual Resource get(const ResourceId &id) = 0;
     virtual std::optional<Resource> find(const ResourceId &id) = 0;
+    virtual std::optional<ResourceView> findView(const ResourceId &id) = 0;
+
+    virtual std::vector<std::future<bool>> prefetch(const std::vector<ResourceId> &ids, IThreadPool &threadPool) = 0;
 };
 
+/**
+ * Lookups (get, find and findView) are safe to call concurrently from multiple
+ * threads, including while containers are being added or removed.
+ */
 class Resources : public IResources, boost::noncopyable {
 public:
-    void clear() override {
-        _containers.clear();
-    }
+    static constexpr size_t kDefaultPrefetchCapacity = 64 * 1024 * 1024;
 
-    void clearLocal() override {
-        auto toErase = std::remove_if(_containers.begin(), _containers.end(), [](auto &pair) {
-            return pair.local;
-        });
-        _containers.erase(toErase, _containers.end());
-    }
+    ~Resources();
 
-    void add(std::unique_ptr<IResourceContainer> provider, bool local = false) {
-        _containers.push_front(ResourceContainerLocalPair {std::move(provider), local});
-    }
+    void clear() override;
+    void clearLocal() override;
+
+    /**
+     * Containers must be fully populated before being added: resources are
+     * indexed at the time of addition.
+     */
+    void add(std::unique_ptr<IResourceContainer> provider, bool local = false);
 
     void addKEY(const std::filesystem::path &path) override;
     void addERF(const std::filesystem::path &path, bool local = false) override;
@@ -76,11 +82,94 @@ public:
 
     Resource get(const ResourceId &id) override;
     std::optional<Resource> find(const ResourceId &id) override;
+    std::optional<ResourceView> findView(const ResourceId &id) override;
+
+    /**
+     * Loads resources into a bounded cache on thread pool workers, so that
+     * subsequent lookups find them already resident. Each prefetched resource
+     * is evicted from the cache once looked up. Returned futures resolve to
+     * whether the corresponding resource was found.
+     *
+     * Tasks dropped by the thread pool, e.g. on deinitialization, are
+     * treated as canceled. Thread pool must either outlive this object or be
+     * deinitialized before it is destroyed.
+     */
+    std::vector<std::future<bool>> prefetch(const std::vector<ResourceId> &ids, IThreadPool &threadPool) override;
 
     const ResourceContainerList &containers() const { return _containers; }
 
+    /**
+     * When enabled, subsequently added KEY/BIF, ERF and RIM containers are
+     * memory-mapped, and findView returns views directly into the mappings.
+     */
+    void setMemoryMapped(bool mapped) {
+        _memoryMapped = mapped;
+    }
+
+    bool isPrefetched(const ResourceId &id) {
+        std::lock_guard<std::mutex> lock {_prefetchMutex};
+        return _prefetched.count(id) > 0;
+    }
+
+    void setPrefetchCapacity(size_t bytes) {
+        std::lock_guard<std::mutex> lock {_prefetchMutex};
+        _prefetchCapacity = bytes;
+    }
+
 private:
+    struct IndexEntry {
+        IResourceContainer *container {nullptr};
+        bool local {false};
+    };
+
     ResourceContainerList _containers;
+    std::shared_mutex _containersMutex;
+
+    /**
+     * Maps every resource to the highest-priority container that provides it,
+     * so that a lookup does not depend on the number of containers.
+     */
+    std::unordered_map<ResourceId, IndexEntry> _index;
+
+    bool _memoryMapped {false};
+
+    // Prefetching
+
+    /**
+     * Counts a prefetch task as pending for as long as the thread pool holds
+     * it, whether the task is eventually run or dropped.
+     */
+    class PendingPrefetch : boost::noncopyable {
+    public:
+        PendingPrefetch(Resources &resources);
+        ~PendingPrefetch();
+
+    private:
+        Resources &_resources;
+    };
+
+    struct PrefetchedResource {
+        ResourceView view;
+        std::list<ResourceId>::iterator orderIt;
+    };
+
+    std::unordered_map<ResourceId, PrefetchedResource> _prefetched;
+    std::list<ResourceId> _prefetchOrder;
+    std::atomic_int _prefetchGeneration {0};
+    size_t _prefetchedBytes {0};
+    size_t _prefetchCapacity {kDefaultPrefetchCapacity};
+    int _numPendingPrefetches {0};
+    std::atomic_bool _prefetchCanceled {false};
+    std::mutex _prefetchMutex;
+    std::condition_variable _prefetchCondVar;
+
+    // END Prefetching
+
+    std::optional<ResourceView> findIndexedView(const ResourceId &id);
+
+    std::optional<ResourceView> takePrefetched(const ResourceId &id);
+    void addPrefetched(const ResourceId &id, ResourceView view, int generation);
+    void clearPrefetched();
 };
 
 } // namespace resource
@@ -25,44 +25,85 @@ namespace resource {
 
 static constexpr int kMaxResRefLength = 16;
 
+/**
+ * Case-insensitive resource name of at most 16 characters. Stored inline as a
+ * lower-cased, zero-padded array with a precomputed hash, so that construction
+ * does not allocate, and hashing and comparison are fixed-width operations.
+ */
 class ResRef {
 public:
     ResRef() = default;
 
-    ResRef(std::string value) :
-        _value(std::move(value)) {
-        if (_value.size() > kMaxResRefLength) {
-            _value.erase(kMaxResRefLength);
-        }
-        boost::to_lower(_value);
+    ResRef(const std::string &value) {
+        init(value.data(), value.size());
+    }
+
+    explicit ResRef(const char *value) {
+        init(value, std::strlen(value));
+    }
+
+    explicit ResRef(std::string_view value) {
+        init(value.data(), value.size());
+    }
+
+    inline std::string value() const {
+        return std::string(_value.data(), _length);
     }
 
-    inline const std::string &value() const {
-        return _value;
+    inline std::string_view view() const {
+        return std::string_view(_value.data(), _length);
+    }
+
+    inline size_t length() const {
+        return _length;
+    }
+
+    inline bool empty() const {
+        return _length == 0;
     }
 
     inline size_t hash() const {
-        return std::hash<std::string>()(_value);
+        return _hash;
     }
 
     inline bool operator==(const ResRef &rhs) const {
-        return _value == rhs._value;
+        return _hash == rhs._hash && std::memcmp(_value.data(), rhs._value.data(), kMaxResRefLength) == 0;
     }
 
     inline bool operator!=(const ResRef &rhs) const {
-        return _value != rhs._value;
+        return !(*this == rhs);
     }
 
     inline bool operator<(const ResRef &rhs) const {
-        return _value < rhs._value;
+        return std::memcmp(_value.data(), rhs._value.data(), kMaxResRefLength) < 0;
     }
 
     inline bool operator>(const ResRef &rhs) const {
-        return _value > rhs._value;
+        return std::memcmp(_value.data(), rhs._value.data(), kMaxResRefLength) > 0;
     }
 
 private:
-    std::string _value;
+    std::array<char, kMaxResRefLength> _value {};
+    uint8_t _length {0};
+    size_t _hash {0};
+
+    inline void init(const char *value, size_t length) {
+        _length = static_cast<uint8_t>(std::min(length, static_cast<size_t>(kMaxResRefLength)));
+        std::memcpy(_value.data(), value, _length);
+
+        // Branchless lower-casing over a fixed-width buffer, vectorizable by the compiler
+        for (int i = 0; i < kMaxResRefLength; ++i) {
+            auto ch = static_cast<uint8_t>(_value[i]);
+            _value[i] = static_cast<char>(ch | (static_cast<uint8_t>(ch - 'A') < 26 ? 0x20 : 0));
+        }
+
+        uint64_t lo, hi;
+        std::memcpy(&lo, &_value[0], sizeof(lo));
+        std::memcpy(&hi, &_value[8], sizeof(hi));
+        uint64_t hash = (lo ^ (hi * 0x9e3779b97f4a7c15ull)) * 0xbf58476d1ce4e5b9ull;
+        hash ^= hash >> 31;
+        _hash = static_cast<size_t>(hash);
+    }
 };
 
 } // namespace resource
@@ -30,6 +30,19 @@ struct Collision {
     int material {-1};
 };
 
+/**
+ * Collision test in a batch. Elevation tests only use origin on XY plane,
+ * and only walk tests use excludeUser.
+ */
+struct CollisionQuery {
+    glm::vec3 origin {0.0f};
+    glm::vec3 dest {0.0f};
+    const IUser *excludeUser {nullptr};
+
+    bool result {false};
+    Collision collision;
+};
+
 } // namespace scene
 
 } // namespace reone
@@ -21,6 +21,7 @@
 #include "reone/graphics/di/module.h"
 #include "reone/graphics/options.h"
 #include "reone/resource/di/module.h"
+#include "reone/system/di/module.h"
 
 #include "../graphs.h"
 #include "../render/pipeline.h"
@@ -35,10 +36,12 @@ class SceneModule : boost::noncopyable {
 public:
     SceneModule(
         graphics::GraphicsOptions &graphicsOpt,
+        SystemModule &system,
         resource::ResourceModule &resource,
         graphics::GraphicsModule &graphics,
         audio::AudioModule &audio) :
         _graphicsOpt(graphicsOpt),
+        _system(system),
         _resource(resource),
         _graphics(graphics),
         _audio(audio) {
@@ -56,6 +59,7 @@ public:
 
 private:
     graphics::GraphicsOptions &_graphicsOpt;
+    SystemModule &_system;
     graphics::GraphicsModule &_graphics;
     audio::AudioModule &_audio;
     resource::ResourceModule &_resource;
@@ -24,16 +24,21 @@
 #include "node/dummy.h"
 #include "node/emitter.h"
 #include "node/grass.h"
+#include "node/grasscluster.h"
 #include "node/light.h"
 #include "node/mesh.h"
 #include "node/model.h"
+#include "node/particle.h"
 #include "node/sound.h"
 #include "node/trigger.h"
 #include "node/walkmesh.h"
+#include "nodepool.h"
 #include "user.h"
 
 namespace reone {
 
+class IThreadPool;
+
 namespace graphics {
 
 struct GraphicsOptions;
@@ -58,6 +63,7 @@ struct ResourceServices;
 namespace scene {
 
 struct Collision;
+struct CollisionQuery;
 
 class IAnimationEventListener;
 class IRenderPass;
@@ -76,6 +82,14 @@ public:
     virtual bool testLineOfSight(const glm::vec3 &origin, const glm::vec3 &dest, Collision &outCollision) const = 0;
     virtual bool testWalk(const glm::vec3 &origin, const glm::vec3 &dest, const IUser *excludeUser, Collision &outCollision) const = 0;
 
+    /**
+     * Batch versions of collision tests. Queries are processed in parallel
+     * when threadPool is not null.
+     */
+    virtual void testElevationBatch(std::vector<CollisionQuery> &queries, IThreadPool *threadPool) const = 0;
+    virtual void testLineOfSightBatch(std::vector<CollisionQuery> &queries, IThreadPool *threadPool) const = 0;
+    virtual void testWalkBatch(std::vector<CollisionQuery> &queries, IThreadPool *threadPool) const = 0;
+
     virtual ModelSceneNode *pickModelAt(int x, int y, IUser *except = nullptr) const = 0;
     virtual std::optional<std::reference_wrapper<ModelSceneNode>> pickModelRay(const glm::vec3 &origin, const glm::vec3 &dir) const = 0;
 
@@ -142,13 +156,15 @@ public:
         graphics::GraphicsOptions &graphicsOpt,
         graphics::GraphicsServices &graphicsSvc,
         audio::AudioServices &audioSvc,
-        resource::ResourceServices &resourceSvc) :
+        resource::ResourceServices &resourceSvc,
+        IThreadPool *threadPool) :
         _name(std::move(name)),
         _renderPipelineFactory(renderPipelineFactory),
         _graphicsOpt(graphicsOpt),
         _graphicsSvc(graphicsSvc),
         _audioSvc(audioSvc),
-        _resourceSvc(resourceSvc) {
+        _resourceSvc(resourceSvc),
+        _threadPool(threadPool) {
     }
 
     void update(float dt) override;
@@ -244,12 +260,16 @@ public:
     bool testLineOfSight(const glm::vec3 &origin, const glm::vec3 &dest, Collision &outCollision) const override;
     bool testWalk(const glm::vec3 &origin, const glm::vec3 &dest, const IUser *excludeUser, Collision &outCollision) const override;
 
+    void testElevationBatch(std::vector<CollisionQuery> &queries, IThreadPool *threadPool) const override;
+    void testLineOfSightBatch(std::vector<CollisionQuery> &queries, IThreadPool *threadPool) const override;
+    void testWalkBatch(std::vector<CollisionQuery> &queries, IThreadPool *threadPool) const override;
+
     ModelSceneNode *pickModelAt(int x, int y, IUser *except = nullptr) const override;
     std::optional<std::reference_wrapper<ModelSceneNode>> pickModelRay(const glm::vec3 &origin, const glm::vec3 &dir) const override;
 
-    void setWalkableSurfaces(std::set<uint32_t> surfaces) override { _walkableSurfaces = std::move(surfaces); }
-    void setWalkcheckSurfaces(std::set<uint32_t> surfaces) override { _walkcheckSurfaces = std::move(surfaces); }
-    void setLineOfSightSurfaces(std::set<uint32_t> surfaces) override { _lineOfSightSurfaces = std::move(surfaces); }
+    void setWalkableSurfaces(std::set<uint32_t> surfaces) override { _walkableSurfaces = graphics::Walkmesh::getSurfaceMask(surfaces); }
+    void setWalkcheckSurfaces(std::set<uint32_t> surfaces) override { _walkcheckSurfaces = graphics::Walkmesh::getSurfaceMask(surfaces); }
+    void setLineOfSightSurfaces(std::set<uint32_t> surfaces) override { _lineOfSightSurfaces = graphics::Walkmesh::getSurfaceMask(surfaces); }
 
     // END Collision detection and object picking
 
@@ -280,6 +300,7 @@ private:
     graphics::GraphicsServices &_graphicsSvc;
     audio::AudioServices &_audioSvc;
     resource::ResourceServices &_resourceSvc;
+    IThreadPool *_threadPool; /**< when not null, model roots are animated in parallel */
 
     std::unique_ptr<IRenderPipeline> _renderPipeline;
 
@@ -289,18 +310,32 @@ private:
     bool _renderWalkmeshes {false};
     bool _renderTriggers {false};
 
-    std::set<std::shared_ptr<SceneNode>> _nodes;
+    using NodePools = std::tuple<
+        SceneNodePool<CameraSceneNode>,
+        SceneNodePool<DummySceneNode>,
+        SceneNodePool<EmitterSceneNode>,
+        SceneNodePool<GrassSceneNode>,
+        SceneNodePool<GrassClusterSceneNode>,
+        SceneNodePool<LightSceneNode>,
+        SceneNodePool<MeshSceneNode>,
+        SceneNodePool<ModelSceneNode>,
+        SceneNodePool<ParticleSceneNode>,
+        SceneNodePool<SoundSceneNode>,
+        SceneNodePool<TriggerSceneNode>,
+        SceneNodePool<WalkmeshSceneNode>>;
+
+    std::shared_ptr<NodePools> _nodePools {std::make_shared<NodePools>()}; /**< shared with every node allocated from it */
 
     CameraSceneNode *_activeCamera {nullptr};
     std::vector<LightSceneNode *> _flareLights;
 
     // Roots
 
-    std::list<std::shared_ptr<ModelSceneNode>> _modelRoots;
-    std::list<std::shared_ptr<WalkmeshSceneNode>> _walkmeshRoots;
-    std::list<std::shared_ptr<TriggerSceneNode>> _triggerRoots;
-    std::list<std::shared_ptr<GrassSceneNode>> _grassRoots;
-    std::list<std::shared_ptr<SoundSceneNode>> _soundRoots;
+    std::vector<std::shared_ptr<ModelSceneNode>> _modelRoots;
+    std::vector<std::shared_ptr<WalkmeshSceneNode>> _walkmeshRoots;
+    std::vector<std::shared_ptr<TriggerSceneNode>> _triggerRoots;
+    std::vector<std::shared_ptr<GrassSceneNode>> _grassRoots;
+    std::vector<std::shared_ptr<SoundSceneNode>> _soundRoots;
 
     // END Roots
 
@@ -345,12 +380,48 @@ private:
 
     // Surfaces
 
-    std::set<uint32_t> _walkableSurfaces;
-    std::set<uint32_t> _walkcheckSurfaces;
-    std::set<uint32_t> _lineOfSightSurfaces;
+    graphics::SurfaceMask _walkableSurfaces {0};
+    graphics::SurfaceMask _walkcheckSurfaces {0};
+    graphics::SurfaceMask _lineOfSightSurfaces {0};
 
     // END Surfaces
 
+    // Collision detection
+
+    /**
+     * Broad phase of collision tests: uniform grid over XY bounds of area
+     * walkmeshes, which are static. Other walkmeshes are few and might move,
+     * so they are always tested.
+     */
+    struct WalkmeshGrid {
+        glm::vec2 origin {0.0f};
+        float cellSize {1.0f};
+        glm::ivec2 numCells {0};
+        std::vector<WalkmeshSceneNode *> roots;
+        std::vector<glm::vec4> rootBounds; /**< min and max on XY plane */
+        std::vector<glm::ivec4> rootCells; /**< min and max cell */
+        std::vector<int> cellOffsets;
+        std::vector<int> cellRoots;
+    };
+
+    WalkmeshGrid _walkmeshGrid;
+    std::vector<WalkmeshSceneNode *> _dynamicWalkmeshRoots;
+
+    void rebuildWalkmeshGrid();
+
+    template <class Fn>
+    void forEachWalkmeshRoot(const glm::vec2 &min, const glm::vec2 &max, const Fn &fn) const;
+
+    void testElevation(WalkmeshSceneNode &root, const glm::vec3 &origin, float &inOutMinDistance, bool &outWalkable, Collision &outCollision) const;
+    void testLineOfSight(WalkmeshSceneNode &root, const glm::vec3 &origin, const glm::vec3 &dest, float &inOutMinDistance, Collision &outCollision) const;
+    void testWalk(WalkmeshSceneNode &root, const glm::vec3 &origin, const glm::vec3 &dest, const IUser *excludeUser, float &inOutMinDistance, Collision &outCollision) const;
+
+    void processBatch(std::vector<CollisionQuery> &queries, IThreadPool *threadPool, const std::function<void(CollisionQuery &)> &fn) const;
+
+    // END Collision detection
+
+    void updateModelRoots(float dt);
+    void computeAbsoluteTransforms();
     void cullRoots();
 
     void refresh();
@@ -370,9 +441,8 @@ private:
 
     template <class T, class... Params>
     std::shared_ptr<T> newSceneNode(Params... params) {
-        auto node = std::make_shared<T>(params..., *this, _graphicsSvc, _audioSvc, _resourceSvc);
-        _nodes.insert(node);
-        return node;
+        auto &node = std::get<SceneNodePool<T>>(*_nodePools).create(params..., *this, _graphicsSvc, _audioSvc, _resourceSvc);
+        return std::shared_ptr<T>(_nodePools, &node);
     }
 };
 
@@ -62,12 +62,14 @@ public:
         graphics::GraphicsOptions &graphicsOpt,
         graphics::GraphicsServices &graphicsSvc,
         audio::AudioServices &audioSvc,
-        resource::ResourceServices &resourceSvc) :
+        resource::ResourceServices &resourceSvc,
+        IThreadPool &threadPool) :
         _renderPipelineFactory(renderPipelineFactory),
         _graphicsOpt(graphicsOpt),
         _graphicsSvc(graphicsSvc),
         _audioSvc(audioSvc),
-        _resourceSvc(resourceSvc) {
+        _resourceSvc(resourceSvc),
+        _threadPool(threadPool) {
     }
 
     void reserve(std::string name) override;
@@ -88,6 +90,7 @@ private:
     graphics::GraphicsServices &_graphicsSvc;
     audio::AudioServices &_audioSvc;
     resource::ResourceServices &_resourceSvc;
+    IThreadPool &_threadPool;
 
     std::unordered_map<std::string, std::shared_ptr<ISceneGraph>> _scenes;
 };
@@ -76,7 +76,7 @@ public:
     SceneNodeType type() const { return _type; }
     SceneNode *parent() { return _parent; }
     const SceneNode *parent() const { return _parent; }
-    const std::unordered_set<SceneNode *> &children() const { return _children; }
+    const std::vector<SceneNode *> &children() const { return _children; }
     const graphics::AABB &aabb() const { return _aabb; }
     IUser *user() { return _user; }
     const IUser *user() const { return _user; }
@@ -95,11 +95,23 @@ public:
     // Transformations
 
     const glm::mat4 &localTransform() const { return _localTransform; }
-    const glm::mat4 &absoluteTransform() const { return _absTransform; }
-    const glm::mat4 &absoluteTransformInverse() const { return _absTransformInv; }
+    const glm::mat4 &absoluteTransform() const;
+    const glm::mat4 &absoluteTransformInverse() const;
 
     void setLocalTransform(glm::mat4 transform);
 
+    /**
+     * Resolves absolute transforms of this node and its descendants that
+     * have been invalidated since the last call. Subtrees without
+     * invalidated transforms are skipped.
+     */
+    void computeAbsoluteTransforms();
+
+    /**
+     * @return true if absolute transform of this node or any of its descendants has been invalidated since the last computeAbsoluteTransforms call
+     */
+    bool hasInvalidatedAbsoluteTransforms() const { return _subtreeDirty; }
+
     // END Transformations
 
 protected:
@@ -110,7 +122,8 @@ protected:
     resource::ResourceServices &_resourceSvc;
 
     SceneNode *_parent {nullptr};
-    std::unordered_set<SceneNode *> _children;
+    std::vector<SceneNode *> _children; /**< unordered */
+    size_t _childIndex {0};             /**< index of this node in children of its parent */
 
     graphics::AABB _aabb;
 
@@ -126,9 +139,17 @@ protected:
 
     // Transformations
 
+    // Absolute transforms are resolved lazily: changing local transform of
+    // a node only invalidates it and its descendants. Descendants of an
+    // invalidated node are always invalidated too, and its ancestors are
+    // marked as having an invalidated subtree.
+
     glm::mat4 _localTransform {1.0f};
-    glm::mat4 _absTransform {1.0f};
-    glm::mat4 _absTransformInv {1.0f};
+    mutable glm::mat4 _absTransform {1.0f};
+    mutable glm::mat4 _absTransformInv {1.0f};
+    mutable bool _absTransformDirty {false};
+    mutable bool _absTransformInvDirty {false};
+    bool _subtreeDirty {false}; /**< has absolute transform of this node or any of its descendants been invalidated? */
 
     // END Transformations
 
@@ -145,8 +166,16 @@ protected:
         _resourceSvc(resourceSvc) {
     }
 
-    void computeAbsoluteTransforms();
+    void invalidateAbsoluteTransforms();
+
+    /**
+     * Marks this node and its ancestors as having an invalidated subtree.
+     */
+    void markSubtreeDirty();
 
+    /**
+     * Called when absolute transform of this node has been invalidated.
+     */
     virtual void onAbsoluteTransformChanged() {}
 };
 
@@ -42,13 +42,14 @@ public:
 
     bool isInFrustum(const SceneNode &other) const;
 
-    std::shared_ptr<graphics::Camera> camera() const { return _camera; }
+    std::shared_ptr<graphics::Camera> camera() const;
 
     void setOrthographicProjection(float left, float right, float bottom, float top, float zNear, float zFar);
     void setPerspectiveProjection(float fovy, float aspect, float zNear, float zFar);
 
 private:
     std::shared_ptr<graphics::Camera> _camera;
+    mutable bool _viewDirty {false}; /**< camera view is refreshed from absolute transform on access */
 
     void onAbsoluteTransformChanged() override;
 };
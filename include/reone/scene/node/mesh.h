@@ -51,6 +51,11 @@ public:
     void render(IRenderPass &pass);
     void renderShadow(IRenderPass &pass);
 
+    /**
+     * Refreshes bone palette of this skin mesh from current bone transforms.
+     */
+    void computeBoneTransforms();
+
     bool shouldRender() const;
     bool shouldCastShadows() const;
 
@@ -103,6 +108,8 @@ private:
 
     float _windTime {0.0f};
 
+    std::vector<glm::mat4> _boneTransforms; /**< preallocated on init, refreshed once per frame */
+
     void initTextures();
     void initDanglyMesh();
 
@@ -65,18 +65,30 @@ public:
         glm::vec3 color {0.0f};
     };
 
+    struct AnimationCursors {
+        graphics::KeyframeCursor position;
+        graphics::KeyframeCursor orientation;
+        graphics::KeyframeCursor scale;
+        graphics::KeyframeCursor alpha;
+        graphics::KeyframeCursor selfIllumColor;
+        graphics::KeyframeCursor color;
+    };
+
     struct AnimationChannel {
         graphics::Animation *anim;
+        std::shared_ptr<const graphics::Model::AnimationBinding> binding; /**< animation node per model node */
         graphics::LipAnimation *lipAnim;
         AnimationProperties properties;
         float time {0.0f};
-        std::unordered_map<uint16_t, AnimationState> stateByNodeNumber;
-        bool freeze {false};     /**< channel time is not to be updated */
-        bool transition {false}; /**< when computing states, use animation transition time as channel time */
-        bool finished {false};   /**< finished channels will be erased from the queue */
+        std::vector<AnimationState> states;    /**< animation state per model node, indexed like binding */
+        std::vector<AnimationCursors> cursors; /**< keyframe track cursors per model node, indexed like binding */
+        bool freeze {false};                   /**< channel time is not to be updated */
+        bool transition {false};               /**< when computing states, use animation transition time as channel time */
+        bool finished {false};                 /**< finished channels will be erased from the queue */
 
-        AnimationChannel(graphics::Animation &anim, graphics::LipAnimation *lipAnim, AnimationProperties properties) :
+        AnimationChannel(graphics::Animation &anim, std::shared_ptr<const graphics::Model::AnimationBinding> binding, graphics::LipAnimation *lipAnim, AnimationProperties properties) :
             anim(&anim),
+            binding(std::move(binding)),
             lipAnim(lipAnim),
             properties(std::move(properties)) {
         }
@@ -103,6 +115,14 @@ public:
 
     void update(float dt) override;
 
+    /**
+     * Evaluates animations and bone transforms of this model and its attached
+     * models ahead of update. Touches no state outside of this model, so that
+     * independent models can be evaluated concurrently. Animation events are
+     * signalled on update.
+     */
+    void evaluateAnimations(float dt);
+
     void renderLeafs(IRenderPass &pass, const std::vector<SceneNode *> &leafs) override;
     void renderAABB(IRenderPass &pass);
 
@@ -163,6 +183,8 @@ private:
     std::unordered_map<uint16_t, ModelNodeSceneNode *> _nodeByNumber;
     std::unordered_map<std::string, ModelNodeSceneNode *> _nodeByName;
     std::unordered_map<std::string, SceneNode *> _attachments;
+    std::vector<ModelNodeSceneNode *> _nodeByIndex; /**< scene node per depth-first model node index */
+    std::vector<MeshSceneNode *> _skinMeshes;
 
     // END Lookups
 
@@ -170,6 +192,8 @@ private:
 
     std::deque<AnimationChannel> _animChannels;
     AnimationBlendMode _animBlendMode {AnimationBlendMode::Single};
+    std::vector<std::string> _pendingEvents;
+    bool _animationsEvaluated {false};
 
     // END Animation
 
@@ -180,13 +204,15 @@ private:
     // END Flags
 
     void buildNodeTree(graphics::ModelNode &node, SceneNode &parent);
+    void buildNodeIndex();
 
     // Animation
 
     void updateAnimations(float dt);
     void updateAnimationChannel(AnimationChannel &channel, float dt);
-    void computeAnimationStates(AnimationChannel &channel, float time, const graphics::ModelNode &modelNode);
-    void applyAnimationStates(const graphics::ModelNode &modelNode);
+    void computeAnimationStates(AnimationChannel &channel, float time);
+    void applyAnimationStates();
+    void computeBoneTransforms();
 
     static AnimationBlendMode getAnimationBlendMode(int flags);
 
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+namespace reone {
+
+namespace scene {
+
+/**
+ * Arena of scene nodes of a single type. Nodes are constructed in place in
+ * fixed-size chunks and are never moved, so nodes created together, e.g.
+ * nodes of a single model, end up adjacent in memory. Nodes are destroyed
+ * together with the pool.
+ */
+template <class T>
+class SceneNodePool : boost::noncopyable {
+public:
+    ~SceneNodePool() {
+        for (auto chunk = _chunks.rbegin(); chunk != _chunks.rend(); ++chunk) {
+            size_t count = (chunk == _chunks.rbegin()) ? _lastChunkSize : kChunkSize;
+            for (size_t i = count; i > 0; --i) {
+                reinterpret_cast<T *>(&(*chunk)[i - 1])->~T();
+            }
+        }
+    }
+
+    template <class... Args>
+    T &create(Args &&...args) {
+        if (_chunks.empty() || _lastChunkSize == kChunkSize) {
+            _chunks.push_back(std::make_unique<Storage[]>(kChunkSize));
+            _lastChunkSize = 0;
+        }
+        auto node = new (&_chunks.back()[_lastChunkSize]) T(std::forward<Args>(args)...);
+        ++_lastChunkSize;
+        return *node;
+    }
+
+private:
+    using Storage = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+    static constexpr size_t kChunkSize = std::max<size_t>(1, 16384 / sizeof(T));
+
+    std::vector<std::unique_ptr<Storage[]>> _chunks;
+    size_t _lastChunkSize {0};
+};
+
+} // namespace scene
+
+} // namespace reone
@@ -78,6 +78,18 @@ struct Instruction {
     static Instruction newNEQUALTT(uint16_t size);
 };
 
+/**
+ * Instruction with its successor and jump target resolved to indices into the
+ * compiled program. Index equal to the number of compiled instructions denotes
+ * the end of the program.
+ */
+struct CompiledInstruction {
+    const Instruction *ins {nullptr};
+    InstructionType type {InstructionType::NOP};
+    int nextIdx {-1};
+    int jumpIdx {-1}; /**< -1 if not a jump or if target is not an instruction */
+};
+
 class ScriptProgram : boost::noncopyable {
 public:
     ScriptProgram(std::string name) :
@@ -88,18 +100,42 @@ public:
 
     const std::string &name() const { return _name; }
     uint32_t length() const { return _length; }
-    const std::vector<Instruction> instructions() const { return _instructions; }
+    const std::vector<Instruction> &instructions() const { return _instructions; }
 
     const Instruction &getInstruction(uint32_t offset) const;
 
+    /**
+     * @return index of compiled instruction at offset, number of compiled instructions if offset is past the end, -1 otherwise
+     */
+    int getInstructionIndex(uint32_t offset) const;
+
+    /**
+     * Compiles this program on first call. Safe to call concurrently, but not
+     * concurrently with add.
+     */
+    const std::vector<CompiledInstruction> &compiled() const;
+
+    /**
+     * @return true if program passed ScriptVerifier and can run without runtime type checks
+     */
+    bool isVerified() const { return _verified; }
+
     void setLength(uint32_t length) { _length = length; }
+    void setVerified(bool verified) { _verified = verified; }
 
 private:
     std::string _name;
 
     uint32_t _length {13};
+    bool _verified {false};
     std::vector<Instruction> _instructions;
     std::unordered_map<uint32_t, int> _insIdxByOffset;
+
+    mutable std::vector<CompiledInstruction> _compiled;
+    mutable std::atomic_bool _compiledValid {false};
+    mutable std::mutex _compileMutex;
+
+    void compile() const;
 };
 
 } // namespace script
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "types.h"
+
+namespace reone {
+
+namespace script {
+
+/**
+ * Compact representation of a Variable on the VirtualMachine stack.
+ *
+ * Strings are borrowed from either the program or a per-execution arena, and
+ * engine types and actions are indices into per-execution tables. Copying a
+ * slot therefore never allocates nor touches a reference count.
+ */
+struct StackSlot {
+    static constexpr uint32_t kNullRef = 0xffffffff;
+
+    VariableType type {VariableType::Void};
+
+    union {
+        int32_t intValue {0};
+        uint32_t objectId;
+        float floatValue;
+        uint32_t refIdx; /**< index into engine type or action table of the VirtualMachine */
+    };
+
+    const std::string *strValue {nullptr};
+
+    static StackSlot ofInt(int value) {
+        StackSlot slot;
+        slot.type = VariableType::Int;
+        slot.intValue = value;
+        return slot;
+    }
+
+    static StackSlot ofFloat(float value) {
+        StackSlot slot;
+        slot.type = VariableType::Float;
+        slot.floatValue = value;
+        return slot;
+    }
+
+    static StackSlot ofObject(uint32_t objectId) {
+        StackSlot slot;
+        slot.type = VariableType::Object;
+        slot.objectId = objectId;
+        return slot;
+    }
+
+    static StackSlot ofString(const std::string &value) {
+        StackSlot slot;
+        slot.type = VariableType::String;
+        slot.strValue = &value;
+        return slot;
+    }
+
+    static StackSlot ofRef(VariableType type, uint32_t refIdx) {
+        StackSlot slot;
+        slot.type = type;
+        slot.refIdx = refIdx;
+        return slot;
+    }
+};
+
+static_assert(sizeof(StackSlot) <= 16, "StackSlot must fit in 16 bytes");
+static_assert(std::is_trivially_copyable<StackSlot>::value, "StackSlot must be trivially copyable");
+
+} // namespace script
+
+} // namespace reone
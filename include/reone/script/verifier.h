@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "types.h"
+
+namespace reone {
+
+namespace script {
+
+struct CompiledInstruction;
+struct Instruction;
+
+class IRoutines;
+class ScriptProgram;
+
+/**
+ * Load-time type checker for script programs. Abstractly interprets every
+ * reachable path, including subroutines and resumption points of stored
+ * states, tracking the type of each stack slot. Programs that pass can be
+ * executed without runtime type checks.
+ */
+class ScriptVerifier : boost::noncopyable {
+public:
+    ScriptVerifier(IRoutines &routines) :
+        _routines(routines) {
+    }
+
+    /**
+     * @throws std::runtime_error if program cannot be proven type-safe
+     */
+    void verify(const ScriptProgram &program);
+
+private:
+    /**
+     * Abstract machine state: types of stack slots and base pointer.
+     */
+    struct State {
+        std::vector<VariableType> stack;
+        int bp {0}; /**< -1 if unknown */
+
+        bool operator==(const State &other) const {
+            return bp == other.bp && stack == other.stack;
+        }
+
+        bool operator!=(const State &other) const {
+            return !(*this == other);
+        }
+    };
+
+    struct Subroutine {
+        int entryIdx {0};
+        State entry;
+        bool analyzed {false};
+        std::optional<State> exit; /**< empty if subroutine never returns */
+    };
+
+    IRoutines &_routines;
+
+    // Per-program analysis
+
+    const ScriptProgram *_program {nullptr};
+    const std::vector<CompiledInstruction> *_compiled {nullptr};
+    std::list<Subroutine> _subroutines;
+    std::vector<std::pair<int, State>> _resumePoints;
+
+    // END Per-program analysis
+
+    std::optional<State> analyze(int entryIdx, State entry, int depth);
+    std::optional<State> call(int entryIdx, const State &entry, int depth);
+
+    void execute(const CompiledInstruction &compiled, State &state);
+    void executeAction(const Instruction &ins, State &state);
+    void executeStoreState(const Instruction &ins, const State &state);
+};
+
+} // namespace script
+
+} // namespace reone
@@ -18,6 +18,7 @@
 #pragma once
 
 #include "executionstate.h"
+#include "stackslot.h"
 #include "types.h"
 
 namespace reone {
@@ -25,7 +26,9 @@ namespace reone {
 namespace script {
 
 #define R_INSTR_HANDLER(a) void execute##a(const Instruction &);
+#define R_JUMP_HANDLER(a) void execute##a(const CompiledInstruction &);
 
+struct CompiledInstruction;
 struct ExecutionContext;
 struct Instruction;
 struct Variable;
@@ -35,35 +38,61 @@ class ScriptProgram;
 class VirtualMachine : boost::noncopyable {
 public:
     VirtualMachine(std::shared_ptr<ScriptProgram> program, std::unique_ptr<ExecutionContext> context);
+    ~VirtualMachine();
 
     int run();
 
+    /**
+     * Prepares this machine to run program from the beginning. Clears
+     * execution state, but retains allocated storage and the execution
+     * context, so that the machine can be reused across runs.
+     */
+    void reset(std::shared_ptr<ScriptProgram> program);
+
     void stackPush(Variable var) {
-        _stack.push_back(std::move(var));
+        _stack.push_back(toSlot(std::move(var)));
     }
 
     int getStackSize() const;
-    const Variable &getStackVariable(int index) const;
+    Variable getStackVariable(int index) const;
+
+    ExecutionContext &context() { return *_context; }
 
 private:
     std::shared_ptr<ScriptProgram> _program;
     std::unique_ptr<ExecutionContext> _context;
-    std::unordered_map<InstructionType, std::function<void(const Instruction &)>> _handlers;
-    std::vector<Variable> _stack;
-    std::vector<uint32_t> _returnOffsets;
-    uint32_t _nextInstruction {0};
+    std::vector<StackSlot> _stack;
+    std::vector<int> _returnIndices;
+    int _nextIdx {0};
     int _globalCount {0};
+    bool _checked {true};
     ExecutionState _savedState;
 
-    void registerHandler(InstructionType type, std::function<void(VirtualMachine *, const Instruction &)> handler) {
-        _handlers.insert(std::make_pair(type, std::bind(handler, this, std::placeholders::_1)));
-    }
+    // Per-execution storage referenced by stack slots
+
+    std::deque<std::string> _strings;
+    std::vector<std::shared_ptr<EngineType>> _engineTypes;
+    std::vector<std::shared_ptr<ExecutionContext>> _actions;
+
+    // END Per-execution storage referenced by stack slots
+
+    std::vector<Variable> _routineArgs;
+
+    int getJumpTarget(const CompiledInstruction &ins) const;
+
+    StackSlot toSlot(Variable var);
+    Variable toVariable(const StackSlot &slot) const;
+
+    const std::shared_ptr<EngineType> &getEngineType(const StackSlot &slot) const;
+    const std::shared_ptr<ExecutionContext> &getAction(const StackSlot &slot) const;
+
+    bool slotsEqual(const StackSlot &lhs, const StackSlot &rhs) const;
 
     int getIntFromStack();
     float getFloatFromStack();
     glm::vec3 getVectorFromStack();
 
-    void withStackVariables(const std::function<void(const Variable &, const Variable &)> &fn);
+    void withStackSlots(const std::function<void(const StackSlot &, const StackSlot &)> &fn);
     void withIntsFromStack(const std::function<void(int, int)> &fn);
     void withIntFloatFromStack(const std::function<void(int, float)> &fn);
     void withFloatIntFromStack(const std::function<void(float, int)> &fn);
@@ -159,15 +188,15 @@ private:
     R_INSTR_HANDLER(NEGI)
     R_INSTR_HANDLER(NEGF)
     R_INSTR_HANDLER(MOVSP)
-    R_INSTR_HANDLER(JMP)
-    R_INSTR_HANDLER(JSR)
-    R_INSTR_HANDLER(JZ)
-    R_INSTR_HANDLER(RETN)
+    R_JUMP_HANDLER(JMP)
+    R_JUMP_HANDLER(JSR)
+    R_JUMP_HANDLER(JZ)
+    R_JUMP_HANDLER(RETN)
     R_INSTR_HANDLER(DESTRUCT)
     R_INSTR_HANDLER(DECISP)
     R_INSTR_HANDLER(INCISP)
     R_INSTR_HANDLER(NOTI)
-    R_INSTR_HANDLER(JNZ)
+    R_JUMP_HANDLER(JNZ)
     R_INSTR_HANDLER(CPDOWNBP)
     R_INSTR_HANDLER(CPTOPBP)
     R_INSTR_HANDLER(DECIBP)
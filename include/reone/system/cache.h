@@ -35,6 +35,14 @@ public:
         return inserted->second;
     }
 
+    void add(Key key, std::shared_ptr<Value> value) {
+        _items.insert(std::make_pair(std::move(key), std::move(value)));
+    }
+
+    bool contains(const Key &key) const {
+        return _items.count(key) > 0;
+    }
+
 private:
     std::map<Key, std::shared_ptr<Value>, Comparer> _items;
 };
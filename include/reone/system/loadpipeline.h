@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "threadpool.h"
+
+namespace reone {
+
+/**
+ * Staged loader that decodes resources on a thread pool and finalizes them on
+ * the calling thread.
+ *
+ * Stages run in the order they were added. Each stage first resolves its jobs
+ * on the calling thread, which lets it depend on what earlier stages produced.
+ * Decode functions of a stage run concurrently on worker threads, and each
+ * returns an upload function that is then invoked on the calling thread, e.g.
+ * to create GPU objects.
+ */
+class LoadPipeline : boost::noncopyable {
+public:
+    using UploadFunc = std::function<void()>;
+    using DecodeFunc = std::function<UploadFunc()>;
+
+    class Stage : boost::noncopyable {
+    public:
+        void addJob(DecodeFunc decode) {
+            _jobs.push_back(std::move(decode));
+        }
+
+        const std::string &name() const { return _name; }
+
+    private:
+        std::string _name;
+        std::vector<DecodeFunc> _jobs;
+
+        Stage(std::string name) :
+            _name(std::move(name)) {
+        }
+
+        friend class LoadPipeline;
+    };
+
+    using ResolveFunc = std::function<void(Stage &)>;
+
+    /**
+     * @param progress fraction of the pipeline completed, in [0, 1]
+     */
+    using ProgressCallback = std::function<void(float progress)>;
+
+    struct StageTimings {
+        std::string name;
+        int numJobs {0};
+        float resolveMs {0.0f};
+        float decodeMs {0.0f}; /**< wall time from first decode start to last decode end */
+        float uploadMs {0.0f}; /**< total time spent in upload functions */
+    };
+
+    LoadPipeline(IThreadPool &threadPool) :
+        _threadPool(threadPool) {
+    }
+
+    void addStage(std::string name, ResolveFunc resolve);
+
+    /**
+     * Runs all stages, blocking until done. If any decode or upload function
+     * throws, the remaining jobs of the stage are drained and the first
+     * exception is rethrown.
+     */
+    void run(ProgressCallback progress = nullptr);
+
+    const std::vector<StageTimings> &timings() const { return _timings; }
+
+private:
+    struct PendingStage {
+        std::string name;
+        ResolveFunc resolve;
+    };
+
+    IThreadPool &_threadPool;
+
+    std::vector<PendingStage> _stages;
+    std::vector<StageTimings> _timings;
+
+    StageTimings runStage(PendingStage &pending, int stageIdx, int numStages, const ProgressCallback &progress);
+};
+
+} // namespace reone
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+namespace reone {
+
+/**
+ * Read-only memory mapping of an entire file. Shared ownership of an instance
+ * keeps views into the mapping valid.
+ */
+class MemoryMappedFile : boost::noncopyable {
+public:
+    MemoryMappedFile(std::filesystem::path path) :
+        _path(std::move(path)) {
+    }
+
+    void init();
+
+    const char *data() const { return _data; }
+    size_t size() const { return _size; }
+
+private:
+    std::filesystem::path _path;
+
+    boost::interprocess::file_mapping _mapping;
+    boost::interprocess::mapped_region _region;
+
+    const char *_data {nullptr};
+    size_t _size {0};
+};
+
+} // namespace reone
@@ -33,6 +33,11 @@ public:
         _length(bytes.size()) {
     }
 
+    MemoryInputStream(const char *data, size_t length) :
+        _data(data),
+        _length(length) {
+    }
+
     void seek(int64_t off, SeekOrigin origin) override {
         if (origin == SeekOrigin::Begin) {
             _position = off;
@@ -58,7 +63,7 @@ public:
     size_t length() override { return _length; }
 
 private:
-    char *_data;
+    const char *_data;
     size_t _length;
 
     size_t _position {0};
@@ -104,4 +104,14 @@ private:
     }
 };
 
+/**
+ * Invokes fn for consecutive ranges of [0, count), of at most grainSize
+ * elements, on the calling thread and on thread pool workers. Returns when
+ * all ranges have been processed. Ranges are claimed dynamically, so that
+ * a busy thread pool only delays, but never blocks, the calling thread.
+ *
+ * fn must not throw.
+ */
+void parallelFor(IThreadPool &threadPool, size_t count, size_t grainSize, const std::function<void(size_t begin, size_t end)> &fn);
+
 } // namespace reone
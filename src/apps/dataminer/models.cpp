@@ -255,17 +255,17 @@ static ModelStats analyzeModel(graphics::Model &model) {
             nodeStats = &stats.dummy;
         }
         for (const auto &[type, track] : node.quaternionTracks()) {
-            for (const auto &[time, value] : track.keyframes()) {
+            for (const auto &value : track.values()) {
                 nodeStats->appendQuaternion(type, value);
             }
         }
         for (const auto &[type, track] : node.vectorTracks()) {
-            for (const auto &[time, value] : track.keyframes()) {
+            for (const auto &value : track.values()) {
                 nodeStats->appendVector(type, value);
             }
         }
         for (const auto &[type, track] : node.floatTracks()) {
-            for (const auto &[time, value] : track.keyframes()) {
+            for (const auto &value : track.values()) {
                 nodeStats->appendFloat(type, value);
             }
         }
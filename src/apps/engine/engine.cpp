@@ -70,6 +70,7 @@ void Engine::init() {
         *_scriptModule);
     _sceneModule = std::make_unique<SceneModule>(
         _options.graphics,
+        *_systemModule,
         *_resourceModule,
         *_graphicsModule,
         *_audioModule);
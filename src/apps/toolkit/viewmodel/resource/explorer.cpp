@@ -111,7 +111,7 @@ ResourceExplorerViewModel::ResourceExplorerViewModel() {
     _audioModule = std::make_unique<AudioModule>(_audioOpt);
     _scriptModule = std::make_unique<ScriptModule>();
     _resourceModule = std::make_unique<ResourceModule>(_gameId, _resourcesPath, _graphicsOpt, _audioOpt, *_graphicsModule, *_audioModule, *_scriptModule);
-    _sceneModule = std::make_unique<SceneModule>(_graphicsOpt, *_resourceModule, *_graphicsModule, *_audioModule);
+    _sceneModule = std::make_unique<SceneModule>(_graphicsOpt, *_systemModule, *_resourceModule, *_graphicsModule, *_audioModule);
 
     _imageResViewModel = std::make_unique<ImageResourceViewModel>();
     _modelResViewModel = std::make_unique<ModelResourceViewModel>(*_systemModule, *_graphicsModule, *_resourceModule, *_sceneModule);
@@ -17,25 +17,16 @@
 
 #include "reone/game/action/docommand.h"
 
-#include "reone/script/executioncontext.h"
-#include "reone/script/program.h"
-#include "reone/script/virtualmachine.h"
-
-
+#include "reone/game/game.h"
 #include "reone/game/object.h"
-
-using namespace reone::script;
+#include "reone/game/script/runner.h"
 
 namespace reone {
 
 namespace game {
 
 void DoCommandAction::execute(std::shared_ptr<Action> self, Object &actor, float dt) {
-    auto executionCtx = std::make_unique<ExecutionContext>(*_actionToDo);
-    executionCtx->callerId = actor.id();
-
-    std::shared_ptr<ScriptProgram> program(_actionToDo->savedState->program);
-    VirtualMachine(program, std::move(executionCtx)).run();
+    _game.scriptRunner().resume(*_actionToDo, actor.id());
     complete();
 }
 
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "reone/game/arearesourceloader.h"
+
+#include "reone/graphics/model.h"
+#include "reone/graphics/modelnode.h"
+#include "reone/graphics/walkmesh.h"
+#include "reone/resource/di/services.h"
+#include "reone/resource/layout.h"
+#include "reone/resource/provider/gffs.h"
+#include "reone/resource/provider/layouts.h"
+#include "reone/resource/provider/models.h"
+#include "reone/resource/provider/textures.h"
+#include "reone/resource/provider/walkmeshes.h"
+
+using namespace reone::graphics;
+using namespace reone::resource;
+
+namespace reone {
+
+namespace game {
+
+void AreaResourceLoader::load(const std::string &areaName, const generated::ARE &are, const generated::GIT &git, LoadPipeline::ProgressCallback progress) {
+    std::vector<std::shared_ptr<Model>> roomModels;
+
+    auto pipeline = LoadPipeline(_threadPool);
+    pipeline.addStage("blueprints", [this, &git](LoadPipeline::Stage &stage) {
+        resolveBlueprints(git, stage);
+    });
+    pipeline.addStage("rooms", [this, &areaName, &roomModels](LoadPipeline::Stage &stage) {
+        resolveRooms(areaName, roomModels, stage);
+    });
+    pipeline.addStage("textures", [this, &are, &roomModels](LoadPipeline::Stage &stage) {
+        resolveTextures(are, roomModels, stage);
+    });
+    pipeline.run(std::move(progress));
+
+    _timings = pipeline.timings();
+}
+
+void AreaResourceLoader::resolveBlueprints(const generated::GIT &git, LoadPipeline::Stage &stage) {
+    std::set<ResourceId> ids;
+    for (auto &creature : git.Creature_List) {
+        ids.insert(ResourceId(creature.TemplateResRef, ResType::Utc));
+    }
+    for (auto &door : git.Door_List) {
+        ids.insert(ResourceId(door.TemplateResRef, ResType::Utd));
+    }
+    for (auto &placeable : git.Placeable_List) {
+        ids.insert(ResourceId(placeable.TemplateResRef, ResType::Utp));
+    }
+    for (auto &waypoint : git.WaypointList) {
+        ids.insert(ResourceId(waypoint.TemplateResRef, ResType::Utw));
+    }
+    for (auto &trigger : git.TriggerList) {
+        ids.insert(ResourceId(trigger.TemplateResRef, ResType::Utt));
+    }
+    for (auto &sound : git.SoundList) {
+        ids.insert(ResourceId(sound.TemplateResRef, ResType::Uts));
+    }
+    for (auto &encounter : git.Encounter_List) {
+        ids.insert(ResourceId(encounter.TemplateResRef, ResType::Ute));
+    }
+    for (auto &id : ids) {
+        if (id.resRef.empty() || _resourceSvc.gffs.contains(id)) {
+            continue;
+        }
+        stage.addJob([this, id]() -> LoadPipeline::UploadFunc {
+            auto gff = _resourceSvc.gffs.decode(id);
+            return [this, id, gff]() {
+                _resourceSvc.gffs.add(id, gff);
+            };
+        });
+    }
+}
+
+void AreaResourceLoader::resolveRooms(const std::string &areaName, std::vector<std::shared_ptr<Model>> &roomModels, LoadPipeline::Stage &stage) {
+    auto layout = _resourceSvc.layouts.get(areaName);
+    if (!layout) {
+        return;
+    }
+    std::set<std::string> roomNames;
+    for (auto &lytRoom : layout->rooms) {
+        roomNames.insert(boost::to_lower_copy(lytRoom.name));
+    }
+    for (auto &roomName : roomNames) {
+        if (!_resourceSvc.models.contains(roomName)) {
+            stage.addJob([this, roomName, &roomModels]() -> LoadPipeline::UploadFunc {
+                auto model = _resourceSvc.models.decode(roomName);
+                return [this, roomName, model, &roomModels]() {
+                    _resourceSvc.models.add(roomName, model);
+                    if (model) {
+                        roomModels.push_back(model);
+                    }
+                };
+            });
+        }
+        if (!_resourceSvc.walkmeshes.contains(roomName)) {
+            stage.addJob([this, roomName]() -> LoadPipeline::UploadFunc {
+                auto walkmesh = _resourceSvc.walkmeshes.decode(roomName, ResType::Wok);
+                return [this, roomName, walkmesh]() {
+                    _resourceSvc.walkmeshes.add(roomName, walkmesh);
+                };
+            });
+        }
+    }
+}
+
+void AreaResourceLoader::resolveTextures(const generated::ARE &are, const std::vector<std::shared_ptr<Model>> &roomModels, LoadPipeline::Stage &stage) {
+    std::map<std::string, TextureUsage> usageByTexture;
+    auto addTexture = [&usageByTexture](const std::string &name, TextureUsage usage) {
+        if (!name.empty()) {
+            usageByTexture.insert(std::make_pair(boost::to_lower_copy(name), usage));
+        }
+    };
+    addTexture(are.Grass_TexName, TextureUsage::MainTex);
+    for (auto &model : roomModels) {
+        std::stack<std::reference_wrapper<ModelNode>> modelNodes;
+        modelNodes.push(*model->rootNode());
+        while (!modelNodes.empty()) {
+            auto &modelNode = modelNodes.top().get();
+            modelNodes.pop();
+            auto mesh = modelNode.mesh();
+            if (mesh) {
+                addTexture(mesh->diffuseMap, TextureUsage::MainTex);
+                addTexture(mesh->lightmap, TextureUsage::Lightmap);
+                addTexture(mesh->bumpmap, TextureUsage::BumpMap);
+            }
+            for (auto &child : modelNode.children()) {
+                modelNodes.push(*child);
+            }
+        }
+    }
+    for (auto &[name, usage] : usageByTexture) {
+        if (_resourceSvc.textures.contains(name)) {
+            continue;
+        }
+        stage.addJob([this, name = name, usage = usage]() -> LoadPipeline::UploadFunc {
+            auto texture = _resourceSvc.textures.decode(name, usage);
+            return [this, name, texture]() {
+                _resourceSvc.textures.add(name, texture);
+            };
+        });
+    }
+}
+
+} // namespace game
+
+} // namespace reone
@@ -80,6 +80,9 @@ namespace reone {
 
 namespace game {
 
+static constexpr int kModuleLoadProgressStart = 10;
+static constexpr int kModuleLoadProgressEnd = 90;
+
 void Game::init() {
     registerConsoleCommands();
     initLocalServices();
@@ -113,6 +116,8 @@ void Game::initLocalServices() {
     routines->init();
     _routines = std::move(routines);
 
+    _services.resource.scripts.enableVerification(*_routines);
+
     _scriptRunner = std::make_unique<ScriptRunner>(*_routines, _services.resource.scripts);
 
     _map = std::make_unique<Map>(*this, _services);
@@ -290,10 +295,8 @@ void Game::loadModule(const std::string &name, std::string entry) {
 
             _services.resource.director.onModuleLoad(name);
 
-            if (_loadScreen) {
-                _loadScreen->setProgress(50);
-            }
-            render();
+            _moduleLoadProgress = -1;
+            reportModuleLoadProgress(0.0f);
 
             _services.scene.graphs.get(kSceneMain).clear();
 
@@ -302,7 +305,6 @@ void Game::loadModule(const std::string &name, std::string entry) {
                 _module = maybeModule->second;
             } else {
                 _module = newModule();
-                _objectById.insert(std::make_pair(_module->id(), _module));
 
                 std::shared_ptr<Gff> ifo(_services.resource.gffs.get("module", ResType::Ifo));
                 if (!ifo) {
@@ -321,10 +323,7 @@ void Game::loadModule(const std::string &name, std::string entry) {
 
             info("Module '" + name + "' loaded successfully");
 
-            if (_loadScreen) {
-                _loadScreen->setProgress(100);
-            }
-            render();
+            setLoadingProgress(100);
 
             std::string musicName(_module->area()->music());
             playMusic(musicName);
@@ -337,13 +336,28 @@ void Game::loadModule(const std::string &name, std::string entry) {
     });
 }
 
+void Game::reportModuleLoadProgress(float progress) {
+    int percent = kModuleLoadProgressStart + static_cast<int>(progress * (kModuleLoadProgressEnd - kModuleLoadProgressStart));
+    if (percent == _moduleLoadProgress) {
+        return;
+    }
+    _moduleLoadProgress = percent;
+    setLoadingProgress(percent);
+}
+
+void Game::setLoadingProgress(int progress) {
+    if (_loadScreen) {
+        _loadScreen->setProgress(progress);
+    }
+    render();
+}
+
 void Game::loadDefaultParty() {
     std::string member1, member2, member3;
     _party.defaultMembers(member1, member2, member3);
 
     if (!member1.empty()) {
         std::shared_ptr<Creature> player = newCreature();
-        _objectById.insert(std::make_pair(player->id(), player));
         player->loadFromBlueprint(member1);
         player->setTag(kObjectTagPlayer);
         player->setImmortal(true);
@@ -352,7 +366,6 @@ void Game::loadDefaultParty() {
     }
     if (!member2.empty()) {
         std::shared_ptr<Creature> companion = newCreature();
-        _objectById.insert(std::make_pair(companion->id(), companion));
         companion->loadFromBlueprint(member2);
         companion->setImmortal(true);
         companion->equip("g_w_dblsbr001");
@@ -360,7 +373,6 @@ void Game::loadDefaultParty() {
     }
     if (!member3.empty()) {
         std::shared_ptr<Creature> companion = newCreature();
-        _objectById.insert(std::make_pair(companion->id(), companion));
         companion->loadFromBlueprint(member3);
         companion->setImmortal(true);
         _party.addMember(1, companion);
@@ -457,10 +469,8 @@ std::shared_ptr<Object> Game::getObjectById(uint32_t id) const {
         throw std::invalid_argument("Invalid id: " + std::to_string(id));
     case kObjectInvalid:
         return nullptr;
-    default: {
-        auto it = _objectById.find(id);
-        return it != _objectById.end() ? it->second : nullptr;
-    }
+    default:
+        return _objects.get(id);
     }
 }
 
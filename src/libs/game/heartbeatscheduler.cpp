@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "reone/game/heartbeatscheduler.h"
+
+#include "reone/system/clock.h"
+
+namespace reone {
+
+namespace game {
+
+static constexpr float kGoldenRatioConjugate = 0.618034f;
+
+void HeartbeatScheduler::add(uint32_t objectId) {
+    auto existing = std::find_if(_entries.begin(), _entries.end(), [&objectId](auto &entry) { return entry.objectId == objectId; });
+    if (existing != _entries.end()) {
+        return;
+    }
+    // Golden ratio sequence keeps phases evenly distributed as objects come and go
+    float phase = glm::fract(++_numAdded * kGoldenRatioConjugate) * _interval;
+    auto it = std::upper_bound(_entries.begin(), _entries.end(), phase, [](float phase, auto &entry) { return phase < entry.phase; });
+    size_t idx = std::distance(_entries.begin(), it);
+    _entries.insert(it, Entry {objectId, phase});
+    if (idx < _next) {
+        ++_next;
+    }
+}
+
+void HeartbeatScheduler::remove(uint32_t objectId) {
+    auto it = std::find_if(_entries.begin(), _entries.end(), [&objectId](auto &entry) { return entry.objectId == objectId; });
+    if (it == _entries.end()) {
+        return;
+    }
+    size_t idx = std::distance(_entries.begin(), it);
+    _entries.erase(it);
+    if (idx < _next) {
+        --_next;
+    }
+    if (_dueIdSet.erase(objectId) > 0) {
+        _dueIds.erase(std::find(_dueIds.begin(), _dueIds.end(), objectId));
+    }
+}
+
+void HeartbeatScheduler::clear() {
+    _entries.clear();
+    _dueIds.clear();
+    _dueIdSet.clear();
+    _time = 0.0f;
+    _next = 0;
+    _numAdded = 0;
+    _frameStats = FrameStats();
+}
+
+void HeartbeatScheduler::update(float dt, const std::function<void(uint32_t)> &run) {
+    _time += dt;
+    while (_time >= _interval) {
+        enqueueDue(_interval);
+        _time -= _interval;
+        _next = 0;
+    }
+    enqueueDue(_time);
+
+    _frameStats = FrameStats();
+    if (_dueIds.empty()) {
+        return;
+    }
+    uint64_t start = _clock.micros();
+    do {
+        uint32_t objectId = _dueIds.front();
+        _dueIds.pop_front();
+        _dueIdSet.erase(objectId);
+        run(objectId);
+        ++_frameStats.numRun;
+    } while (!_dueIds.empty() && _frameStats.numRun < _scriptBudget);
+    _frameStats.numPending = static_cast<int>(_dueIds.size());
+    _frameStats.scriptTime = _clock.micros() - start;
+}
+
+void HeartbeatScheduler::enqueueDue(float until) {
+    for (; _next < _entries.size() && _entries[_next].phase <= until; ++_next) {
+        uint32_t objectId = _entries[_next].objectId;
+        // Heartbeats still pending from the previous cycle are not duplicated
+        if (_dueIdSet.insert(objectId).second) {
+            _dueIds.push_back(objectId);
+        }
+    }
+}
+
+} // namespace game
+
+} // namespace reone
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "reone/game/lineofsightcache.h"
+
+namespace reone {
+
+namespace game {
+
+bool LineOfSightCache::get(uint32_t observerId, const glm::vec3 &observerPosition, uint32_t targetId, const glm::vec3 &targetPosition, bool &outVisible) const {
+    auto maybeEntry = _entries.find(getKey(observerId, targetId));
+    if (maybeEntry == _entries.end()) {
+        return false;
+    }
+    auto &entry = maybeEntry->second;
+    if (glm::distance2(entry.observerPosition, observerPosition) > _epsilon2 ||
+        glm::distance2(entry.targetPosition, targetPosition) > _epsilon2) {
+        return false;
+    }
+    outVisible = entry.visible;
+    return true;
+}
+
+void LineOfSightCache::put(uint32_t observerId, const glm::vec3 &observerPosition, uint32_t targetId, const glm::vec3 &targetPosition, bool visible) {
+    auto &entry = _entries[getKey(observerId, targetId)];
+    entry.observerPosition = observerPosition;
+    entry.targetPosition = targetPosition;
+    entry.visible = visible;
+}
+
+void LineOfSightCache::invalidate() {
+    _entries.clear();
+}
+
+void LineOfSightCache::remove(uint32_t objectId) {
+    for (auto it = _entries.begin(); it != _entries.end();) {
+        auto observerId = static_cast<uint32_t>(it->first >> 32);
+        auto targetId = static_cast<uint32_t>(it->first & 0xffffffff);
+        if (observerId == objectId || targetId == objectId) {
+            it = _entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+} // namespace game
+
+} // namespace reone
@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "reone/game/navmesh.h"
+
+using namespace reone::graphics;
+
+namespace reone {
+
+namespace game {
+
+static constexpr float kVertexQuantum = 1.0f / 128.0f;
+static constexpr float kFunnelEpsilon = 1e-6f;
+
+thread_local NavMesh::Context NavMesh::_context;
+
+static float getSignedArea2(const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &c) {
+    return (b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y);
+}
+
+static uint64_t getEdgeKey(uint32_t a, uint32_t b) {
+    return a < b ? ((static_cast<uint64_t>(a) << 32) | b) : ((static_cast<uint64_t>(b) << 32) | a);
+}
+
+void NavMesh::Context::reset(size_t numFaces) {
+    if (stamps.size() != numFaces) {
+        distances.assign(numFaces, 0.0f);
+        parents.assign(numFaces, -1);
+        stamps.assign(numFaces, 0);
+        stamp = 0;
+    }
+    open.clear();
+    corridor.clear();
+    portals.clear();
+
+    // Stamp overflow would make stale state look current
+    if (++stamp == 0) {
+        std::fill(stamps.begin(), stamps.end(), 0);
+        stamp = 1;
+    }
+}
+
+void NavMesh::add(const Walkmesh &walkmesh, const std::set<uint32_t> &walkableSurfaces) {
+    for (auto &walkmeshFace : walkmesh.faces()) {
+        if (walkableSurfaces.count(walkmeshFace.material) == 0) {
+            continue;
+        }
+        auto &v0 = walkmeshFace.vertices[0];
+        auto &v1 = walkmeshFace.vertices[1];
+        auto &v2 = walkmeshFace.vertices[2];
+        float area2 = getSignedArea2(v0, v1, v2);
+        if (glm::abs(area2) < kFunnelEpsilon) {
+            continue;
+        }
+        Face face;
+        face.vertices[0] = addVertex(v0);
+        if (area2 > 0.0f) {
+            face.vertices[1] = addVertex(v1);
+            face.vertices[2] = addVertex(v2);
+        } else {
+            face.vertices[1] = addVertex(v2);
+            face.vertices[2] = addVertex(v1);
+        }
+        face.centroid = (v0 + v1 + v2) / 3.0f;
+        _faces.push_back(std::move(face));
+    }
+}
+
+uint32_t NavMesh::addVertex(const glm::vec3 &vertex) {
+    // Pack quantized coordinates into 21 bits each
+    auto quantize = [](float value) {
+        return static_cast<uint64_t>(static_cast<int64_t>(glm::round(value / kVertexQuantum)) + (1 << 20)) & 0x1fffff;
+    };
+    uint64_t key = (quantize(vertex.x) << 42) | (quantize(vertex.y) << 21) | quantize(vertex.z);
+    auto maybeVertex = _vertexByKey.find(key);
+    if (maybeVertex != _vertexByKey.end()) {
+        return maybeVertex->second;
+    }
+    auto index = static_cast<uint32_t>(_vertices.size());
+    _vertices.push_back(vertex);
+    _vertexByKey[key] = index;
+    return index;
+}
+
+void NavMesh::build() {
+    std::unordered_map<uint64_t, std::pair<int, int>> faceEdgeByKey;
+    _faceGrid.clear();
+
+    for (int faceIdx = 0; faceIdx < static_cast<int>(_faces.size()); ++faceIdx) {
+        auto &face = _faces[faceIdx];
+        for (int edge = 0; edge < 3; ++edge) {
+            auto key = getEdgeKey(face.vertices[edge], face.vertices[(edge + 1) % 3]);
+            auto maybeOther = faceEdgeByKey.find(key);
+            if (maybeOther == faceEdgeByKey.end()) {
+                faceEdgeByKey[key] = std::make_pair(faceIdx, edge);
+                continue;
+            }
+            // Only two faces can share an edge
+            auto [otherFaceIdx, otherEdge] = maybeOther->second;
+            if (otherFaceIdx != -1 && _faces[otherFaceIdx].neighbours[otherEdge] == -1) {
+                _faces[otherFaceIdx].neighbours[otherEdge] = faceIdx;
+                face.neighbours[edge] = otherFaceIdx;
+                maybeOther->second.first = -1;
+            }
+        }
+        float radius = 0.0f;
+        for (auto &vertexIdx : face.vertices) {
+            radius = std::max(radius, glm::distance(glm::vec2(_vertices[vertexIdx]), glm::vec2(face.centroid)));
+        }
+        _faceGrid.add(faceIdx, faceIdx, face.centroid, radius);
+    }
+    _vertexByKey.clear();
+}
+
+int NavMesh::findFace(const glm::vec3 &point) const {
+    int result = -1;
+    float minDistanceZ = std::numeric_limits<float>::max();
+    _faceGrid.forEachInRadius(point, 0.0f, [this, &point, &result, &minDistanceZ](int faceIdx, auto &) {
+        auto &face = _faces[faceIdx];
+        auto &v0 = _vertices[face.vertices[0]];
+        auto &v1 = _vertices[face.vertices[1]];
+        auto &v2 = _vertices[face.vertices[2]];
+        if (getSignedArea2(v0, v1, point) < 0.0f ||
+            getSignedArea2(v1, v2, point) < 0.0f ||
+            getSignedArea2(v2, v0, point) < 0.0f) {
+            return;
+        }
+        // Interpolate elevation at point
+        float area2 = getSignedArea2(v0, v1, v2);
+        float z = (getSignedArea2(v1, v2, point) * v0.z + getSignedArea2(v2, v0, point) * v1.z + getSignedArea2(v0, v1, point) * v2.z) / area2;
+        float distanceZ = glm::abs(point.z - z);
+        if (distanceZ < minDistanceZ) {
+            result = faceIdx;
+            minDistanceZ = distanceZ;
+        }
+    });
+    return result;
+}
+
+bool NavMesh::findPath(const glm::vec3 &from, const glm::vec3 &to, std::vector<glm::vec3> &outPoints) const {
+    int fromFace = findFace(from);
+    int toFace = findFace(to);
+    if (fromFace == -1 || toFace == -1) {
+        return false;
+    }
+    Context &ctx = _context;
+    ctx.reset(_faces.size());
+    if (!findCorridor(fromFace, toFace, to, ctx)) {
+        return false;
+    }
+    for (size_t i = 0; i + 1 < ctx.corridor.size(); ++i) {
+        Portal portal;
+        getPortal(ctx.corridor[i], ctx.corridor[i + 1], portal);
+        ctx.portals.push_back(std::move(portal));
+    }
+    pullString(from, to, ctx.portals, outPoints);
+    return true;
+}
+
+bool NavMesh::findCorridor(int fromFace, int toFace, const glm::vec3 &to, Context &ctx) const {
+    // A* over faces, with open list as a binary heap that allows duplicates
+    auto compareCost = [](auto &left, auto &right) { return left.first > right.first; };
+    ctx.stamps[fromFace] = ctx.stamp;
+    ctx.distances[fromFace] = 0.0f;
+    ctx.parents[fromFace] = -1;
+    ctx.open.push_back(std::make_pair(glm::distance(_faces[fromFace].centroid, to), fromFace));
+
+    while (!ctx.open.empty()) {
+        std::pop_heap(ctx.open.begin(), ctx.open.end(), compareCost);
+        auto [totalCost, current] = ctx.open.back();
+        ctx.open.pop_back();
+
+        if (current == toFace) {
+            for (int faceIdx = current; faceIdx != -1; faceIdx = ctx.parents[faceIdx]) {
+                ctx.corridor.push_back(faceIdx);
+            }
+            std::reverse(ctx.corridor.begin(), ctx.corridor.end());
+            return true;
+        }
+
+        // Skip stale heap entries
+        auto &face = _faces[current];
+        float heuristic = glm::distance(face.centroid, to);
+        if (totalCost > ctx.distances[current] + heuristic) {
+            continue;
+        }
+
+        for (auto &neighbour : face.neighbours) {
+            if (neighbour == -1) {
+                continue;
+            }
+            float distance = ctx.distances[current] + glm::distance(face.centroid, _faces[neighbour].centroid);
+            if (ctx.stamps[neighbour] == ctx.stamp && distance >= ctx.distances[neighbour]) {
+                continue;
+            }
+            ctx.stamps[neighbour] = ctx.stamp;
+            ctx.distances[neighbour] = distance;
+            ctx.parents[neighbour] = current;
+            ctx.open.push_back(std::make_pair(distance + glm::distance(_faces[neighbour].centroid, to), neighbour));
+            std::push_heap(ctx.open.begin(), ctx.open.end(), compareCost);
+        }
+    }
+
+    return false;
+}
+
+void NavMesh::getPortal(int faceIdx, int nextFaceIdx, Portal &outPortal) const {
+    auto &face = _faces[faceIdx];
+    for (int edge = 0; edge < 3; ++edge) {
+        if (face.neighbours[edge] == nextFaceIdx) {
+            // Faces are counter-clockwise: when leaving through an edge, its end is on the left
+            outPortal.right = _vertices[face.vertices[edge]];
+            outPortal.left = _vertices[face.vertices[(edge + 1) % 3]];
+            return;
+        }
+    }
+}
+
+void NavMesh::pullString(const glm::vec3 &from, const glm::vec3 &to, const std::vector<Portal> &portals, std::vector<glm::vec3> &outPoints) const {
+    outPoints.clear();
+    outPoints.push_back(from);
+
+    glm::vec3 apex(from);
+    glm::vec3 left(from);
+    glm::vec3 right(from);
+    int apexIdx = 0;
+    int leftIdx = 0;
+    int rightIdx = 0;
+
+    int numPortals = static_cast<int>(portals.size());
+    for (int i = 0; i <= numPortals; ++i) {
+        // Destination is the last, degenerate, portal
+        auto &portalLeft = i < numPortals ? portals[i].left : to;
+        auto &portalRight = i < numPortals ? portals[i].right : to;
+
+        // Try to narrow the funnel from the right
+        if (getSignedArea2(apex, right, portalRight) >= 0.0f) {
+            if (apex == right || apex == left || getSignedArea2(apex, left, portalRight) < 0.0f) {
+                right = portalRight;
+                rightIdx = i + 1;
+            } else {
+                // Right side crossed the left one: left becomes a new apex
+                apex = left;
+                apexIdx = leftIdx;
+                outPoints.push_back(apex);
+                right = apex;
+                rightIdx = apexIdx;
+                i = apexIdx - 1;
+                continue;
+            }
+        }
+
+        // Try to narrow the funnel from the left
+        if (getSignedArea2(apex, left, portalLeft) <= 0.0f) {
+            if (apex == left || apex == right || getSignedArea2(apex, right, portalLeft) > 0.0f) {
+                left = portalLeft;
+                leftIdx = i + 1;
+            } else {
+                // Left side crossed the right one: right becomes a new apex
+                apex = right;
+                apexIdx = rightIdx;
+                outPoints.push_back(apex);
+                left = apex;
+                leftIdx = apexIdx;
+                i = apexIdx - 1;
+                continue;
+            }
+        }
+    }
+
+    if (outPoints.back() != to) {
+        outPoints.push_back(to);
+    }
+}
+
+} // namespace game
+
+} // namespace reone
@@ -20,6 +20,7 @@
 #include "reone/game/di/services.h"
 #include "reone/game/game.h"
 #include "reone/game/object/item.h"
+#include "reone/game/objectupdatelist.h"
 #include "reone/game/room.h"
 #include "reone/system/logutil.h"
 
@@ -41,9 +42,53 @@ void Object::update(float dt) {
     if (!_dead) {
         executeActions(dt);
     }
+    updatePickable();
+}
+
+void Object::updatePickable() {
+    if (!_selectableDirty && _pickableSceneNode == _sceneNode.get()) {
+        return;
+    }
     if (_sceneNode && _sceneNode->type() == SceneNodeType::Model) {
         std::static_pointer_cast<ModelSceneNode>(_sceneNode)->setPickable(isSelectable());
     }
+    _selectableDirty = false;
+    _pickableSceneNode = _sceneNode.get();
+}
+
+bool Object::isIdle() const {
+    return _actions.empty() &&
+           _delayed.empty() &&
+           _numTemporaryEffects == 0 &&
+           !_selectableDirty &&
+           _pickableSceneNode == _sceneNode.get();
+}
+
+void Object::setUpdateList(ObjectUpdateList *list) {
+    if (_updateList == list) {
+        return;
+    }
+    if (_updateList && _awake) {
+        _updateList->remove(*this);
+    }
+    _updateList = list;
+    _awake = false;
+}
+
+void Object::wake() {
+    if (_awake || !_updateList) {
+        return;
+    }
+    _updateList->add(*this);
+    _awake = true;
+}
+
+bool Object::sleep() {
+    if (!isIdle()) {
+        return false;
+    }
+    _awake = false;
+    return true;
 }
 
 bool Object::getLocalBoolean(int index) const {
@@ -72,17 +117,20 @@ void Object::clearAllActions() {
 
 void Object::addAction(std::shared_ptr<Action> action) {
     _actions.push_back(std::move(action));
+    wake();
 }
 
 void Object::addActionOnTop(std::shared_ptr<Action> action) {
     _actions.push_front(std::move(action));
+    wake();
 }
 
 void Object::delayAction(std::shared_ptr<Action> action, float seconds) {
     DelayedAction delayed;
     delayed.action = std::move(action);
-    delayed.timer = std::make_unique<Timer>(seconds);
+    delayed.timeLeft = seconds;
     _delayed.push_back(std::move(delayed));
+    wake();
 }
 
 void Object::updateActions(float dt) {
@@ -101,16 +149,19 @@ void Object::removeCompletedActions() {
 }
 
 void Object::updateDelayedActions(float dt) {
+    if (_delayed.empty()) {
+        return;
+    }
     for (auto &delayed : _delayed) {
-        delayed.timer->update(dt);
-        if (delayed.timer->elapsed()) {
+        delayed.timeLeft = std::max(0.0f, delayed.timeLeft - dt);
+        if (delayed.timeLeft == 0.0f) {
             _actions.push_back(std::move(delayed.action));
         }
     }
     auto delayedToRemove = std::remove_if(
         _delayed.begin(),
         _delayed.end(),
-        [](const DelayedAction &delayed) { return delayed.timer->elapsed(); });
+        [](const DelayedAction &delayed) { return delayed.timeLeft == 0.0f; });
 
     _delayed.erase(delayedToRemove, _delayed.end());
 }
@@ -155,6 +206,7 @@ std::shared_ptr<Item> Object::addItem(const std::string &resRef, int stackSize,
 
         _items.push_back(result);
     }
+    invalidateSelectable();
 
     return result;
 }
@@ -166,6 +218,7 @@ void Object::addItem(const std::shared_ptr<Item> &item) {
     } else {
         _items.push_back(item);
     }
+    invalidateSelectable();
 }
 
 bool Object::removeItem(const std::shared_ptr<Item> &item, bool &last) {
@@ -181,6 +234,7 @@ bool Object::removeItem(const std::shared_ptr<Item> &item, bool &last) {
     } else {
         last = true;
         _items.erase(maybeItem);
+        invalidateSelectable();
     }
 
     return true;
@@ -252,6 +306,8 @@ void Object::moveDropableItemsTo(Object &other) {
             ++it;
         }
     }
+    invalidateSelectable();
+    other.invalidateSelectable();
 }
 
 void Object::applyEffect(const std::shared_ptr<Effect> &effect, DurationType durationType, float duration) {
@@ -263,6 +319,10 @@ void Object::applyEffect(const std::shared_ptr<Effect> &effect, DurationType dur
         appliedEffect.durationType = durationType;
         appliedEffect.duration = duration;
         _effects.push_back(std::move(appliedEffect));
+        if (durationType == DurationType::Temporary) {
+            ++_numTemporaryEffects;
+            wake();
+        }
     }
 }
 
@@ -271,6 +331,9 @@ void Object::applyInstantEffect(Effect &effect) {
 }
 
 void Object::updateEffects(float dt) {
+    if (_numTemporaryEffects == 0) {
+        return;
+    }
     for (auto it = _effects.begin(); it != _effects.end();) {
         AppliedEffect &effect = *it;
         bool temporary = effect.durationType == DurationType::Temporary;
@@ -280,6 +343,7 @@ void Object::updateEffects(float dt) {
         if (temporary && effect.duration == 0.0f) {
             applyInstantEffect(*effect.effect);
             it = _effects.erase(it);
+            --_numTemporaryEffects;
         } else {
             ++it;
         }
@@ -312,6 +376,10 @@ void Object::setRoom(Room *room) {
 void Object::setPosition(const glm::vec3 &position) {
     _position = position;
     updateTransform();
+
+    if (_grid) {
+        _grid->move(_id, _position);
+    }
 }
 
 void Object::updateTransform() {
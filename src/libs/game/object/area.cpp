@@ -17,6 +17,7 @@
 
 #include "reone/game/object/area.h"
 
+#include "reone/game/arearesourceloader.h"
 #include "reone/game/camerastyles.h"
 #include "reone/game/di/services.h"
 #include "reone/game/game.h"
@@ -29,6 +30,8 @@
 #include "reone/game/types.h"
 #include "reone/graphics/di/services.h"
 #include "reone/graphics/mesh.h"
+#include "reone/graphics/model.h"
+#include "reone/graphics/modelnode.h"
 #include "reone/graphics/meshregistry.h"
 #include "reone/graphics/walkmesh.h"
 #include "reone/resource/2da.h"
@@ -54,6 +57,7 @@
 #include "reone/scene/node/trigger.h"
 #include "reone/scene/node/walkmesh.h"
 #include "reone/scene/types.h"
+#include "reone/system/clock.h"
 #include "reone/system/logutil.h"
 #include "reone/system/randomutil.h"
 
@@ -79,6 +83,23 @@ static constexpr float kMaxCollisionDistance2 = kMaxCollisionDistance * kMaxColl
 static glm::vec3 g_defaultAmbientColor {0.2f};
 static CameraStyle g_defaultCameraStyle {"", 3.2f, 83.0f, 0.45f, 55.0f};
 
+static CollisionQuery makeLineOfSightQuery(const Object &subject, const Object &object) {
+    CollisionQuery query;
+    query.origin = subject.position();
+    query.origin.z += kLineOfSightHeight;
+    query.dest = object.position();
+    query.dest.z += kLineOfSightHeight;
+    return query;
+}
+
+static bool isLineOfSightClear(const Object &subject, const Object &object, const CollisionQuery &query) {
+    if (!query.result) {
+        return true;
+    }
+    return query.collision.user == &object ||
+           subject.getSquareDistanceTo(object) < glm::distance2(query.origin, query.collision.intersection);
+}
+
 Area::Area(
     uint32_t id,
     std::string sceneName,
@@ -90,10 +111,25 @@ Area::Area(
         "",
         game,
         services),
-    _sceneName(std::move(sceneName)) {
+    _sceneName(std::move(sceneName)),
+    _pathfinder(std::make_shared<Pathfinder>()),
+    _pathRequests(services.system.threadPool),
+    _heartbeatScheduler(services.system.clock, kHeartbeatInterval) {
 
     init();
-    _heartbeatTimer.reset(kHeartbeatInterval);
+}
+
+Area::~Area() {
+    // Objects may outlive this area, e.g. party members
+    for (auto &object : _objects) {
+        object->setGrid(nullptr);
+        object->setUpdateList(nullptr);
+        if (object->type() == ObjectType::Trigger) {
+            static_cast<Trigger &>(*object).setTriggerGrid(nullptr);
+        } else if (object->type() == ObjectType::Door) {
+            static_cast<Door &>(*object).setLineOfSightCache(nullptr);
+        }
+    }
 }
 
 void Area::init() {
@@ -118,11 +154,16 @@ void Area::load(std::string name, const Gff &are, const Gff &git, bool fromSave)
     auto areParsed = resource::generated::parseARE(are);
     auto gitParsed = resource::generated::parseGIT(git);
 
+    loadResources(areParsed, gitParsed);
+
     loadARE(areParsed);
     loadGIT(gitParsed);
     loadLYT();
     loadVIS();
     loadPTH();
+    loadNavMesh();
+
+    _pathRequests.init(_pathfinder, _navMesh);
 }
 
 void Area::loadARE(const resource::generated::ARE &are) {
@@ -168,6 +209,10 @@ void Area::loadScripts(const resource::generated::ARE &are) {
     _onExit = are.OnExit;
     _onHeartbeat = are.OnHeartbeat;
     _onUserDefined = are.OnUserDefined;
+
+    if (!_onHeartbeat.empty()) {
+        _heartbeatScheduler.add(_id);
+    }
 }
 
 void Area::loadMap(const resource::generated::ARE &are) {
@@ -307,6 +352,7 @@ void Area::loadLYT() {
     if (!layout) {
         throw ResourceNotFoundException("Area LYT not found: " + _name);
     }
+
     auto &sceneGraph = _services.scene.graphs.get(_sceneName);
     for (auto &lytRoom : layout->rooms) {
         auto model = _services.resource.models.get(lytRoom.name);
@@ -375,6 +421,22 @@ void Area::loadLYT() {
     }
 }
 
+void Area::loadResources(const resource::generated::ARE &are, const resource::generated::GIT &git) {
+    _services.resource.resources.prefetch(
+        std::vector<ResourceId> {ResourceId(_name, ResType::Vis), ResourceId(_name, ResType::Pth)},
+        _services.system.threadPool);
+
+    auto loader = AreaResourceLoader(_services.resource, _services.system.threadPool);
+    loader.load(_name, are, git, [this](float progress) {
+        _game.reportModuleLoadProgress(progress);
+    });
+
+    for (auto &timings : loader.timings()) {
+        debug(str(boost::format("Area '%s' loaded %s: %d jobs, resolve %.1f ms, decode %.1f ms, upload %.1f ms") %
+                  _name % timings.name % timings.numJobs % timings.resolveMs % timings.decodeMs % timings.uploadMs));
+    }
+}
+
 void Area::loadVIS() {
     auto visibility = _services.resource.visibilities.get(_name);
     if (!visibility) {
@@ -401,17 +463,40 @@ void Area::loadPTH() {
 
     auto &sceneGraph = _services.scene.graphs.get(_sceneName);
 
+    std::vector<CollisionQuery> queries(path->points.size());
     for (size_t i = 0; i < path->points.size(); ++i) {
-        const Path::Point &point = path->points[i];
-        Collision collision;
-        if (!sceneGraph.testElevation(glm::vec2(point.x, point.y), collision)) {
+        queries[i].origin = glm::vec3(path->points[i].x, path->points[i].y, 0.0f);
+    }
+    sceneGraph.testElevationBatch(queries, &_services.system.threadPool);
+
+    for (size_t i = 0; i < queries.size(); ++i) {
+        if (!queries[i].result) {
             warn(str(boost::format("Point %d elevation not found") % i));
             continue;
         }
-        pointZ.insert(std::make_pair(static_cast<int>(i), collision.intersection.z));
+        pointZ.insert(std::make_pair(static_cast<int>(i), queries[i].collision.intersection.z));
     }
 
-    _pathfinder.load(path->points, pointZ);
+    _pathfinder->load(path->points, pointZ);
+}
+
+void Area::loadNavMesh() {
+    if (!_game.options().game.navmesh) {
+        return;
+    }
+    auto navMesh = std::make_shared<NavMesh>();
+    auto walkable = _services.game.surfaces.getWalkableSurfaces();
+    for (auto &room : _rooms) {
+        auto walkmesh = room.second->walkmesh();
+        if (walkmesh) {
+            navMesh->add(walkmesh->walkmesh(), walkable);
+        }
+    }
+    navMesh->build();
+    if (navMesh->numFaces() == 0) {
+        return;
+    }
+    _navMesh = std::move(navMesh);
 }
 
 void Area::initCameras(const glm::vec3 &entryPosition, float entryFacing) {
@@ -442,8 +527,24 @@ void Area::add(const std::shared_ptr<Object> &object) {
     _objectsByType[object->type()].push_back(object);
     _objectsByTag[object->tag()].push_back(object);
 
+    _objectGrid.add(object->id(), object, object->position());
+    object->setGrid(&_objectGrid);
+    object->setUpdateList(&_updateList);
+    object->wake();
+    if (object->type() == ObjectType::Trigger) {
+        auto trigger = std::static_pointer_cast<Trigger>(object);
+        _triggerGrid.add(trigger->id(), trigger, trigger->position(), trigger->getBoundingRadius());
+        trigger->setTriggerGrid(&_triggerGrid);
+    } else if (object->type() == ObjectType::Door) {
+        static_cast<Door &>(*object).setLineOfSightCache(&_lineOfSightCache);
+    }
+
     determineObjectRoom(*object);
 
+    if (!object->getOnHeartbeat().empty()) {
+        _heartbeatScheduler.add(object->id());
+    }
+
     auto &sceneGraph = _services.scene.graphs.get(_sceneName);
     auto sceneNode = object->sceneNode();
     if (sceneNode) {
@@ -460,6 +561,7 @@ void Area::add(const std::shared_ptr<Object> &object) {
         auto walkmesh = placeable->walkmesh();
         if (walkmesh) {
             sceneGraph.addRoot(walkmesh);
+            invalidateLineOfSight();
         }
     } else if (object->type() == ObjectType::Door) {
         auto door = std::static_pointer_cast<Door>(object);
@@ -475,6 +577,7 @@ void Area::add(const std::shared_ptr<Object> &object) {
         if (walkmeshOpen2) {
             sceneGraph.addRoot(walkmeshOpen2);
         }
+        invalidateLineOfSight();
     }
 }
 
@@ -506,6 +609,17 @@ void Area::doDestroyObject(uint32_t objectId) {
     if (room) {
         room->removeTenant(object.get());
     }
+    object->setGrid(nullptr);
+    object->setUpdateList(nullptr);
+    if (object->type() == ObjectType::Trigger) {
+        static_cast<Trigger &>(*object).setTriggerGrid(nullptr);
+    } else if (object->type() == ObjectType::Door) {
+        static_cast<Door &>(*object).setLineOfSightCache(nullptr);
+    }
+    _objectGrid.remove(object->id());
+    _triggerGrid.remove(object->id());
+    _lineOfSightCache.remove(object->id());
+    _heartbeatScheduler.remove(object->id());
 
     auto &sceneGraph = _services.scene.graphs.get(_sceneName);
     auto sceneNode = object->sceneNode();
@@ -523,6 +637,7 @@ void Area::doDestroyObject(uint32_t objectId) {
         auto walkmesh = placeable->walkmesh();
         if (walkmesh) {
             sceneGraph.removeRoot(*walkmesh);
+            invalidateLineOfSight();
         }
     } else if (object->type() == ObjectType::Door) {
         auto door = std::static_pointer_cast<Door>(object);
@@ -538,6 +653,7 @@ void Area::doDestroyObject(uint32_t objectId) {
         if (walkmeshClosed) {
             sceneGraph.removeRoot(*walkmeshClosed);
         }
+        invalidateLineOfSight();
     }
 
     auto maybeObject = std::find_if(_objects.begin(), _objects.end(), [&object](auto &o) { return o.get() == object.get(); });
@@ -647,11 +763,24 @@ void Area::update(float dt) {
     }
     Object::update(dt);
 
-    for (auto &object : _objects) {
-        object->update(dt);
-    }
+    applySolvedPaths();
+
+    _updateList.update(dt);
     updatePerception(dt);
     updateHeartbeat(dt);
+
+    // Paths requested during this frame are solved in the background
+    _pathRequests.flush();
+}
+
+void Area::applySolvedPaths() {
+    uint32_t now = _services.system.clock.millis();
+    _pathRequests.collect([this, &now](auto &result) {
+        auto creature = _game.getObjectById<Creature>(result.requesterId);
+        if (creature) {
+            creature->setPath(result.destination, std::move(result.points), now);
+        }
+    });
 }
 
 bool Area::moveCreature(const std::shared_ptr<Creature> &creature, const glm::vec2 &dir, bool run, float dt) {
@@ -721,24 +850,14 @@ bool Area::moveCreatureTowards(const std::shared_ptr<Creature> &creature, const
 }
 
 bool Area::isObjectSeen(const Creature &subject, const Object &object) const {
-    if (!subject.isInLineOfSight(object, kLineOfSightFOV)) {
-        return false;
-    }
-    auto &sceneGraph = _services.scene.graphs.get(_sceneName);
-
-    glm::vec3 origin(subject.position());
-    origin.z += kLineOfSightHeight;
-
-    glm::vec3 dest(object.position());
-    dest.z += kLineOfSightHeight;
-
-    Collision collision;
-    if (sceneGraph.testLineOfSight(origin, dest, collision)) {
-        return collision.user == &object ||
-               subject.getSquareDistanceTo(object) < glm::distance2(origin, collision.intersection);
-    }
+    return subject.isInLineOfSight(object, kLineOfSightFOV) && testLineOfSight(subject, object);
+}
 
-    return true;
+bool Area::testLineOfSight(const Object &subject, const Object &object) const {
+    auto &sceneGraph = _services.scene.graphs.get(_sceneName);
+    auto query = makeLineOfSightQuery(subject, object);
+    query.result = sceneGraph.testLineOfSight(query.origin, query.dest, query.collision);
+    return isLineOfSightClear(subject, object, query);
 }
 
 void Area::runSpawnScripts() {
@@ -867,7 +986,13 @@ void Area::updateVisibility() {
 void Area::checkTriggersIntersection(const std::shared_ptr<Object> &triggerrer) {
     glm::vec2 position2d(triggerrer->position());
 
-    for (auto &object : _objectsByType[ObjectType::Trigger]) {
+    // Trigger scripts may add or move objects, so collect candidates first
+    ObjectList candidates;
+    _triggerGrid.forEachInRadius(triggerrer->position(), 0.0f, [&candidates](auto &trigger, auto &) {
+        candidates.push_back(trigger);
+    });
+
+    for (auto &object : candidates) {
         auto trigger = std::static_pointer_cast<Trigger>(object);
         if (trigger->isTenant(triggerrer) || !trigger->isIn(position2d)) {
             continue;
@@ -886,18 +1011,19 @@ void Area::checkTriggersIntersection(const std::shared_ptr<Object> &triggerrer)
 }
 
 void Area::updateHeartbeat(float dt) {
-    _heartbeatTimer.update(dt);
-    if (_heartbeatTimer.elapsed()) {
-        if (!_onHeartbeat.empty()) {
+    _heartbeatScheduler.update(dt, [this](uint32_t objectId) {
+        if (objectId == _id) {
             _game.scriptRunner().run(_onHeartbeat, _id);
+            return;
         }
-        for (auto &object : _objects) {
-            std::string heartbeat(object->getOnHeartbeat());
-            if (!heartbeat.empty()) {
-                _game.scriptRunner().run(heartbeat, object->id());
-            }
+        auto object = _game.getObjectById(objectId);
+        if (object) {
+            _game.scriptRunner().run(object->getOnHeartbeat(), objectId);
         }
-        _heartbeatTimer.reset(kHeartbeatInterval);
+    });
+    auto &stats = _heartbeatScheduler.frameStats();
+    if (stats.numRun > 0 && Logger::instance.isChannelEnabled(LogChannel::Script2)) {
+        debug(str(boost::format("Heartbeats: %d run, %d pending, %.2f ms") % stats.numRun % stats.numPending % (stats.scriptTime / 1000.0f)), LogChannel::Script2);
     }
 }
 
@@ -1041,14 +1167,7 @@ void Area::selectObject(std::shared_ptr<Object> object) {
 }
 
 std::shared_ptr<Object> Area::getNearestObject(const glm::vec3 &origin, int nth, const std::function<bool(const std::shared_ptr<Object> &)> &predicate) {
-    std::vector<std::pair<std::shared_ptr<Object>, float>> candidates;
-
-    for (auto &object : _objects) {
-        if (predicate(object)) {
-            candidates.push_back(std::make_pair(object, object->getSquareDistanceTo(origin)));
-        }
-    }
-    sort(candidates.begin(), candidates.end(), [](auto &left, auto &right) { return left.second < right.second; });
+    auto candidates = _objectGrid.findNearest(origin, nth + 1, predicate);
 
     int candidateCount = static_cast<int>(candidates.size());
     if (nth >= candidateCount) {
@@ -1060,21 +1179,11 @@ std::shared_ptr<Object> Area::getNearestObject(const glm::vec3 &origin, int nth,
 }
 
 std::shared_ptr<Creature> Area::getNearestCreature(const std::shared_ptr<Object> &target, const SearchCriteriaList &criterias, int nth) {
-    std::vector<std::pair<std::shared_ptr<Creature>, float>> candidates;
-
-    for (auto &object : getObjectsByType(ObjectType::Creature)) {
-        auto creature = std::static_pointer_cast<Creature>(object);
-        if (matchesCriterias(*creature, criterias, target)) {
-            float distance2 = creature->getSquareDistanceTo(*target);
-            candidates.push_back(std::make_pair(std::move(creature), distance2));
-        }
-    }
-
-    sort(candidates.begin(), candidates.end(), [](auto &left, auto &right) {
-        return left.second < right.second;
+    auto candidates = _objectGrid.findNearest(target->position(), nth + 1, [&](auto &object) {
+        return object->type() == ObjectType::Creature && matchesCriterias(static_cast<const Creature &>(*object), criterias, target);
     });
 
-    return nth < candidates.size() ? candidates[nth].first : nullptr;
+    return nth < candidates.size() ? std::static_pointer_cast<Creature>(candidates[nth].first) : nullptr;
 }
 
 bool Area::matchesCriterias(const Creature &creature, const SearchCriteriaList &criterias, std::shared_ptr<Object> target) const {
@@ -1150,80 +1259,152 @@ bool Area::matchesCriterias(const Creature &creature, const SearchCriteriaList &
 }
 
 std::shared_ptr<Creature> Area::getNearestCreatureToLocation(const Location &location, const SearchCriteriaList &criterias, int nth) {
-    std::vector<std::pair<std::shared_ptr<Creature>, float>> candidates;
-
-    for (auto &object : getObjectsByType(ObjectType::Creature)) {
-        auto creature = std::static_pointer_cast<Creature>(object);
-        if (matchesCriterias(*creature, criterias)) {
-            float distance2 = creature->getSquareDistanceTo(location.position());
-            candidates.push_back(std::make_pair(std::move(creature), distance2));
-        }
-    }
-
-    std::sort(candidates.begin(), candidates.end(), [](auto &left, auto &right) {
-        return left.second < right.second;
+    auto candidates = _objectGrid.findNearest(location.position(), nth + 1, [&](auto &object) {
+        return object->type() == ObjectType::Creature && matchesCriterias(static_cast<const Creature &>(*object), criterias);
     });
 
-    return nth < candidates.size() ? candidates[nth].first : nullptr;
+    return nth < candidates.size() ? std::static_pointer_cast<Creature>(candidates[nth].first) : nullptr;
 }
 
 void Area::updatePerception(float dt) {
     _perceptionTimer.update(dt);
-    if (_perceptionTimer.elapsed()) {
-        doUpdatePerception();
+    if (_perceptionScheduler.isIdle()) {
+        if (!_perceptionTimer.elapsed()) {
+            return;
+        }
+        schedulePerception();
         _perceptionTimer.reset(kUpdatePerceptionInterval);
     }
+    _perceptionScheduler.update([this](uint32_t creatureId) {
+        return updateCreaturePerception(creatureId);
+    });
 }
 
-void Area::doUpdatePerception() {
-    // For each creature, determine a list of creatures it sees
-    ObjectList &creatures = getObjectsByType(ObjectType::Creature);
-    for (auto &object : creatures) {
+void Area::invalidateLineOfSight() {
+    _lineOfSightCache.invalidate();
+}
+
+void Area::schedulePerception() {
+    // Party members are evaluated first, followed by their enemies
+    auto &party = _game.party();
+    auto leader = party.getLeader();
+    std::vector<uint32_t> creatureIds;
+    std::vector<uint32_t> enemyIds;
+    std::vector<uint32_t> otherIds;
+    for (auto &object : getObjectsByType(ObjectType::Creature)) {
         // Skip dead creatures
         if (object->isDead())
             continue;
 
-        auto creature = std::static_pointer_cast<Creature>(object);
-        float hearingRange2 = creature->perception().hearingRange * creature->perception().hearingRange;
-        float sightRange2 = creature->perception().sightRange * creature->perception().sightRange;
+        auto &creature = static_cast<Creature &>(*object);
+        if (party.isMember(creature)) {
+            creatureIds.push_back(creature.id());
+        } else if (leader && _services.game.reputes.getIsEnemy(creature, *leader)) {
+            enemyIds.push_back(creature.id());
+        } else {
+            otherIds.push_back(creature.id());
+        }
+    }
+    creatureIds.insert(creatureIds.end(), enemyIds.begin(), enemyIds.end());
+    creatureIds.insert(creatureIds.end(), otherIds.begin(), otherIds.end());
 
-        for (auto &other : creatures) {
-            // Skip self
-            if (other == object)
-                continue;
+    _perceptionScheduler.schedule(std::move(creatureIds));
+}
 
-            bool heard = false;
-            bool seen = false;
+int Area::updateCreaturePerception(uint32_t creatureId) {
+    // Creature might have died or left the area since perception was scheduled
+    if (!_objectGrid.contains(creatureId)) {
+        return 0;
+    }
+    auto object = _game.getObjectById(creatureId);
+    if (!object || object->isDead()) {
+        return 0;
+    }
+    int rays = 0;
 
-            float distance2 = creature->getSquareDistanceTo(*other);
-            if (distance2 <= hearingRange2) {
-                heard = true;
-            }
-            if (distance2 <= sightRange2) {
-                seen = isObjectSeen(*creature, *other);
-            }
+    // Determine a list of creatures this creature sees and hears
+    auto creature = std::static_pointer_cast<Creature>(object);
+    float hearingRange2 = creature->perception().hearingRange * creature->perception().hearingRange;
+    float sightRange2 = creature->perception().sightRange * creature->perception().sightRange;
 
-            // Hearing
-            bool wasHeard = creature->perception().heard.count(other) > 0;
-            if (!wasHeard && heard) {
-                debug(str(boost::format("%s heard by %s") % other->tag() % creature->tag()), LogChannel::Perception);
-                creature->onObjectHeard(other);
-            } else if (wasHeard && !heard) {
-                debug(str(boost::format("%s inaudible to %s") % other->tag() % creature->tag()), LogChannel::Perception);
-                creature->onObjectInaudible(other);
+    // Only creatures within perception range, and those perceived before, may change perception state
+    ObjectList others;
+    float range = std::max(creature->perception().hearingRange, creature->perception().sightRange);
+    _objectGrid.forEachInRadius(creature->position(), range, [&object, &others](auto &other, auto &) {
+        if (other->type() == ObjectType::Creature && other != object) {
+            others.push_back(other);
+        }
+    });
+    for (auto &perceived : {&creature->perception().heard, &creature->perception().seen}) {
+        for (auto &other : *perceived) {
+            if (_objectGrid.contains(other->id())) {
+                others.push_back(other);
             }
-
-            // Sight
-            bool wasSeen = creature->perception().seen.count(other) > 0;
-            if (!wasSeen && seen) {
-                debug(str(boost::format("%s seen by %s") % other->tag() % creature->tag()), LogChannel::Perception);
-                creature->onObjectSeen(other);
-            } else if (wasSeen && !seen) {
-                debug(str(boost::format("%s vanished from %s") % other->tag() % creature->tag()), LogChannel::Perception);
-                creature->onObjectVanished(other);
+        }
+    }
+    std::sort(others.begin(), others.end(), [](auto &left, auto &right) { return left->id() < right->id(); });
+    others.erase(std::unique(others.begin(), others.end()), others.end());
+
+    // Test line of sight to creatures missing from cache in a single batch
+    std::vector<char> heardOthers(others.size(), false);
+    std::vector<char> seenOthers(others.size(), false);
+    std::vector<CollisionQuery> queries;
+    std::vector<size_t> queryOthers;
+    for (size_t i = 0; i < others.size(); ++i) {
+        auto &other = others[i];
+        float distance2 = creature->getSquareDistanceTo(*other);
+        if (distance2 <= hearingRange2) {
+            heardOthers[i] = true;
+        }
+        if (distance2 <= sightRange2 && creature->isInLineOfSight(*other, kLineOfSightFOV)) {
+            bool seen = false;
+            if (_lineOfSightCache.get(creature->id(), creature->position(), other->id(), other->position(), seen)) {
+                seenOthers[i] = seen;
+            } else {
+                queries.push_back(makeLineOfSightQuery(*creature, *other));
+                queryOthers.push_back(i);
             }
         }
     }
+    if (!queries.empty()) {
+        auto &sceneGraph = _services.scene.graphs.get(_sceneName);
+        sceneGraph.testLineOfSightBatch(queries, nullptr);
+        for (size_t i = 0; i < queries.size(); ++i) {
+            auto &other = others[queryOthers[i]];
+            bool seen = isLineOfSightClear(*creature, *other, queries[i]);
+            _lineOfSightCache.put(creature->id(), creature->position(), other->id(), other->position(), seen);
+            seenOthers[queryOthers[i]] = seen;
+        }
+        rays += static_cast<int>(queries.size());
+    }
+
+    for (size_t i = 0; i < others.size(); ++i) {
+        auto &other = others[i];
+        bool heard = heardOthers[i];
+        bool seen = seenOthers[i];
+
+        // Hearing
+        bool wasHeard = creature->perception().heard.count(other) > 0;
+        if (!wasHeard && heard) {
+            debug(str(boost::format("%s heard by %s") % other->tag() % creature->tag()), LogChannel::Perception);
+            creature->onObjectHeard(other);
+        } else if (wasHeard && !heard) {
+            debug(str(boost::format("%s inaudible to %s") % other->tag() % creature->tag()), LogChannel::Perception);
+            creature->onObjectInaudible(other);
+        }
+
+        // Sight
+        bool wasSeen = creature->perception().seen.count(other) > 0;
+        if (!wasSeen && seen) {
+            debug(str(boost::format("%s seen by %s") % other->tag() % creature->tag()), LogChannel::Perception);
+            creature->onObjectSeen(other);
+        } else if (wasSeen && !seen) {
+            debug(str(boost::format("%s vanished from %s") % other->tag() % creature->tag()), LogChannel::Perception);
+            creature->onObjectVanished(other);
+        }
+    }
+
+    return rays;
 }
 
 Object *Area::getObjectAt(int x, int y) const {
@@ -490,6 +490,7 @@ void Creature::playSound(SoundSetEntry entry, bool positional) {
 void Creature::die() {
     _currentHitPoints = 0;
     _dead = true;
+    invalidateSelectable();
     _name = _services.resource.strings.getText(kStrRefRemains);
 
     debug(str(boost::format("Creature %s is dead") % _tag));
@@ -729,15 +730,14 @@ bool Creature::navigateTo(const glm::vec3 &dest, bool run, float distance, float
         return true;
     }
 
-    bool updPath = true;
+    // Keep following the current path while a new one is being solved
     if (_path) {
         uint32_t now = _services.system.clock.millis();
-        if (_path->destination == dest || now - _path->timeFound <= kKeepPathDuration) {
-            advanceOnPath(run, dt);
-            updPath = false;
+        if (_path->destination != dest && now - _path->timeFound > kKeepPathDuration) {
+            updatePath(dest);
         }
-    }
-    if (updPath) {
+        advanceOnPath(run, dt);
+    } else {
         updatePath(dest);
     }
 
@@ -783,9 +783,7 @@ void Creature::advanceOnPath(bool run, float dt) {
 }
 
 void Creature::updatePath(const glm::vec3 &dest) {
-    std::vector<glm::vec3> points(_game.module()->area()->pathfinder().findPath(_position, dest));
-    uint32_t now = _services.system.clock.millis();
-    setPath(dest, std::move(points), now);
+    _game.module()->area()->pathRequests().request(_id, _position, dest);
 }
 
 std::string Creature::getAnimationName(AnimationType anim) const {
@@ -34,6 +34,7 @@
 
 #include "reone/game/di/services.h"
 #include "reone/game/game.h"
+#include "reone/game/lineofsightcache.h"
 
 using namespace reone::graphics;
 using namespace reone::resource;
@@ -128,6 +129,9 @@ void Door::open(const std::shared_ptr<Object> &triggerrer) {
         _walkmeshClosed->setEnabled(false);
     }
     _open = true;
+    invalidateSelectable();
+
+    invalidateLineOfSight();
 }
 
 void Door::close(const std::shared_ptr<Object> &triggerrer) {
@@ -146,6 +150,15 @@ void Door::close(const std::shared_ptr<Object> &triggerrer) {
         _walkmeshClosed->setEnabled(true);
     }
     _open = false;
+    invalidateSelectable();
+
+    invalidateLineOfSight();
+}
+
+void Door::invalidateLineOfSight() {
+    if (_lineOfSightCache) {
+        _lineOfSightCache->invalidate();
+    }
 }
 
 void Door::setLocked(bool locked) {
@@ -108,6 +108,22 @@ bool Trigger::isIn(const glm::vec2 &point) const {
     return static_cast<TriggerSceneNode *>(_sceneNode.get())->isIn(point);
 }
 
+float Trigger::getBoundingRadius() const {
+    float radius2 = 0.0f;
+    for (auto &point : _geometry) {
+        radius2 = std::max(radius2, glm::length2(glm::vec2(point)));
+    }
+    return glm::sqrt(radius2);
+}
+
+void Trigger::updateTransform() {
+    Object::updateTransform();
+
+    if (_triggerGrid) {
+        _triggerGrid->move(_id, _position);
+    }
+}
+
 bool Trigger::isTenant(const std::shared_ptr<Object> &object) const {
     auto maybeTenant = find(_tenants.begin(), _tenants.end(), object);
     return maybeTenant != _tenants.end();
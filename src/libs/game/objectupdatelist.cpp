@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "reone/game/objectupdatelist.h"
+
+#include "reone/game/object.h"
+
+namespace reone {
+
+namespace game {
+
+static bool isSleepAllowed(ObjectType type) {
+    // Update of these types does nothing beyond base object update
+    switch (type) {
+    case ObjectType::Item:
+    case ObjectType::Door:
+    case ObjectType::Waypoint:
+    case ObjectType::Placeable:
+    case ObjectType::Store:
+    case ObjectType::Encounter:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void ObjectUpdateList::add(Object &object) {
+    _objects.push_back(&object);
+}
+
+void ObjectUpdateList::remove(Object &object) {
+    std::replace(_objects.begin(), _objects.end(), &object, static_cast<Object *>(nullptr));
+}
+
+void ObjectUpdateList::update(float dt) {
+    // Objects woken up during update are appended and updated in the same frame
+    for (size_t i = 0; i < _objects.size(); ++i) {
+        auto object = _objects[i];
+        if (object) {
+            object->update(dt);
+        }
+    }
+    auto asleep = std::remove_if(_objects.begin(), _objects.end(), [](auto object) {
+        return !object || (isSleepAllowed(object->type()) && object->sleep());
+    });
+    _objects.erase(asleep, _objects.end());
+}
+
+bool ObjectUpdateList::contains(const Object &object) const {
+    return std::find(_objects.begin(), _objects.end(), &object) != _objects.end();
+}
+
+} // namespace game
+
+} // namespace reone
@@ -23,35 +23,136 @@ namespace reone {
 
 namespace game {
 
-const Pathfinder::ContextVertex &Pathfinder::Context::getVertexWithLeastTotalCostFromOpen() const {
-    uint16_t bestIdx = 0xffff;
-    float bestTotalCost = std::numeric_limits<float>().max();
-
-    for (uint16_t idx : open) {
-        const ContextVertex &vert = vertices.find(idx)->second;
-        if (bestIdx == 0xffff || vert.totalCost < bestTotalCost) {
-            bestIdx = idx;
-            bestTotalCost = vert.totalCost;
+thread_local Pathfinder::Context Pathfinder::_context;
+
+void Pathfinder::Context::reset(size_t numVertices) {
+    if (stamps.size() != numVertices) {
+        distances.assign(numVertices, 0.0f);
+        parents.assign(numVertices, kInvalidVertex);
+        stamps.assign(numVertices, 0);
+        closed.assign(numVertices, false);
+        heapPositions.assign(numVertices, kNotInHeap);
+        stamp = 0;
+    }
+    heap.clear();
+    heapCosts.clear();
+
+    // Stamp overflow would make stale state look current
+    if (++stamp == 0) {
+        std::fill(stamps.begin(), stamps.end(), 0);
+        stamp = 1;
+    }
+}
+
+void Pathfinder::Context::visit(uint16_t vertex) {
+    stamps[vertex] = stamp;
+    distances[vertex] = 0.0f;
+    parents[vertex] = kInvalidVertex;
+    closed[vertex] = false;
+    heapPositions[vertex] = kNotInHeap;
+}
+
+void Pathfinder::Context::push(uint16_t vertex, float totalCost) {
+    auto position = static_cast<uint32_t>(heap.size());
+    heap.push_back(vertex);
+    heapCosts.push_back(totalCost);
+    heapPositions[vertex] = position;
+    siftUp(position);
+}
+
+void Pathfinder::Context::decreaseKey(uint16_t vertex, float totalCost) {
+    auto position = heapPositions[vertex];
+    heapCosts[position] = totalCost;
+    siftUp(position);
+}
+
+uint16_t Pathfinder::Context::pop() {
+    uint16_t vertex = heap.front();
+    swap(0, static_cast<uint32_t>(heap.size() - 1));
+    heap.pop_back();
+    heapCosts.pop_back();
+    heapPositions[vertex] = kNotInHeap;
+    if (!heap.empty()) {
+        siftDown(0);
+    }
+    return vertex;
+}
+
+void Pathfinder::Context::siftUp(uint32_t position) {
+    while (position > 0) {
+        uint32_t parent = (position - 1) / 2;
+        if (heapCosts[parent] <= heapCosts[position]) {
+            break;
+        }
+        swap(parent, position);
+        position = parent;
+    }
+}
+
+void Pathfinder::Context::siftDown(uint32_t position) {
+    auto size = static_cast<uint32_t>(heap.size());
+    while (true) {
+        uint32_t left = 2 * position + 1;
+        uint32_t right = left + 1;
+        uint32_t smallest = position;
+        if (left < size && heapCosts[left] < heapCosts[smallest]) {
+            smallest = left;
+        }
+        if (right < size && heapCosts[right] < heapCosts[smallest]) {
+            smallest = right;
+        }
+        if (smallest == position) {
+            break;
         }
+        swap(smallest, position);
+        position = smallest;
     }
+}
 
-    return vertices.find(bestIdx)->second;
+void Pathfinder::Context::swap(uint32_t left, uint32_t right) {
+    std::swap(heap[left], heap[right]);
+    std::swap(heapCosts[left], heapCosts[right]);
+    heapPositions[heap[left]] = left;
+    heapPositions[heap[right]] = right;
 }
 
 void Pathfinder::load(const std::vector<Path::Point> &points, const std::unordered_map<int, float> &pointZ) {
+    _vertices.clear();
+    _edgeOffsets.clear();
+    _edgeTargets.clear();
+    _edgeCosts.clear();
+
     for (uint16_t i = 0; i < points.size(); ++i) {
         float z = pointZ.count(i) > 0 ? pointZ.at(i) : 0.0f;
 
         const auto &point = points[i];
-        glm::vec3 pointVec(point.x, point.y, z);
-        _vertices.push_back(pointVec);
-
-        glm::vec3 adjPointVec;
-        for (auto &adjPointIdx : point.adjPoints) {
-            const Path::Point &adjPoint = points[adjPointIdx];
-            _adjacentVertices[i].push_back(static_cast<uint16_t>(adjPointIdx));
+        _vertices.push_back(glm::vec3(point.x, point.y, z));
+    }
+    for (uint16_t i = 0; i < points.size(); ++i) {
+        _edgeOffsets.push_back(static_cast<uint32_t>(_edgeTargets.size()));
+        for (auto &adjPointIdx : points[i].adjPoints) {
+            _edgeTargets.push_back(static_cast<uint16_t>(adjPointIdx));
+            _edgeCosts.push_back(glm::distance(_vertices[i], _vertices[adjPointIdx]));
         }
     }
+    _edgeOffsets.push_back(static_cast<uint32_t>(_edgeTargets.size()));
+
+    _kdTree.resize(_vertices.size());
+    std::iota(_kdTree.begin(), _kdTree.end(), 0);
+    buildKdTree(0, static_cast<int>(_kdTree.size()), 0);
+}
+
+void Pathfinder::buildKdTree(int begin, int end, int depth) {
+    if (end - begin < 2) {
+        return;
+    }
+    int axis = depth % 2;
+    int mid = (begin + end) / 2;
+    std::nth_element(_kdTree.begin() + begin, _kdTree.begin() + mid, _kdTree.begin() + end, [this, &axis](uint16_t left, uint16_t right) {
+        return _vertices[left][axis] < _vertices[right][axis];
+    });
+    buildKdTree(begin, mid, depth + 1);
+    buildKdTree(mid + 1, end, depth + 1);
 }
 
 const std::vector<glm::vec3> Pathfinder::findPath(const glm::vec3 &from, const glm::vec3 &to) const {
@@ -64,89 +165,104 @@ const std::vector<glm::vec3> Pathfinder::findPath(const glm::vec3 &from, const g
     uint16_t fromIdx = getNearestVertex(from);
     uint16_t toIdx = getNearestVertex(to);
 
-    // When start and end point have a common nearest vertex, return a path of start and end point
-    if (fromIdx == toIdx) {
+    // When start and end point have a common nearest vertex, or there is no path between vertices, return a path of start and end point
+    auto path = findPath(fromIdx, toIdx);
+    if (path.empty()) {
         return std::vector<glm::vec3> {from, to};
     }
 
-    Context ctx;
+    return path;
+}
 
-    // Add vertex, nearest to start point, to open list
-    ContextVertex fromVert;
-    fromVert.index = fromIdx;
-    ctx.vertices.insert(std::make_pair(fromIdx, fromVert));
-    ctx.open.insert(fromIdx);
+std::vector<glm::vec3> Pathfinder::findPath(uint16_t fromIdx, uint16_t toIdx) const {
+    if (fromIdx == toIdx || fromIdx >= _vertices.size() || toIdx >= _vertices.size()) {
+        return std::vector<glm::vec3>();
+    }
+
+    Context &ctx = _context;
+    ctx.reset(_vertices.size());
 
-    while (!ctx.open.empty()) {
-        // Extract vertex with least total cost from open list
-        const ContextVertex &current = ctx.getVertexWithLeastTotalCostFromOpen();
-        ctx.open.erase(current.index);
+    // Add vertex, nearest to start point, to open list
+    ctx.visit(fromIdx);
+    ctx.push(fromIdx, glm::distance(_vertices[fromIdx], _vertices[toIdx]));
 
-        // Add current vertex to closed list
-        ctx.closed.insert(current.index);
+    while (!ctx.heap.empty()) {
+        // Extract vertex with least total cost from open list and add it to closed list
+        uint16_t current = ctx.pop();
+        ctx.closed[current] = true;
 
         // Reconstruct path if current vertex is nearest to end point
-        if (current.index == toIdx) {
+        if (current == toIdx) {
             std::vector<glm::vec3> path;
-            uint16_t idx = current.index;
+            uint16_t idx = current;
             do {
-                const ContextVertex &vert = ctx.vertices.find(idx)->second;
-                path.push_back(_vertices[vert.index]);
-                idx = vert.parentIndex;
-            } while (idx != 0xffff);
+                path.push_back(_vertices[idx]);
+                idx = ctx.parents[idx];
+            } while (idx != kInvalidVertex);
             reverse(path.begin(), path.end());
             return path;
         }
 
-        // Skip current vertex if it has no adjacent vertices
-        auto maybeAdjVerts = _adjacentVertices.find(current.index);
-        if (maybeAdjVerts == _adjacentVertices.end())
-            continue;
+        for (uint32_t edge = _edgeOffsets[current]; edge < _edgeOffsets[current + 1]; ++edge) {
+            uint16_t adjVertIdx = _edgeTargets[edge];
+            float distance = ctx.distances[current] + _edgeCosts[edge];
 
-        for (auto &adjVertIdx : maybeAdjVerts->second) {
-            // Skip adjacent vertex if it is present in closed list
-            if (ctx.closed.count(adjVertIdx) > 0)
+            if (!ctx.isVisited(adjVertIdx)) {
+                ctx.visit(adjVertIdx);
+            } else if (ctx.closed[adjVertIdx] || distance >= ctx.distances[adjVertIdx]) {
+                // Skip adjacent vertex if it is present in closed list, or computed distance is not shorter
                 continue;
-
-            ContextVertex child;
-            child.index = adjVertIdx;
-            child.parentIndex = current.index;
-            child.distance = current.distance + glm::distance2(_vertices[current.index], _vertices[adjVertIdx]);
-            child.heuristic = glm::distance2(_vertices[child.index], _vertices[toIdx]);
-            child.totalCost = child.distance + child.heuristic;
-
-            // Do nothing if adjacent vertex is present in open list and computed distance is greater
-            auto maybeOpenAdjVert = ctx.open.find(adjVertIdx);
-            if (maybeOpenAdjVert != ctx.open.end()) {
-                const ContextVertex &openAdjVert = ctx.vertices.find(*maybeOpenAdjVert)->second;
-                if (child.distance > openAdjVert.distance)
-                    continue;
             }
+            ctx.distances[adjVertIdx] = distance;
+            ctx.parents[adjVertIdx] = current;
 
             // Insert or update adjacent vertex in open list
-            ctx.vertices.insert(std::make_pair(adjVertIdx, child));
-            ctx.open.insert(adjVertIdx);
+            float totalCost = distance + glm::distance(_vertices[adjVertIdx], _vertices[toIdx]);
+            if (ctx.isOpen(adjVertIdx)) {
+                ctx.decreaseKey(adjVertIdx, totalCost);
+            } else {
+                ctx.push(adjVertIdx, totalCost);
+            }
         }
     }
 
-    // Return a path of start and end points by default
-    return std::vector<glm::vec3> {from, to};
+    return std::vector<glm::vec3>();
 }
 
 uint16_t Pathfinder::getNearestVertex(const glm::vec3 &point) const {
-    uint16_t index = 0xffff;
-    float minDist = 0.0f;
+    uint16_t nearest = kInvalidVertex;
+    float nearestDist2 = std::numeric_limits<float>::max();
+    findNearestInKdTree(point, 0, static_cast<int>(_kdTree.size()), 0, nearest, nearestDist2);
+    return nearest;
+}
 
-    for (int i = 0; i < _vertices.size(); ++i) {
-        float dist = glm::distance2(point, _vertices[i]);
+void Pathfinder::findNearestInKdTree(const glm::vec3 &point, int begin, int end, int depth, uint16_t &nearest, float &nearestDist2) const {
+    if (begin >= end) {
+        return;
+    }
+    int mid = (begin + end) / 2;
+    uint16_t vertex = _kdTree[mid];
+    float dist2 = glm::distance2(point, _vertices[vertex]);
+    if (nearest == kInvalidVertex || dist2 < nearestDist2 || (dist2 == nearestDist2 && vertex < nearest)) {
+        nearest = vertex;
+        nearestDist2 = dist2;
+    }
 
-        if (index == 0xffff || dist < minDist) {
-            index = i;
-            minDist = dist;
+    // Descend into the half containing the point first. The other half can
+    // only contain a nearer vertex if the splitting plane is near enough.
+    int axis = depth % 2;
+    float delta = point[axis] - _vertices[vertex][axis];
+    if (delta < 0.0f) {
+        findNearestInKdTree(point, begin, mid, depth + 1, nearest, nearestDist2);
+        if (delta * delta <= nearestDist2) {
+            findNearestInKdTree(point, mid + 1, end, depth + 1, nearest, nearestDist2);
+        }
+    } else {
+        findNearestInKdTree(point, mid + 1, end, depth + 1, nearest, nearestDist2);
+        if (delta * delta <= nearestDist2) {
+            findNearestInKdTree(point, begin, mid, depth + 1, nearest, nearestDist2);
         }
     }
-
-    return index;
 }
 
 } // namespace game
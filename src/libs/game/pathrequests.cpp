@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "reone/game/pathrequests.h"
+
+namespace reone {
+
+namespace game {
+
+PathRequests::~PathRequests() {
+    if (_batches) {
+        _batches->canceled = true;
+    }
+}
+
+void PathRequests::init(std::shared_ptr<const Pathfinder> pathfinder, std::shared_ptr<const NavMesh> navMesh) {
+    if (_batches) {
+        _batches->canceled = true;
+    }
+    _pathfinder = std::move(pathfinder);
+    _navMesh = std::move(navMesh);
+    _batches = std::make_shared<Batches>();
+    _queued.clear();
+    _ready.clear();
+    _pending.clear();
+    _cache.clear();
+    _cacheByKey.clear();
+}
+
+void PathRequests::request(uint32_t requesterId, const glm::vec3 &from, const glm::vec3 &to) {
+    if (!_pathfinder || isPending(requesterId)) {
+        return;
+    }
+    _pending.insert(requesterId);
+
+    Request request;
+    request.result.requesterId = requesterId;
+    request.result.destination = to;
+    request.origin = from;
+    request.fromVertex = _pathfinder->getNearestVertex(from);
+    request.toVertex = _pathfinder->getNearestVertex(to);
+
+    // Navigation mesh paths depend on exact points, so they are always solved
+    if (_navMesh) {
+        _queued.push_back(std::move(request));
+        return;
+    }
+
+    // Trivial and memoized paths do not need to be solved
+    if (request.fromVertex == Pathfinder::kInvalidVertex ||
+        request.fromVertex == request.toVertex ||
+        getCachedPath(getCacheKey(request.fromVertex, request.toVertex), request.result.points)) {
+        _ready.push_back(std::move(request));
+        return;
+    }
+
+    _queued.push_back(std::move(request));
+}
+
+void PathRequests::flush() {
+    if (_queued.empty()) {
+        return;
+    }
+    auto batch = std::make_shared<std::vector<Request>>(std::move(_queued));
+    _queued.clear();
+
+    _threadPool.enqueue([pathfinder = _pathfinder, navMesh = _navMesh, batches = _batches, batch](const std::atomic_bool &canceled) {
+        for (auto &request : *batch) {
+            if (canceled || batches->canceled) {
+                return;
+            }
+            if (navMesh && navMesh->findPath(request.origin, request.result.destination, request.result.points)) {
+                request.viaNavMesh = true;
+                continue;
+            }
+            request.result.points = pathfinder->findPath(request.fromVertex, request.toVertex);
+        }
+        std::lock_guard<std::mutex> lock(batches->mutex);
+        for (auto &request : *batch) {
+            batches->solved.push_back(std::move(request));
+        }
+    });
+}
+
+void PathRequests::collect(const std::function<void(Result &)> &fn) {
+    if (!_batches) {
+        return;
+    }
+    std::vector<Request> solved;
+    {
+        std::lock_guard<std::mutex> lock(_batches->mutex);
+        solved.swap(_batches->solved);
+    }
+    for (auto &request : solved) {
+        if (request.viaNavMesh) {
+            _ready.push_back(std::move(request));
+            continue;
+        }
+        cachePath(getCacheKey(request.fromVertex, request.toVertex), request.result.points);
+        _ready.push_back(std::move(request));
+    }
+
+    auto ready = std::move(_ready);
+    _ready.clear();
+    for (auto &request : ready) {
+        _pending.erase(request.result.requesterId);
+        complete(request);
+        fn(request.result);
+    }
+}
+
+void PathRequests::complete(Request &request) {
+    // When there is no path between vertices, return a path of start and end points
+    if (request.result.points.empty()) {
+        request.result.points = std::vector<glm::vec3> {request.origin, request.result.destination};
+    }
+}
+
+bool PathRequests::getCachedPath(uint32_t key, std::vector<glm::vec3> &outPoints) {
+    auto maybeEntry = _cacheByKey.find(key);
+    if (maybeEntry == _cacheByKey.end()) {
+        return false;
+    }
+    _cache.splice(_cache.begin(), _cache, maybeEntry->second);
+    outPoints = maybeEntry->second->second;
+    return true;
+}
+
+void PathRequests::cachePath(uint32_t key, const std::vector<glm::vec3> &points) {
+    auto maybeEntry = _cacheByKey.find(key);
+    if (maybeEntry != _cacheByKey.end()) {
+        _cache.splice(_cache.begin(), _cache, maybeEntry->second);
+        return;
+    }
+    _cache.push_front(std::make_pair(key, points));
+    _cacheByKey[key] = _cache.begin();
+    if (_cache.size() > kMaxCachedPaths) {
+        _cacheByKey.erase(_cache.back().first);
+        _cache.pop_back();
+    }
+}
+
+} // namespace game
+
+} // namespace reone
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "reone/game/perceptionscheduler.h"
+
+namespace reone {
+
+namespace game {
+
+void PerceptionScheduler::schedule(std::vector<uint32_t> observerIds) {
+    _observerIds = std::move(observerIds);
+    _next = 0;
+}
+
+void PerceptionScheduler::update(const std::function<int(uint32_t)> &evaluate) {
+    int rays = 0;
+    do {
+        if (isIdle()) {
+            break;
+        }
+        rays += evaluate(_observerIds[_next++]);
+    } while (rays < _rayBudget);
+}
+
+} // namespace game
+
+} // namespace reone
@@ -21,8 +21,6 @@
 #include "reone/resource/provider/scripts.h"
 #include "reone/script/executioncontext.h"
 #include "reone/script/routines.h"
-#include "reone/script/virtualmachine.h"
-
 
 using namespace reone::script;
 
@@ -42,14 +40,45 @@ int ScriptRunner::run(const std::string &resRef, uint32_t callerId, uint32_t tri
     if (!program)
         return -1;
 
-    auto ctx = std::make_unique<ExecutionContext>();
-    ctx->routines = &_routines;
-    ctx->callerId = callerId;
-    ctx->triggererId = triggerrerId;
-    ctx->userDefinedEventNumber = userDefinedEventNumber;
-    ctx->scriptVar = scriptVar;
+    auto machine = acquireMachine(std::move(program));
+    auto &ctx = machine->context();
+    ctx.routines = &_routines;
+    ctx.callerId = callerId;
+    ctx.triggererId = triggerrerId;
+    ctx.userDefinedEventNumber = userDefinedEventNumber;
+    ctx.scriptVar = scriptVar;
+
+    return runMachine(std::move(machine));
+}
+
+int ScriptRunner::resume(const ExecutionContext &action, uint32_t callerId) {
+    auto machine = acquireMachine(action.savedState->program);
+    auto &ctx = machine->context();
+    ctx = action;
+    ctx.callerId = callerId;
+
+    return runMachine(std::move(machine));
+}
+
+std::unique_ptr<VirtualMachine> ScriptRunner::acquireMachine(std::shared_ptr<ScriptProgram> program) {
+    if (_idleMachines.empty()) {
+        return std::make_unique<VirtualMachine>(std::move(program), std::make_unique<ExecutionContext>());
+    }
+    auto machine = std::move(_idleMachines.back());
+    _idleMachines.pop_back();
+    machine->reset(std::move(program));
+    return machine;
+}
+
+int ScriptRunner::runMachine(std::unique_ptr<VirtualMachine> machine) {
+    int result = machine->run();
+
+    // Release references to the program and engine types until next run
+    machine->reset(nullptr);
+    machine->context() = ExecutionContext();
 
-    return VirtualMachine(program, std::move(ctx)).run();
+    _idleMachines.push_back(std::move(machine));
+    return result;
 }
 
 } // namespace game
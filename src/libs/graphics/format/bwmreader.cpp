@@ -78,12 +78,12 @@ void BwmReader::load() {
         Walkmesh::Face face;
         face.index = i;
         face.material = material;
-        face.vertices.push_back(glm::make_vec3(&_vertices[3 * indices[0]]));
-        face.vertices.push_back(glm::make_vec3(&_vertices[3 * indices[1]]));
-        face.vertices.push_back(glm::make_vec3(&_vertices[3 * indices[2]]));
+        face.vertices[0] = glm::make_vec3(&_vertices[3 * indices[0]]);
+        face.vertices[1] = glm::make_vec3(&_vertices[3 * indices[1]]);
+        face.vertices[2] = glm::make_vec3(&_vertices[3 * indices[2]]);
         face.normal = glm::make_vec3(&_normals[3 * i]);
 
-        _walkmesh->_faces.push_back(std::move(face));
+        _walkmesh->add(std::move(face));
     }
 
     if (_type == WalkmeshType::WOK) {
@@ -167,7 +167,7 @@ void BwmReader::loadAABB() {
         aabbs[i]->right = aabbs[childIdx2];
     }
 
-    _walkmesh->_rootAabb = aabbs[0];
+    _walkmesh->setRootAABB(aabbs[0]);
 }
 
 } // namespace graphics
@@ -51,6 +51,7 @@ Model::Model(
 }
 
 void Model::fillLookups(const std::shared_ptr<ModelNode> &node) {
+    _nodes.push_back(node.get());
     _nodeByNumber[node->number()] = node;
     _nodeByName[node->name()] = node;
 
@@ -133,6 +134,48 @@ std::shared_ptr<Animation> Model::getAnimation(const std::string &name) const {
     return anim;
 }
 
+static bool doesNodeHaveAncestor(const ModelNode &node, const std::string &name) {
+    if (name.empty()) {
+        return true;
+    }
+    for (auto ancestor = &node; ancestor; ancestor = ancestor->parent()) {
+        if (ancestor->name() == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::shared_ptr<const Model::AnimationBinding> Model::getAnimationBinding(const Animation &anim) const {
+    // Bindings of animations not retained by this model must not be cached,
+    // as their address could later be reused by another animation
+    bool owned = getAnimation(anim.name()).get() == &anim;
+    if (owned) {
+        std::lock_guard<std::mutex> lock(_animBindingsMutex);
+        auto maybeBinding = _animBindings.find(&anim);
+        if (maybeBinding != _animBindings.end()) {
+            return maybeBinding->second;
+        }
+    }
+    auto binding = std::make_shared<AnimationBinding>(_nodes.size(), nullptr);
+    for (size_t i = 0; i < _nodes.size(); ++i) {
+        auto &node = *_nodes[i];
+        if (!node.isAnimated() || !doesNodeHaveAncestor(node, anim.root())) {
+            continue;
+        }
+        auto animNode = anim.getNodeByName(node.name());
+        if (animNode) {
+            (*binding)[i] = animNode.get();
+        }
+    }
+    if (!owned) {
+        return binding;
+    }
+    std::lock_guard<std::mutex> lock(_animBindingsMutex);
+    auto [inserted, _] = _animBindings.insert(std::make_pair(&anim, std::move(binding)));
+    return inserted->second;
+}
+
 } // namespace graphics
 
 } // namespace reone
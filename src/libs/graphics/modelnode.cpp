@@ -71,28 +71,26 @@ void ModelNode::addChild(std::shared_ptr<ModelNode> child) {
     _children.push_back(std::move(child));
 }
 
-bool ModelNode::floatValueAtTime(ControllerType type, float time, float &value) const {
-    if (_floatTracks.count(type) == 0) {
+template <class Value>
+static bool valueAtTime(const ModelNode::KeyframeTrackMap<Value> &tracks, ControllerType type, float time, Value &value, KeyframeCursor *cursor) {
+    auto maybeTrack = tracks.find(type);
+    if (maybeTrack == tracks.end()) {
         return false;
     }
-    const auto &track = _floatTracks.at(type);
-    return track.valueAtTime(time, value);
+    const auto &track = maybeTrack->second;
+    return cursor ? track.valueAtTime(time, value, *cursor) : track.valueAtTime(time, value);
 }
 
-bool ModelNode::vectorValueAtTime(ControllerType type, float time, glm::vec3 &value) const {
-    if (_vectorTracks.count(type) == 0) {
-        return false;
-    }
-    const auto &track = _vectorTracks.at(type);
-    return track.valueAtTime(time, value);
+bool ModelNode::floatValueAtTime(ControllerType type, float time, float &value, KeyframeCursor *cursor) const {
+    return valueAtTime(_floatTracks, type, time, value, cursor);
 }
 
-bool ModelNode::quaternionValueAt(ControllerType type, float time, glm::quat &value) const {
-    if (_quaternionTracks.count(type) == 0) {
-        return false;
-    }
-    const auto &track = _quaternionTracks.at(type);
-    return track.valueAtTime(time, value);
+bool ModelNode::vectorValueAtTime(ControllerType type, float time, glm::vec3 &value, KeyframeCursor *cursor) const {
+    return valueAtTime(_vectorTracks, type, time, value, cursor);
+}
+
+bool ModelNode::quaternionValueAt(ControllerType type, float time, glm::quat &value, KeyframeCursor *cursor) const {
+    return valueAtTime(_quaternionTracks, type, time, value, cursor);
 }
 
 } // namespace graphics
@@ -21,116 +21,262 @@ namespace reone {
 
 namespace graphics {
 
-const Walkmesh::Face *Walkmesh::raycast(
-    std::set<uint32_t> surfaces,
+static constexpr size_t kTriangleBlockSize = 4;
+static constexpr int kMaxSurfaces = 8 * sizeof(SurfaceMask);
+
+static bool raycastBounds(
+    const glm::vec3 &min,
+    const glm::vec3 &max,
     const glm::vec3 &origin,
-    const glm::vec3 &dir,
-    float maxDistance,
-    float &outDistance) const {
+    const glm::vec3 &invDir,
+    float maxDistance) {
 
-    // For area walkmeshes, find intersection via AABB tree
-    if (_rootAabb) {
-        return raycastAABB(surfaces, origin, dir, maxDistance, outDistance);
-    }
+    glm::vec3 t1((min - origin) * invDir);
+    glm::vec3 t2((max - origin) * invDir);
+    glm::vec3 tNear(glm::min(t1, t2));
+    glm::vec3 tFar(glm::max(t1, t2));
+    float tmin = glm::max(0.0f, glm::max(tNear.x, glm::max(tNear.y, tNear.z)));
+    float tmax = glm::min(tFar.x, glm::min(tFar.y, tFar.z));
 
-    // For placeable and door walkmeshes, test all faces for intersection
-    float distance = 0.0f;
-    float minDistance = std::numeric_limits<float>::max();
-    std::optional<std::reference_wrapper<const Face>> intersected;
-    for (auto &face : _faces) {
-        if (!raycastFace(surfaces, face, origin, dir, maxDistance, distance)) {
-            continue;
-        }
-        if (distance < minDistance) {
-            minDistance = distance;
-            intersected = face;
-        }
+    return tmin <= tmax && tmin < maxDistance;
+}
+
+static void collectLeafFaces(const Walkmesh::AABB &aabb, size_t limit, std::vector<int> &outFaces) {
+    if (outFaces.size() > limit) {
+        return;
     }
-    if (intersected) {
-        outDistance = minDistance;
-        return &intersected->get();
+    if (aabb.faceIdx != -1) {
+        outFaces.push_back(aabb.faceIdx);
+        return;
     }
+    if (aabb.left) {
+        collectLeafFaces(*aabb.left, limit, outFaces);
+    }
+    if (aabb.right) {
+        collectLeafFaces(*aabb.right, limit, outFaces);
+    }
+}
 
-    return nullptr;
+void Walkmesh::Triangles::clear() {
+    for (auto array : {&v0x, &v0y, &v0z, &e1x, &e1y, &e1z, &e2x, &e2y, &e2z}) {
+        array->clear();
+    }
+    materialBits.clear();
+    faces.clear();
+    count = 0;
 }
 
-const Walkmesh::Face *Walkmesh::raycastAABB(
-    std::set<uint32_t> surfaces,
-    const glm::vec3 &origin,
-    const glm::vec3 &dir,
-    float maxDistance,
-    float &outDistance) const {
+void Walkmesh::Triangles::push(const Face &face, int faceIdx) {
+    if (count == faces.size()) {
+        // Append a block of padding triangles, that never intersect
+        size_t newSize = faces.size() + kTriangleBlockSize;
+        for (auto array : {&v0x, &v0y, &v0z, &e1x, &e1y, &e1z, &e2x, &e2y, &e2z}) {
+            array->resize(newSize, 0.0f);
+        }
+        materialBits.resize(newSize, 0);
+        faces.resize(newSize, -1);
+    }
+    auto &v0 = face.vertices[0];
+    auto e1 = face.vertices[1] - v0;
+    auto e2 = face.vertices[2] - v0;
+    v0x[count] = v0.x;
+    v0y[count] = v0.y;
+    v0z[count] = v0.z;
+    e1x[count] = e1.x;
+    e1y[count] = e1.y;
+    e1z[count] = e1.z;
+    e2x[count] = e2.x;
+    e2y[count] = e2.y;
+    e2z[count] = e2.z;
+    materialBits[count] = face.material < kMaxSurfaces ? (static_cast<SurfaceMask>(1) << face.material) : 0;
+    faces[count] = faceIdx;
+    ++count;
+}
 
-    float distance = 0.0f;
+void Walkmesh::Triangles::pad() {
+    count = faces.size();
+}
 
-    std::stack<AABB *> aabbs;
-    aabbs.push(_rootAabb.get());
+void Walkmesh::add(Face &&face) {
+    for (auto &vertex : face.vertices) {
+        _aabb.expand(vertex);
+    }
+    _triangles.push(face, static_cast<int>(_faces.size()));
+    _faces.push_back(std::move(face));
+}
 
-    auto invDir = 1.0f / dir;
+void Walkmesh::setRootAABB(std::shared_ptr<AABB> aabb) {
+    _nodes.clear();
+    _triangles.clear();
+    if (!aabb) {
+        for (size_t i = 0; i < _faces.size(); ++i) {
+            _triangles.push(_faces[i], static_cast<int>(i));
+        }
+        return;
+    }
+    flattenAABB(*aabb);
+}
 
-    while (!aabbs.empty()) {
-        auto aabb = aabbs.top();
-        aabbs.pop();
+int Walkmesh::flattenAABB(const AABB &aabb) {
+    int nodeIdx = static_cast<int>(_nodes.size());
+    _nodes.push_back(Node());
 
-        // Test ray/face intersection for tree leafs
-        if (aabb->faceIdx != -1) {
-            const Face &face = _faces[aabb->faceIdx];
-            if (raycastFace(surfaces, face, origin, dir, maxDistance, distance)) {
-                outDistance = distance;
-                return &face;
+    // Subtrees with few enough faces become leaves, holding a single triangle block
+    std::vector<int> leafFaces;
+    collectLeafFaces(aabb, kTriangleBlockSize, leafFaces);
+    if (leafFaces.size() <= kTriangleBlockSize) {
+        glm::vec3 min(std::numeric_limits<float>::max());
+        glm::vec3 max(std::numeric_limits<float>::lowest());
+        for (auto faceIdx : leafFaces) {
+            auto &face = _faces[faceIdx];
+            _triangles.push(face, faceIdx);
+            for (auto &vertex : face.vertices) {
+                min = glm::min(min, vertex);
+                max = glm::max(max, vertex);
             }
-            continue;
         }
+        _triangles.pad();
+        auto &node = _nodes[nodeIdx];
+        node.min = min;
+        node.max = max;
+        node.block = leafFaces.empty() ? 0 : static_cast<uint32_t>(_triangles.size() / kTriangleBlockSize);
+        node.skip = nodeIdx + 1;
+        return nodeIdx;
+    }
 
-        // Test ray/AABB intersection
-        if (!aabb->value.raycast(origin, invDir, maxDistance, distance)) {
+    glm::vec3 min(std::numeric_limits<float>::max());
+    glm::vec3 max(std::numeric_limits<float>::lowest());
+    for (auto child : {aabb.left.get(), aabb.right.get()}) {
+        if (!child) {
             continue;
         }
-
-        // Find intersection with child AABB nodes
-        if (aabb->left) {
-            aabbs.push(aabb->left.get());
-        }
-        if (aabb->right) {
-            aabbs.push(aabb->right.get());
-        }
+        int childIdx = flattenAABB(*child);
+        min = glm::min(min, _nodes[childIdx].min);
+        max = glm::max(max, _nodes[childIdx].max);
     }
-
-    return nullptr;
+    auto &node = _nodes[nodeIdx];
+    node.min = min;
+    node.max = max;
+    node.skip = static_cast<uint32_t>(_nodes.size());
+    return nodeIdx;
 }
 
-bool Walkmesh::raycastFace(
-    std::set<uint32_t> surfaces,
-    const Face &face,
+const Walkmesh::Face *Walkmesh::raycast(
+    SurfaceMask surfaces,
     const glm::vec3 &origin,
     const glm::vec3 &dir,
     float maxDistance,
     float &outDistance) const {
 
-    if (surfaces.count(face.material) == 0) {
-        return false;
+    float distance = maxDistance;
+    int faceIdx = -1;
+
+    if (_nodes.empty()) {
+        // For placeable and door walkmeshes, test all faces for intersection
+        for (size_t block = 0; block < _triangles.size() / kTriangleBlockSize; ++block) {
+            int blockFaceIdx = raycastBlock(block, surfaces, origin, dir, distance);
+            if (blockFaceIdx != -1) {
+                faceIdx = blockFaceIdx;
+            }
+        }
+    } else {
+        // For area walkmeshes, traverse the bounding volume hierarchy, pruning
+        // subtrees farther than the nearest intersection found so far
+        auto invDir = 1.0f / dir;
+        uint32_t nodeIdx = 0;
+        while (nodeIdx < _nodes.size()) {
+            auto &node = _nodes[nodeIdx];
+            if (!raycastBounds(node.min, node.max, origin, invDir, distance)) {
+                nodeIdx = node.skip;
+                continue;
+            }
+            if (node.block != 0) {
+                int blockFaceIdx = raycastBlock(node.block - 1, surfaces, origin, dir, distance);
+                if (blockFaceIdx != -1) {
+                    faceIdx = blockFaceIdx;
+                }
+            }
+            ++nodeIdx;
+        }
     }
 
-    const glm::vec3 &p0 = face.vertices[0];
-    const glm::vec3 &p1 = face.vertices[1];
-    const glm::vec3 &p2 = face.vertices[2];
+    if (faceIdx == -1) {
+        return nullptr;
+    }
+    outDistance = distance;
+    return &_faces[faceIdx];
+}
+
+int Walkmesh::raycastBlock(
+    size_t block,
+    SurfaceMask surfaces,
+    const glm::vec3 &origin,
+    const glm::vec3 &dir,
+    float &inOutDistance) const {
 
-    glm::vec2 baryPosition(0.0f);
-    float distance = 0.0f;
+    // Möller–Trumbore intersection of a ray with a block of triangles. The
+    // loop is branchless and has a fixed trip count, so that it is vectorized.
+    size_t base = block * kTriangleBlockSize;
+    const float *v0x = &_triangles.v0x[base];
+    const float *v0y = &_triangles.v0y[base];
+    const float *v0z = &_triangles.v0z[base];
+    const float *e1x = &_triangles.e1x[base];
+    const float *e1y = &_triangles.e1y[base];
+    const float *e1z = &_triangles.e1z[base];
+    const float *e2x = &_triangles.e2x[base];
+    const float *e2y = &_triangles.e2y[base];
+    const float *e2z = &_triangles.e2z[base];
+    const SurfaceMask *materialBits = &_triangles.materialBits[base];
+    float maxDistance = inOutDistance;
 
-    if (glm::intersectRayTriangle(origin, dir, p0, p1, p2, baryPosition, distance) && distance > 0.0f && distance < maxDistance) {
-        outDistance = distance;
-        return true;
+    float distances[kTriangleBlockSize];
+    for (size_t i = 0; i < kTriangleBlockSize; ++i) {
+        float px = dir.y * e2z[i] - dir.z * e2y[i];
+        float py = dir.z * e2x[i] - dir.x * e2z[i];
+        float pz = dir.x * e2y[i] - dir.y * e2x[i];
+        float det = e1x[i] * px + e1y[i] * py + e1z[i] * pz;
+        float invDet = 1.0f / det;
+        float tx = origin.x - v0x[i];
+        float ty = origin.y - v0y[i];
+        float tz = origin.z - v0z[i];
+        float u = (tx * px + ty * py + tz * pz) * invDet;
+        float qx = ty * e1z[i] - tz * e1y[i];
+        float qy = tz * e1x[i] - tx * e1z[i];
+        float qz = tx * e1y[i] - ty * e1x[i];
+        float v = (dir.x * qx + dir.y * qy + dir.z * qz) * invDet;
+        float distance = (e2x[i] * qx + e2y[i] * qy + e2z[i] * qz) * invDet;
+        bool hit = (surfaces & materialBits[i]) != 0 &&
+                   glm::abs(det) > std::numeric_limits<float>::epsilon() &&
+                   u >= 0.0f && v >= 0.0f && u + v <= 1.0f &&
+                   distance > 0.0f && distance < maxDistance;
+        distances[i] = hit ? distance : std::numeric_limits<float>::max();
     }
 
-    return false;
+    int faceIdx = -1;
+    for (size_t i = 0; i < kTriangleBlockSize; ++i) {
+        if (distances[i] < inOutDistance) {
+            inOutDistance = distances[i];
+            faceIdx = _triangles.faces[base + i];
+        }
+    }
+    return faceIdx;
 }
 
 bool Walkmesh::contains(const glm::vec2 &point) const {
-    if (!_rootAabb) {
+    if (_nodes.empty()) {
         return false;
     }
-    return _rootAabb->value.contains(point);
+    return _aabb.contains(point);
+}
+
+SurfaceMask Walkmesh::getSurfaceMask(const std::set<uint32_t> &surfaces) {
+    SurfaceMask mask = 0;
+    for (auto surface : surfaces) {
+        if (surface < kMaxSurfaces) {
+            mask |= static_cast<SurfaceMask>(1) << surface;
+        }
+    }
+    return mask;
 }
 
 } // namespace graphics
@@ -18,15 +18,27 @@
 #include "reone/resource/container/erf.h"
 
 #include "reone/resource/format/erfreader.h"
+#include "reone/system/exception/validation.h"
+#include "reone/system/stream/memoryinput.h"
 
 namespace reone {
 
 namespace resource {
 
 void ErfResourceContainer::init() {
-    _erf = std::make_unique<FileInputStream>(_path);
+    if (_mapped) {
+        _mapping = std::make_shared<MemoryMappedFile>(_path);
+        _mapping->init();
+        auto erf = MemoryInputStream(_mapping->data(), _mapping->size());
+        loadResources(erf);
+    } else {
+        _erf = std::make_unique<FileInputStream>(_path);
+        loadResources(*_erf);
+    }
+}
 
-    auto reader = ErfReader(*_erf);
+void ErfResourceContainer::loadResources(IInputStream &erf) {
+    auto reader = ErfReader(erf);
     reader.load();
 
     auto &keys = reader.keys();
@@ -43,6 +55,13 @@ void ErfResourceContainer::init() {
 }
 
 std::optional<ByteBuffer> ErfResourceContainer::findResourceData(const ResourceId &id) {
+    if (_mapping) {
+        auto view = findResourceView(id);
+        if (!view) {
+            return std::nullopt;
+        }
+        return ByteBuffer(view->data, view->data + view->size);
+    }
     auto it = _idToResource.find(id);
     if (it == _idToResource.end()) {
         return std::nullopt;
@@ -54,12 +73,32 @@ std::optional<ByteBuffer> ErfResourceContainer::findResourceData(const ResourceI
     ByteBuffer buf;
     buf.resize(resource.fileSize);
 
+    std::lock_guard<std::mutex> lock {_erfMutex};
     _erf->seek(resource.offset, SeekOrigin::Begin);
     _erf->read(&buf[0], buf.size());
 
     return buf;
 }
 
+std::optional<ResourceView> ErfResourceContainer::findResourceView(const ResourceId &id) {
+    if (!_mapping) {
+        return IResourceContainer::findResourceView(id);
+    }
+    auto it = _idToResource.find(id);
+    if (it == _idToResource.end()) {
+        return std::nullopt;
+    }
+    auto &resource = it->second;
+    if (static_cast<size_t>(resource.offset) + resource.fileSize > _mapping->size()) {
+        throw ValidationException("ERF resource out of bounds: " + id.string());
+    }
+    auto view = ResourceView();
+    view.data = _mapping->data() + resource.offset;
+    view.size = resource.fileSize;
+    view.owner = _mapping;
+    return view;
+}
+
 } // namespace resource
 
 } // namespace reone
@@ -60,6 +60,7 @@ std::optional<ByteBuffer> ExeResourceContainer::findResourceData(const ResourceI
     ByteBuffer buf;
     buf.resize(res.size);
 
+    std::lock_guard<std::mutex> lock {_exeMutex};
     _exe->seek(res.offset, SeekOrigin::Begin);
     _exe->read(&buf[0], buf.size());
 
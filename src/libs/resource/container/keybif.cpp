@@ -19,8 +19,10 @@
 
 #include "reone/resource/format/bifreader.h"
 #include "reone/resource/format/keyreader.h"
+#include "reone/system/exception/validation.h"
 #include "reone/system/fileutil.h"
 #include "reone/system/stream/fileinput.h"
+#include "reone/system/stream/memoryinput.h"
 
 namespace reone {
 
@@ -42,30 +44,47 @@ void KeyBifResourceContainer::init() {
     for (auto i = 0; i < keyReader.files().size(); ++i) {
         auto &file = keyReader.files()[i];
         auto bifPath = getFileIgnoreCase(gamePath, file.filename);
-        auto bif = std::make_unique<FileInputStream>(bifPath);
-        auto bifReader = BifReader(*bif);
-        bifReader.load();
+        if (_mapped) {
+            auto mapping = std::make_shared<MemoryMappedFile>(bifPath);
+            mapping->init();
+            auto bif = MemoryInputStream(mapping->data(), mapping->size());
+            loadBifResources(bif, bifIdxToKey.at(i));
+            _bifMappings.push_back(std::move(mapping));
+        } else {
+            auto bif = std::make_unique<FileInputStream>(bifPath);
+            loadBifResources(*bif, bifIdxToKey.at(i));
+            _bifs.push_back(std::move(bif));
+        }
+    }
+}
 
-        auto &keys = bifIdxToKey.at(i);
-        auto &bifResources = bifReader.resources();
+void KeyBifResourceContainer::loadBifResources(IInputStream &bif, const std::vector<const KeyReader::KeyEntry *> &keys) {
+    auto bifReader = BifReader(bif);
+    bifReader.load();
 
-        for (auto &key : keys) {
-            auto &bifResource = bifResources[key->resIdx];
+    auto &bifResources = bifReader.resources();
 
-            auto resource = Resource();
-            resource.bifIdx = key->bifIdx;
-            resource.bifOffset = bifResource.offset;
-            resource.fileSize = bifResource.fileSize;
+    for (auto &key : keys) {
+        auto &bifResource = bifResources[key->resIdx];
 
-            _resourceIds.insert(key->resId);
-            _idToResource.insert(std::make_pair(key->resId, std::move(resource)));
-        }
+        auto resource = Resource();
+        resource.bifIdx = key->bifIdx;
+        resource.bifOffset = bifResource.offset;
+        resource.fileSize = bifResource.fileSize;
 
-        _bifs.push_back(std::move(bif));
+        _resourceIds.insert(key->resId);
+        _idToResource.insert(std::make_pair(key->resId, std::move(resource)));
     }
 }
 
 std::optional<ByteBuffer> KeyBifResourceContainer::findResourceData(const ResourceId &id) {
+    if (_mapped) {
+        auto view = findResourceView(id);
+        if (!view) {
+            return std::nullopt;
+        }
+        return ByteBuffer(view->data, view->data + view->size);
+    }
     auto it = _idToResource.find(id);
     if (it == _idToResource.end()) {
         return std::nullopt;
@@ -77,6 +96,7 @@ std::optional<ByteBuffer> KeyBifResourceContainer::findResourceData(const Resour
     ByteBuffer buf;
     buf.resize(resource.fileSize);
 
+    std::lock_guard<std::mutex> lock {_bifsMutex};
     auto &bif = _bifs.at(resource.bifIdx);
     bif->seek(resource.bifOffset, SeekOrigin::Begin);
     bif->read(&buf[0], buf.size());
@@ -84,6 +104,26 @@ std::optional<ByteBuffer> KeyBifResourceContainer::findResourceData(const Resour
     return buf;
 }
 
+std::optional<ResourceView> KeyBifResourceContainer::findResourceView(const ResourceId &id) {
+    if (!_mapped) {
+        return IResourceContainer::findResourceView(id);
+    }
+    auto it = _idToResource.find(id);
+    if (it == _idToResource.end()) {
+        return std::nullopt;
+    }
+    auto &resource = it->second;
+    auto &mapping = _bifMappings.at(resource.bifIdx);
+    if (static_cast<size_t>(resource.bifOffset) + resource.fileSize > mapping->size()) {
+        throw ValidationException("BIF resource out of bounds: " + id.string());
+    }
+    auto view = ResourceView();
+    view.data = mapping->data() + resource.bifOffset;
+    view.size = resource.fileSize;
+    view.owner = mapping;
+    return view;
+}
+
 } // namespace resource
 
 } // namespace reone
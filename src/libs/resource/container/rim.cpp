@@ -18,16 +18,28 @@
 #include "reone/resource/container/rim.h"
 
 #include "reone/resource/format/rimreader.h"
+#include "reone/system/exception/validation.h"
 #include "reone/system/stream/fileinput.h"
+#include "reone/system/stream/memoryinput.h"
 
 namespace reone {
 
 namespace resource {
 
 void RimResourceContainer::init() {
-    _rim = std::make_unique<FileInputStream>(_path);
+    if (_mapped) {
+        _mapping = std::make_shared<MemoryMappedFile>(_path);
+        _mapping->init();
+        auto rim = MemoryInputStream(_mapping->data(), _mapping->size());
+        loadResources(rim);
+    } else {
+        _rim = std::make_unique<FileInputStream>(_path);
+        loadResources(*_rim);
+    }
+}
 
-    auto reader = RimReader(*_rim);
+void RimResourceContainer::loadResources(IInputStream &rim) {
+    auto reader = RimReader(rim);
     reader.load();
 
     for (auto &rimResource : reader.resources()) {
@@ -41,6 +53,13 @@ void RimResourceContainer::init() {
 }
 
 std::optional<ByteBuffer> RimResourceContainer::findResourceData(const ResourceId &id) {
+    if (_mapping) {
+        auto view = findResourceView(id);
+        if (!view) {
+            return std::nullopt;
+        }
+        return ByteBuffer(view->data, view->data + view->size);
+    }
     auto it = _idToResource.find(id);
     if (it == _idToResource.end()) {
         return std::nullopt;
@@ -52,12 +71,32 @@ std::optional<ByteBuffer> RimResourceContainer::findResourceData(const ResourceI
     ByteBuffer buf;
     buf.resize(resource.fileSize);
 
+    std::lock_guard<std::mutex> lock {_rimMutex};
     _rim->seek(resource.offset, SeekOrigin::Begin);
     _rim->read(&buf[0], buf.size());
 
     return buf;
 }
 
+std::optional<ResourceView> RimResourceContainer::findResourceView(const ResourceId &id) {
+    if (!_mapping) {
+        return IResourceContainer::findResourceView(id);
+    }
+    auto it = _idToResource.find(id);
+    if (it == _idToResource.end()) {
+        return std::nullopt;
+    }
+    auto &resource = it->second;
+    if (static_cast<size_t>(resource.offset) + resource.fileSize > _mapping->size()) {
+        throw ValidationException("RIM resource out of bounds: " + id.string());
+    }
+    auto view = ResourceView();
+    view.data = _mapping->data() + resource.offset;
+    view.size = resource.fileSize;
+    view.owner = _mapping;
+    return view;
+}
+
 } // namespace resource
 
 } // namespace reone
@@ -27,6 +27,7 @@ namespace resource {
 
 void ResourceModule::init() {
     _resources = std::make_unique<Resources>();
+    _resources->setMemoryMapped(true);
     _strings = std::make_unique<Strings>();
     _twoDas = std::make_unique<TwoDAs>(*_resources);
     _gffs = std::make_unique<Gffs>(*_resources);
@@ -27,11 +27,11 @@ namespace resource {
 
 std::shared_ptr<TwoDA> TwoDAs::get(const std::string &resRef) {
     return _cache.getOrAdd(resRef, [this, &resRef]() {
-        auto res = _resources.find(ResourceId(resRef, ResType::TwoDA));
+        auto res = _resources.findView(ResourceId(resRef, ResType::TwoDA));
         if (!res) {
             return std::shared_ptr<TwoDA>();
         }
-        MemoryInputStream stream(res->data);
+        MemoryInputStream stream(res->data, res->size);
         TwoDAReader reader(stream);
         reader.load();
         return reader.twoDA();
@@ -28,17 +28,21 @@ namespace resource {
 std::shared_ptr<Gff> Gffs::get(const std::string &resRef, ResType type) {
     ResourceId resId(resRef, type);
     return _cache.getOrAdd(resId, [this, &resId]() {
-        auto res = _resources.find(resId);
-        if (!res) {
-            return std::shared_ptr<Gff>();
-        }
-        MemoryInputStream stream(res->data);
-        GffReader reader(stream);
-        reader.load();
-        return reader.root();
+        return decode(resId);
     });
 }
 
+std::shared_ptr<Gff> Gffs::decode(const ResourceId &id) {
+    auto res = _resources.findView(id);
+    if (!res) {
+        return nullptr;
+    }
+    MemoryInputStream stream(res->data, res->size);
+    GffReader reader(stream);
+    reader.load();
+    return reader.root();
+}
+
 } // namespace resource
 
 } // namespace reone
@@ -26,11 +26,11 @@ namespace reone {
 namespace resource {
 
 std::shared_ptr<Layout> Layouts::doGet(std::string resRef) {
-    auto res = _resources.find(ResourceId(resRef, ResType::Lyt));
+    auto res = _resources.findView(ResourceId(resRef, ResType::Lyt));
     if (!res) {
         return nullptr;
     }
-    auto stream = MemoryInputStream(res->data);
+    auto stream = MemoryInputStream(res->data, res->size);
     LytReader lyt;
     lyt.load(stream);
     return std::make_shared<Layout>(lyt.layout());
@@ -29,11 +29,11 @@ namespace reone {
 namespace resource {
 
 std::shared_ptr<LipAnimation> Lips::doGet(std::string resRef) {
-    auto res = _resources.find(ResourceId(resRef, ResType::Lip));
+    auto res = _resources.findView(ResourceId(resRef, ResType::Lip));
     if (!res) {
         return nullptr;
     }
-    auto stream = MemoryInputStream(res->data);
+    auto stream = MemoryInputStream(res->data, res->size);
     auto reader = LipReader(stream, resRef);
     reader.load();
     return reader.animation();
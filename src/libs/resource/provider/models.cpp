@@ -44,35 +44,55 @@ std::shared_ptr<Model> Models::get(const std::string &resRef) {
     if (maybeModel != _cache.end()) {
         return maybeModel->second;
     }
-    auto inserted = _cache.insert(std::make_pair(lcResRef, doGet(lcResRef)));
+    auto model = decode(lcResRef);
+    if (model) {
+        finalize(*model);
+    }
+    auto inserted = _cache.insert(std::make_pair(lcResRef, std::move(model)));
     return inserted.first->second;
 }
 
-std::shared_ptr<Model> Models::doGet(const std::string &resRef) {
+std::shared_ptr<Model> Models::decode(const std::string &resRef) {
     debug("Load model " + resRef, LogChannel::Graphics);
 
-    auto mdlRes = _resources.find(ResourceId(resRef, ResType::Mdl));
-    auto mdxRes = _resources.find(ResourceId(resRef, ResType::Mdx));
-    std::shared_ptr<Model> model;
+    auto mdlRes = _resources.findView(ResourceId(resRef, ResType::Mdl));
+    auto mdxRes = _resources.findView(ResourceId(resRef, ResType::Mdx));
+    if (!mdlRes || !mdxRes) {
+        return nullptr;
+    }
+    auto mdl = MemoryInputStream(mdlRes->data, mdlRes->size);
+    auto mdx = MemoryInputStream(mdxRes->data, mdxRes->size);
+    auto reader = MdlMdxReader(mdl, mdx, _statistic);
+    try {
+        reader.load();
+    } catch (const ValidationException &e) {
+        error(str(boost::format("Error loading model %s: %s") % resRef % std::string(e.what())), LogChannel::Graphics);
+        return nullptr;
+    }
+    return reader.model();
+}
 
-    if (mdlRes && mdxRes) {
-        auto mdl = MemoryInputStream(mdlRes->data);
-        auto mdx = MemoryInputStream(mdxRes->data);
-        auto reader = MdlMdxReader(mdl, mdx, _statistic);
-        try {
-            reader.load();
-            model = reader.model();
-            if (!model->superModelName().empty()) {
-                auto superModel = get(model->superModelName());
-                model->setSuperModel(std::move(superModel));
-            }
-            model->init();
-        } catch (const ValidationException &e) {
-            error(str(boost::format("Error loading model %s: %s") % resRef % std::string(e.what())), LogChannel::Graphics);
-        }
+void Models::add(const std::string &resRef, std::shared_ptr<Model> model) {
+    auto lcResRef = boost::to_lower_copy(resRef);
+    if (_cache.count(lcResRef) > 0) {
+        return;
+    }
+    if (model) {
+        finalize(*model);
     }
+    _cache.insert(std::make_pair(std::move(lcResRef), std::move(model)));
+}
 
-    return model;
+bool Models::contains(const std::string &resRef) const {
+    return _cache.count(boost::to_lower_copy(resRef)) > 0;
+}
+
+void Models::finalize(Model &model) {
+    if (!model.superModelName().empty()) {
+        auto superModel = get(model.superModelName());
+        model.setSuperModel(std::move(superModel));
+    }
+    model.init();
 }
 
 } // namespace resource
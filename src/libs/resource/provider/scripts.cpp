@@ -18,6 +18,7 @@
 #include "reone/resource/provider/scripts.h"
 
 #include "reone/script/format/ncsreader.h"
+#include "reone/system/logutil.h"
 #include "reone/system/stream/memoryinput.h"
 
 using namespace reone::script;
@@ -26,15 +27,33 @@ namespace reone {
 
 namespace resource {
 
+void Scripts::enableVerification(IRoutines &routines) {
+    _verifier = std::make_unique<ScriptVerifier>(routines);
+    _objects.clear();
+}
+
 std::shared_ptr<ScriptProgram> Scripts::doGet(std::string resRef) {
-    auto res = _resources.find(ResourceId(resRef, ResType::Ncs));
+    auto res = _resources.findView(ResourceId(resRef, ResType::Ncs));
     if (!res) {
         return nullptr;
     }
-    auto stream = MemoryInputStream(res->data);
+    auto stream = MemoryInputStream(res->data, res->size);
     auto reader = NcsReader(stream, resRef);
     reader.load();
-    return reader.program();
+    auto program = reader.program();
+    if (_verifier) {
+        verify(*program);
+    }
+    return program;
+}
+
+void Scripts::verify(ScriptProgram &program) {
+    try {
+        _verifier->verify(program);
+        program.setVerified(true);
+    } catch (const std::exception &ex) {
+        debug(str(boost::format("Script '%s' not verified, will run with type checks: %s") % program.name() % ex.what()), LogChannel::Script);
+    }
 }
 
 } // namespace resource
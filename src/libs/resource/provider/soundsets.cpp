@@ -30,11 +30,11 @@ namespace reone {
 namespace resource {
 
 std::shared_ptr<SoundSet> SoundSets::doGet(std::string resRef) {
-    auto res = _resources.find(ResourceId(resRef, ResType::Ssf));
+    auto res = _resources.findView(ResourceId(resRef, ResType::Ssf));
     if (!res) {
         return nullptr;
     }
-    auto stream = MemoryInputStream(res->data);
+    auto stream = MemoryInputStream(res->data, res->size);
     auto result = std::make_shared<SoundSet>();
 
     SsfReader ssf(stream);
@@ -52,26 +52,30 @@ std::shared_ptr<Texture> Textures::get(const std::string &resRef, TextureUsage u
         return maybeTexture->second;
     }
     std::string lcResRef(boost::to_lower_copy(resRef));
-    auto inserted = _cache.insert(std::make_pair(lcResRef, doGet(lcResRef, usage)));
+    auto texture = decode(lcResRef, usage);
+    if (texture) {
+        texture->init();
+    }
+    auto inserted = _cache.insert(std::make_pair(lcResRef, std::move(texture)));
 
     return inserted.first->second;
 }
 
-std::shared_ptr<Texture> Textures::doGet(const std::string &resRef, TextureUsage usage) {
+std::shared_ptr<Texture> Textures::decode(const std::string &resRef, TextureUsage usage) {
     std::shared_ptr<Texture> texture;
     std::optional<Texture::Features> features;
 
-    auto txiRes = _resources.find(ResourceId(resRef, ResType::Txi));
+    auto txiRes = _resources.findView(ResourceId(resRef, ResType::Txi));
     if (txiRes) {
-        auto txi = MemoryInputStream(txiRes->data);
+        auto txi = MemoryInputStream(txiRes->data, txiRes->size);
         auto txiReader = TxiReader();
         txiReader.load(txi);
         features = txiReader.features();
     }
 
-    auto tgaRes = _resources.find(ResourceId(resRef, ResType::Tga));
+    auto tgaRes = _resources.findView(ResourceId(resRef, ResType::Tga));
     if (tgaRes) {
-        auto tga = MemoryInputStream(tgaRes->data);
+        auto tga = MemoryInputStream(tgaRes->data, tgaRes->size);
         auto tgaReader = TgaReader(tga, resRef, usage);
         tgaReader.load();
         texture = tgaReader.texture();
@@ -81,9 +85,9 @@ std::shared_ptr<Texture> Textures::doGet(const std::string &resRef, TextureUsage
     }
 
     if (!texture) {
-        auto tpcRes = _resources.find(ResourceId(resRef, ResType::Tpc));
+        auto tpcRes = _resources.findView(ResourceId(resRef, ResType::Tpc));
         if (tpcRes) {
-            auto tpc = MemoryInputStream(tpcRes->data);
+            auto tpc = MemoryInputStream(tpcRes->data, tpcRes->size);
             auto tpcReader = TpcReader(tpc, resRef, usage);
             tpcReader.load();
             texture = tpcReader.texture();
@@ -105,7 +109,6 @@ std::shared_ptr<Texture> Textures::doGet(const std::string &resRef, TextureUsage
         }
         float anisotropy = std::max(1.0f, exp2f(_options.anisotropicFiltering));
         texture->setAnisotropy(anisotropy);
-        texture->init();
     } else {
         warn("Texture not found: " + resRef, LogChannel::Graphics);
     }
@@ -113,6 +116,21 @@ std::shared_ptr<Texture> Textures::doGet(const std::string &resRef, TextureUsage
     return texture;
 }
 
+void Textures::add(const std::string &resRef, std::shared_ptr<Texture> texture) {
+    std::string lcResRef(boost::to_lower_copy(resRef));
+    if (_cache.count(lcResRef) > 0) {
+        return;
+    }
+    if (texture) {
+        texture->init();
+    }
+    _cache.insert(std::make_pair(std::move(lcResRef), std::move(texture)));
+}
+
+bool Textures::contains(const std::string &resRef) const {
+    return _cache.count(boost::to_lower_copy(resRef)) > 0;
+}
+
 } // namespace resource
 
 } // namespace reone
@@ -26,11 +26,11 @@ namespace reone {
 namespace resource {
 
 std::shared_ptr<Visibility> Visibilities::doGet(std::string resRef) {
-    auto res = _resources.find(ResourceId(resRef, ResType::Vis));
+    auto res = _resources.findView(ResourceId(resRef, ResType::Vis));
     if (!res) {
         return nullptr;
     }
-    auto stream = MemoryInputStream(res->data);
+    auto stream = MemoryInputStream(res->data, res->size);
 
     VisReader vis;
     vis.load(stream);
@@ -42,22 +42,30 @@ std::shared_ptr<Walkmesh> Walkmeshes::get(const std::string &resRef, ResType typ
     if (maybeWalkmesh != _cache.end()) {
         return maybeWalkmesh->second;
     }
-    auto inserted = _cache.insert(std::make_pair(lcResRef, doGet(lcResRef, type)));
+    auto inserted = _cache.insert(std::make_pair(lcResRef, decode(lcResRef, type)));
 
     return inserted.first->second;
 }
 
-std::shared_ptr<Walkmesh> Walkmeshes::doGet(const std::string &resRef, ResType type) {
-    auto res = _resources.find(ResourceId(resRef, type));
+std::shared_ptr<Walkmesh> Walkmeshes::decode(const std::string &resRef, ResType type) {
+    auto res = _resources.findView(ResourceId(resRef, type));
     if (!res) {
         return nullptr;
     }
-    auto bwm = MemoryInputStream(res->data);
+    auto bwm = MemoryInputStream(res->data, res->size);
     auto reader = BwmReader(bwm);
     reader.load();
     return reader.walkmesh();
 }
 
+void Walkmeshes::add(const std::string &resRef, std::shared_ptr<Walkmesh> walkmesh) {
+    _cache.insert(std::make_pair(boost::to_lower_copy(resRef), std::move(walkmesh)));
+}
+
+bool Walkmeshes::contains(const std::string &resRef) const {
+    return _cache.count(boost::to_lower_copy(resRef)) > 0;
+}
+
 } // namespace resource
 
 } // namespace reone
@@ -28,34 +28,92 @@ namespace reone {
 
 namespace resource {
 
+static constexpr size_t kPageSize = 4096;
+
+Resources::~Resources() {
+    // Prefetch tasks reference this object, wait for them to complete
+    _prefetchCanceled = true;
+    std::unique_lock<std::mutex> lock {_prefetchMutex};
+    _prefetchCondVar.wait(lock, [this]() { return _numPendingPrefetches == 0; });
+}
+
+void Resources::clear() {
+    std::unique_lock<std::shared_mutex> lock {_containersMutex};
+    clearPrefetched();
+    _index.clear();
+    _containers.clear();
+}
+
+void Resources::clearLocal() {
+    std::unique_lock<std::shared_mutex> lock {_containersMutex};
+    clearPrefetched();
+
+    std::vector<ResourceId> affectedIds;
+    for (auto &[provider, local] : _containers) {
+        if (!local) {
+            continue;
+        }
+        for (auto &id : provider->resourceIds()) {
+            _index.erase(id);
+            affectedIds.push_back(id);
+        }
+    }
+    auto toErase = std::remove_if(_containers.begin(), _containers.end(), [](auto &pair) {
+        return pair.local;
+    });
+    _containers.erase(toErase, _containers.end());
+
+    // Fall back to lower-priority containers for resources that local containers were overriding
+    for (auto &id : affectedIds) {
+        if (_index.count(id) > 0) {
+            continue;
+        }
+        for (auto &[provider, local] : _containers) {
+            if (provider->resourceIds().count(id) > 0) {
+                _index[id] = IndexEntry {provider.get(), local};
+                break;
+            }
+        }
+    }
+}
+
+void Resources::add(std::unique_ptr<IResourceContainer> provider, bool local) {
+    std::unique_lock<std::shared_mutex> lock {_containersMutex};
+    clearPrefetched();
+    for (auto &id : provider->resourceIds()) {
+        _index[id] = IndexEntry {provider.get(), local};
+    }
+    _containers.push_front(ResourceContainerLocalPair {std::move(provider), local});
+}
+
 void Resources::addKEY(const std::filesystem::path &path) {
-    auto provider = std::make_unique<KeyBifResourceContainer>(path);
+    auto provider = std::make_unique<KeyBifResourceContainer>(path, _memoryMapped);
     provider->init();
-    _containers.push_front(ResourceContainerLocalPair {std::move(provider), false});
+    add(std::move(provider));
 }
 
 void Resources::addERF(const std::filesystem::path &path, bool local) {
-    auto provider = std::make_unique<ErfResourceContainer>(path);
+    auto provider = std::make_unique<ErfResourceContainer>(path, _memoryMapped);
     provider->init();
-    _containers.push_front(ResourceContainerLocalPair {std::move(provider), local});
+    add(std::move(provider), local);
 }
 
 void Resources::addRIM(const std::filesystem::path &path, bool local) {
-    auto provider = std::make_unique<RimResourceContainer>(path);
+    auto provider = std::make_unique<RimResourceContainer>(path, _memoryMapped);
     provider->init();
-    _containers.push_front(ResourceContainerLocalPair {std::move(provider), local});
+    add(std::move(provider), local);
 }
 
 void Resources::addEXE(const std::filesystem::path &path) {
     auto provider = std::make_unique<ExeResourceContainer>(path);
     provider->init();
-    _containers.push_front(ResourceContainerLocalPair {std::move(provider), false});
+    add(std::move(provider));
 }
 
 void Resources::addFolder(const std::filesystem::path &path) {
     auto provider = std::make_unique<FolderResourceContainer>(path);
     provider->init();
-    _containers.push_front(ResourceContainerLocalPair {std::move(provider), false});
+    add(std::move(provider));
 }
 
 Resource Resources::get(const ResourceId &id) {
@@ -67,13 +125,126 @@ Resource Resources::get(const ResourceId &id) {
 }
 
 std::optional<Resource> Resources::find(const ResourceId &id) {
-    for (auto &[provider, local] : _containers) {
-        auto data = provider->findResourceData(id);
-        if (data) {
-            return Resource {*data, local};
-        }
+    auto prefetched = takePrefetched(id);
+    if (prefetched) {
+        return Resource {ByteBuffer(prefetched->data, prefetched->data + prefetched->size), prefetched->local};
+    }
+    std::shared_lock<std::shared_mutex> lock {_containersMutex};
+    auto it = _index.find(id);
+    if (it == _index.end()) {
+        return std::nullopt;
     }
-    return std::nullopt;
+    auto data = it->second.container->findResourceData(id);
+    if (!data) {
+        return std::nullopt;
+    }
+    return Resource {std::move(*data), it->second.local};
+}
+
+std::optional<ResourceView> Resources::findView(const ResourceId &id) {
+    auto prefetched = takePrefetched(id);
+    if (prefetched) {
+        return prefetched;
+    }
+    return findIndexedView(id);
+}
+
+std::optional<ResourceView> Resources::findIndexedView(const ResourceId &id) {
+    std::shared_lock<std::shared_mutex> lock {_containersMutex};
+    auto it = _index.find(id);
+    if (it == _index.end()) {
+        return std::nullopt;
+    }
+    auto view = it->second.container->findResourceView(id);
+    if (view) {
+        view->local = it->second.local;
+    }
+    return view;
+}
+
+std::vector<std::future<bool>> Resources::prefetch(const std::vector<ResourceId> &ids, IThreadPool &threadPool) {
+    std::vector<std::future<bool>> futures;
+    futures.reserve(ids.size());
+    for (auto &id : ids) {
+        auto promise = std::make_shared<std::promise<bool>>();
+        futures.push_back(promise->get_future());
+        auto pending = std::make_shared<PendingPrefetch>(*this);
+        threadPool.enqueue([this, id, promise, pending](auto &canceled) {
+            if (canceled || _prefetchCanceled) {
+                promise->set_value(false);
+            } else {
+                try {
+                    int generation = _prefetchGeneration;
+                    auto view = findIndexedView(id);
+                    if (view) {
+                        // Fault in pages of memory-mapped resources on the worker thread
+                        volatile char sink = 0;
+                        for (size_t offset = 0; offset < view->size; offset += kPageSize) {
+                            sink = view->data[offset];
+                        }
+                        addPrefetched(id, std::move(*view), generation);
+                    }
+                    promise->set_value(static_cast<bool>(view));
+                } catch (...) {
+                    promise->set_exception(std::current_exception());
+                }
+            }
+        });
+    }
+    return futures;
+}
+
+Resources::PendingPrefetch::PendingPrefetch(Resources &resources) :
+    _resources(resources) {
+    std::lock_guard<std::mutex> lock {_resources._prefetchMutex};
+    ++_resources._numPendingPrefetches;
+}
+
+Resources::PendingPrefetch::~PendingPrefetch() {
+    std::lock_guard<std::mutex> lock {_resources._prefetchMutex};
+    --_resources._numPendingPrefetches;
+    _resources._prefetchCondVar.notify_all();
+}
+
+std::optional<ResourceView> Resources::takePrefetched(const ResourceId &id) {
+    std::lock_guard<std::mutex> lock {_prefetchMutex};
+    auto it = _prefetched.find(id);
+    if (it == _prefetched.end()) {
+        return std::nullopt;
+    }
+    auto view = std::move(it->second.view);
+    _prefetchOrder.erase(it->second.orderIt);
+    _prefetched.erase(it);
+    _prefetchedBytes -= view.size;
+    return view;
+}
+
+void Resources::addPrefetched(const ResourceId &id, ResourceView view, int generation) {
+    std::lock_guard<std::mutex> lock {_prefetchMutex};
+    if (generation != _prefetchGeneration) {
+        // Containers have changed since the resource was looked up
+        return;
+    }
+    if (view.size > _prefetchCapacity || _prefetched.count(id) > 0) {
+        return;
+    }
+    while (_prefetchedBytes + view.size > _prefetchCapacity) {
+        auto oldest = _prefetched.find(_prefetchOrder.front());
+        _prefetchedBytes -= oldest->second.view.size;
+        _prefetched.erase(oldest);
+        _prefetchOrder.pop_front();
+    }
+    _prefetchedBytes += view.size;
+    auto orderIt = _prefetchOrder.insert(_prefetchOrder.end(), id);
+    _prefetched.insert(std::make_pair(id, PrefetchedResource {std::move(view), orderIt}));
+}
+
+void Resources::clearPrefetched() {
+    std::lock_guard<std::mutex> lock {_prefetchMutex};
+    ++_prefetchGeneration;
+    _prefetched.clear();
+    _prefetchOrder.clear();
+    _prefetchedBytes = 0;
 }
 
 } // namespace resource
@@ -40,7 +40,8 @@ void SceneModule::init() {
         _graphicsOpt,
         _graphics.services(),
         _audio.services(),
-        _resource.services());
+        _resource.services(),
+        _system.services().threadPool);
 
     _services = std::make_unique<SceneServices>(*_graphs, *_renderPipelineFactory);
 
@@ -40,6 +40,7 @@
 #include "reone/scene/node/walkmesh.h"
 #include "reone/scene/render/pipeline.h"
 #include "reone/system/logutil.h"
+#include "reone/system/threadpool.h"
 
 using namespace reone::graphics;
 
@@ -55,12 +56,18 @@ static constexpr float kElevationTestZ = 1024.0f;
 
 static constexpr float kLightRadiusBias = 64.0f;
 
+static constexpr size_t kAnimationGrainSize = 4;
+
 static constexpr float kMaxCollisionDistanceWalk = 8.0f;
 static constexpr float kMaxCollisionDistanceWalk2 = kMaxCollisionDistanceWalk * kMaxCollisionDistanceWalk;
 
 static constexpr float kMaxCollisionDistanceLineOfSight = 16.0f;
 static constexpr float kMaxCollisionDistanceLineOfSight2 = kMaxCollisionDistanceLineOfSight * kMaxCollisionDistanceLineOfSight;
 
+static constexpr float kWalkmeshGridCellSize = 16.0f;
+static constexpr float kMaxWalkmeshGridCells = 64.0f;
+static constexpr size_t kCollisionBatchGrainSize = 32;
+
 static constexpr float kPointLightShadowsFOV = glm::radians(90.0f);
 static constexpr float kPointLightShadowsNearPlane = 0.25f;
 static constexpr float kPointLightShadowsFarPlane = 2500.0f;
@@ -74,6 +81,7 @@ static const std::vector<float> g_shadowCascadeDivisors {
 void SceneGraph::clear() {
     _modelRoots.clear();
     _walkmeshRoots.clear();
+    rebuildWalkmeshGrid();
     _soundRoots.clear();
     _grassRoots.clear();
     _activeLights.clear();
@@ -85,6 +93,7 @@ void SceneGraph::addRoot(std::shared_ptr<ModelSceneNode> node) {
 
 void SceneGraph::addRoot(std::shared_ptr<WalkmeshSceneNode> node) {
     _walkmeshRoots.push_back(node);
+    rebuildWalkmeshGrid();
 }
 
 void SceneGraph::addRoot(std::shared_ptr<TriggerSceneNode> node) {
@@ -120,6 +129,7 @@ void SceneGraph::removeRoot(WalkmeshSceneNode &node) {
         _walkmeshRoots.end(),
         [&node](auto &root) { return root.get() == &node; });
     _walkmeshRoots.erase(it, _walkmeshRoots.end());
+    rebuildWalkmeshGrid();
 }
 
 void SceneGraph::removeRoot(TriggerSceneNode &node) {
@@ -148,9 +158,7 @@ void SceneGraph::removeRoot(SoundSceneNode &node) {
 
 void SceneGraph::update(float dt) {
     if (_updateRoots) {
-        for (auto &root : _modelRoots) {
-            root->update(dt);
-        }
+        updateModelRoots(dt);
         for (auto &root : _grassRoots) {
             root->update(dt);
         }
@@ -158,6 +166,7 @@ void SceneGraph::update(float dt) {
             root->update(dt);
         }
     }
+    computeAbsoluteTransforms();
     if (!_activeCamera) {
         return;
     }
@@ -171,6 +180,34 @@ void SceneGraph::update(float dt) {
     prepareTransparentLeafs();
 }
 
+void SceneGraph::updateModelRoots(float dt) {
+    // Model roots are independent of each other, so their animations and
+    // bone transforms are evaluated in parallel. The rest of the update
+    // spawns particles and signals events, and therefore stays serial.
+    if (_threadPool) {
+        parallelFor(*_threadPool, _modelRoots.size(), kAnimationGrainSize, [this, dt](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                _modelRoots[i]->evaluateAnimations(dt);
+            }
+        });
+    }
+    for (auto &root : _modelRoots) {
+        root->update(dt);
+    }
+}
+
+void SceneGraph::computeAbsoluteTransforms() {
+    // Transforms invalidated during this frame are resolved once here,
+    // rather than every time a local transform changes. Roots without
+    // invalidated transforms return immediately.
+    for (auto &root : _modelRoots) {
+        root->computeAbsoluteTransforms();
+    }
+    for (auto &root : _walkmeshRoots) {
+        root->computeAbsoluteTransforms();
+    }
+}
+
 void SceneGraph::cullRoots() {
     for (auto &root : _modelRoots) {
         bool culled =
@@ -538,7 +575,7 @@ void SceneGraph::renderOpaque(IRenderPass &pass) {
     if (_renderWalkmeshes || _renderTriggers) {
         _graphicsSvc.uniforms.setWalkmesh([this](auto &walkmesh) {
             for (int i = 0; i < kMaxWalkmeshMaterials - 1; ++i) {
-                walkmesh.materials[i] = _walkableSurfaces.count(i) > 0 ? glm::vec4(0.0f, 1.0f, 0.0f, 1.0f) : glm::vec4(1.0f, 0.0f, 0.0f, 1.0f);
+                walkmesh.materials[i] = Walkmesh::hasSurface(_walkableSurfaces, i) ? glm::vec4(0.0f, 1.0f, 0.0f, 1.0f) : glm::vec4(1.0f, 0.0f, 0.0f, 1.0f);
             }
             walkmesh.materials[kMaxWalkmeshMaterials - 1] = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f); // triggers
         });
@@ -754,114 +791,251 @@ std::vector<LightSceneNode *> SceneGraph::computeClosestLights(int count, const
     return lights;
 }
 
-bool SceneGraph::testElevation(const glm::vec2 &position, Collision &outCollision) const {
-    static glm::vec3 down(0.0f, 0.0f, -1.0f);
-
-    bool walkable = false;
-    float minDistance = std::numeric_limits<float>::max();
+static glm::ivec2 getWalkmeshGridCell(const glm::vec2 &point, const glm::vec2 &origin, float cellSize, const glm::ivec2 &numCells) {
+    glm::ivec2 cell(glm::floor((point - origin) / cellSize));
+    return glm::clamp(cell, glm::ivec2(0), numCells - 1);
+}
 
-    glm::vec3 origin {position, kElevationTestZ};
+void SceneGraph::rebuildWalkmeshGrid() {
+    auto &grid = _walkmeshGrid;
+    grid.roots.clear();
+    grid.rootBounds.clear();
+    grid.rootCells.clear();
+    grid.cellOffsets.clear();
+    grid.cellRoots.clear();
+    grid.numCells = glm::ivec2(0);
+    _dynamicWalkmeshRoots.clear();
+
+    glm::vec2 min(std::numeric_limits<float>::max());
+    glm::vec2 max(std::numeric_limits<float>::lowest());
     for (auto &root : _walkmeshRoots) {
-        if (!root->isEnabled()) {
+        auto &walkmesh = root->walkmesh();
+        if (!walkmesh.isAreaWalkmesh() || walkmesh.aabb().isDegenerate()) {
+            _dynamicWalkmeshRoots.push_back(root.get());
             continue;
         }
-        if (!root->walkmesh().isAreaWalkmesh()) {
-            float distance2 = root->getSquareDistanceTo2D(position);
-            if (distance2 > kMaxCollisionDistanceWalk2) {
-                continue;
+        auto aabb = walkmesh.aabb() * root->absoluteTransform();
+        grid.roots.push_back(root.get());
+        grid.rootBounds.push_back(glm::vec4(aabb.min().x, aabb.min().y, aabb.max().x, aabb.max().y));
+        min = glm::min(min, glm::vec2(aabb.min()));
+        max = glm::max(max, glm::vec2(aabb.max()));
+    }
+    if (grid.roots.empty()) {
+        return;
+    }
+    glm::vec2 extent(max - min);
+    grid.origin = min;
+    grid.cellSize = std::max(kWalkmeshGridCellSize, std::max(extent.x, extent.y) / kMaxWalkmeshGridCells);
+    grid.numCells = glm::max(glm::ivec2(1), glm::ivec2(glm::ceil(extent / grid.cellSize)));
+
+    // Count roots per cell, then distribute roots into cells
+    grid.cellOffsets.assign(grid.numCells.x * grid.numCells.y + 1, 0);
+    for (auto &bounds : grid.rootBounds) {
+        auto minCell = getWalkmeshGridCell(glm::vec2(bounds.x, bounds.y), grid.origin, grid.cellSize, grid.numCells);
+        auto maxCell = getWalkmeshGridCell(glm::vec2(bounds.z, bounds.w), grid.origin, grid.cellSize, grid.numCells);
+        grid.rootCells.push_back(glm::ivec4(minCell, maxCell));
+        for (int y = minCell.y; y <= maxCell.y; ++y) {
+            for (int x = minCell.x; x <= maxCell.x; ++x) {
+                ++grid.cellOffsets[y * grid.numCells.x + x + 1];
             }
         }
-        auto objSpaceOrigin = glm::vec3(root->absoluteTransformInverse() * glm::vec4(origin, 1.0f));
-        float distance = 0.0f;
-        auto face = root->walkmesh().raycast(_walkcheckSurfaces, objSpaceOrigin, down, 2.0f * kElevationTestZ, distance);
-        if (!face || distance >= minDistance) {
-            continue;
+    }
+    for (size_t i = 1; i < grid.cellOffsets.size(); ++i) {
+        grid.cellOffsets[i] += grid.cellOffsets[i - 1];
+    }
+    grid.cellRoots.resize(grid.cellOffsets.back());
+    std::vector<int> cellSizes(grid.cellOffsets.size(), 0);
+    for (int rootIdx = 0; rootIdx < static_cast<int>(grid.roots.size()); ++rootIdx) {
+        auto &cells = grid.rootCells[rootIdx];
+        for (int y = cells.y; y <= cells.w; ++y) {
+            for (int x = cells.x; x <= cells.z; ++x) {
+                int cell = y * grid.numCells.x + x;
+                grid.cellRoots[grid.cellOffsets[cell] + cellSizes[cell]++] = rootIdx;
+            }
         }
-        walkable = _walkableSurfaces.count(face->material) > 0;
-        if (walkable) {
-            outCollision.user = root->user();
-            outCollision.intersection = origin + distance * down;
-            outCollision.normal = root->absoluteTransform() * glm::vec4 {face->normal, 0.0f};
-            outCollision.material = face->material;
+    }
+}
+
+template <class Fn>
+void SceneGraph::forEachWalkmeshRoot(const glm::vec2 &min, const glm::vec2 &max, const Fn &fn) const {
+    auto &grid = _walkmeshGrid;
+    if (!grid.roots.empty()) {
+        auto minCell = getWalkmeshGridCell(min, grid.origin, grid.cellSize, grid.numCells);
+        auto maxCell = getWalkmeshGridCell(max, grid.origin, grid.cellSize, grid.numCells);
+        for (int y = minCell.y; y <= maxCell.y; ++y) {
+            for (int x = minCell.x; x <= maxCell.x; ++x) {
+                int cell = y * grid.numCells.x + x;
+                for (int i = grid.cellOffsets[cell]; i < grid.cellOffsets[cell + 1]; ++i) {
+                    int rootIdx = grid.cellRoots[i];
+                    auto &bounds = grid.rootBounds[rootIdx];
+                    if (max.x < bounds.x || max.y < bounds.y || min.x > bounds.z || min.y > bounds.w) {
+                        continue;
+                    }
+                    // Roots spanning multiple cells are only visited in the first cell shared with the query
+                    auto &cells = grid.rootCells[rootIdx];
+                    if (x != std::max(cells.x, minCell.x) || y != std::max(cells.y, minCell.y)) {
+                        continue;
+                    }
+                    fn(*grid.roots[rootIdx]);
+                }
+            }
         }
-        minDistance = distance;
     }
+    for (auto &root : _dynamicWalkmeshRoots) {
+        fn(*root);
+    }
+}
 
+bool SceneGraph::testElevation(const glm::vec2 &position, Collision &outCollision) const {
+    glm::vec3 origin {position, kElevationTestZ};
+    float minDistance = std::numeric_limits<float>::max();
+    bool walkable = false;
+    forEachWalkmeshRoot(position, position, [&](auto &root) {
+        testElevation(root, origin, minDistance, walkable, outCollision);
+    });
     return walkable;
 }
 
+void SceneGraph::testElevation(WalkmeshSceneNode &root, const glm::vec3 &origin, float &inOutMinDistance, bool &outWalkable, Collision &outCollision) const {
+    static glm::vec3 down(0.0f, 0.0f, -1.0f);
+
+    if (!root.isEnabled()) {
+        return;
+    }
+    if (!root.walkmesh().isAreaWalkmesh()) {
+        float distance2 = root.getSquareDistanceTo2D(glm::vec2(origin));
+        if (distance2 > kMaxCollisionDistanceWalk2) {
+            return;
+        }
+    }
+    auto objSpaceOrigin = glm::vec3(root.absoluteTransformInverse() * glm::vec4(origin, 1.0f));
+    float distance = 0.0f;
+    auto face = root.walkmesh().raycast(_walkcheckSurfaces, objSpaceOrigin, down, 2.0f * kElevationTestZ, distance);
+    if (!face || distance >= inOutMinDistance) {
+        return;
+    }
+    outWalkable = Walkmesh::hasSurface(_walkableSurfaces, face->material);
+    if (outWalkable) {
+        outCollision.user = root.user();
+        outCollision.intersection = origin + distance * down;
+        outCollision.normal = root.absoluteTransform() * glm::vec4 {face->normal, 0.0f};
+        outCollision.material = face->material;
+    }
+    inOutMinDistance = distance;
+}
+
 bool SceneGraph::testLineOfSight(const glm::vec3 &origin, const glm::vec3 &dest, Collision &outCollision) const {
+    float minDistance = std::numeric_limits<float>::max();
+    forEachWalkmeshRoot(glm::min(glm::vec2(origin), glm::vec2(dest)), glm::max(glm::vec2(origin), glm::vec2(dest)), [&](auto &root) {
+        testLineOfSight(root, origin, dest, minDistance, outCollision);
+    });
+    return minDistance != std::numeric_limits<float>::max();
+}
+
+void SceneGraph::testLineOfSight(WalkmeshSceneNode &root, const glm::vec3 &origin, const glm::vec3 &dest, float &inOutMinDistance, Collision &outCollision) const {
+    if (!root.isEnabled()) {
+        return;
+    }
     auto originToDest = dest - origin;
     auto dir = glm::normalize(originToDest);
     float maxDistance = glm::length(originToDest);
-    float minDistance = std::numeric_limits<float>::max();
-
-    for (auto &root : _walkmeshRoots) {
-        if (!root->isEnabled()) {
-            continue;
-        }
-        glm::vec3 originLocal;
-        glm::vec3 dirLocal;
-        if (root->walkmesh().isAreaWalkmesh()) {
-            if (!root->walkmesh().contains(origin) &&
-                !root->walkmesh().contains(dest)) {
-                continue;
-            }
-            originLocal = origin;
-            dirLocal = dir;
-        } else {
-            if (root->getSquareDistanceTo(origin) > kMaxCollisionDistanceLineOfSight2) {
-                continue;
-            }
-            originLocal = root->absoluteTransformInverse() * glm::vec4 {origin, 1.0f};
-            dirLocal = root->absoluteTransformInverse() * glm::vec4 {dir, 0.0f};
+    glm::vec3 originLocal;
+    glm::vec3 dirLocal;
+    if (root.walkmesh().isAreaWalkmesh()) {
+        if (!root.walkmesh().contains(origin) &&
+            !root.walkmesh().contains(dest)) {
+            return;
         }
-        float distance = 0.0f;
-        auto face = root->walkmesh().raycast(_lineOfSightSurfaces, originLocal, dirLocal, maxDistance, distance);
-        if (!face || distance > minDistance) {
-            continue;
+        originLocal = origin;
+        dirLocal = dir;
+    } else {
+        if (root.getSquareDistanceTo(origin) > kMaxCollisionDistanceLineOfSight2) {
+            return;
         }
-        outCollision.user = root->user();
-        outCollision.intersection = origin + distance * dir;
-        outCollision.normal = root->absoluteTransform() * glm::vec4(face->normal, 0.0f);
-        outCollision.material = face->material;
-        minDistance = distance;
+        originLocal = root.absoluteTransformInverse() * glm::vec4 {origin, 1.0f};
+        dirLocal = root.absoluteTransformInverse() * glm::vec4 {dir, 0.0f};
+    }
+    float distance = 0.0f;
+    auto face = root.walkmesh().raycast(_lineOfSightSurfaces, originLocal, dirLocal, maxDistance, distance);
+    if (!face || distance > inOutMinDistance) {
+        return;
     }
+    outCollision.user = root.user();
+    outCollision.intersection = origin + distance * dir;
+    outCollision.normal = root.absoluteTransform() * glm::vec4(face->normal, 0.0f);
+    outCollision.material = face->material;
+    inOutMinDistance = distance;
+}
 
+bool SceneGraph::testWalk(const glm::vec3 &origin, const glm::vec3 &dest, const IUser *excludeUser, Collision &outCollision) const {
+    float minDistance = std::numeric_limits<float>::max();
+    forEachWalkmeshRoot(glm::min(glm::vec2(origin), glm::vec2(dest)), glm::max(glm::vec2(origin), glm::vec2(dest)), [&](auto &root) {
+        testWalk(root, origin, dest, excludeUser, minDistance, outCollision);
+    });
     return minDistance != std::numeric_limits<float>::max();
 }
 
-bool SceneGraph::testWalk(const glm::vec3 &origin, const glm::vec3 &dest, const IUser *excludeUser, Collision &outCollision) const {
+void SceneGraph::testWalk(WalkmeshSceneNode &root, const glm::vec3 &origin, const glm::vec3 &dest, const IUser *excludeUser, float &inOutMinDistance, Collision &outCollision) const {
+    if (!root.isEnabled() || root.user() == excludeUser) {
+        return;
+    }
+    if (!root.walkmesh().isAreaWalkmesh()) {
+        float distance2 = root.getSquareDistanceTo(origin);
+        if (distance2 > kMaxCollisionDistanceWalk2) {
+            return;
+        }
+    }
     glm::vec3 originToDest(dest - origin);
     glm::vec3 dir(glm::normalize(originToDest));
     float maxDistance = glm::length(originToDest);
-    float minDistance = std::numeric_limits<float>::max();
+    glm::vec3 objSpaceOrigin(root.absoluteTransformInverse() * glm::vec4(origin, 1.0f));
+    glm::vec3 objSpaceDir(root.absoluteTransformInverse() * glm::vec4(dir, 0.0f));
+    float distance = 0.0f;
+    auto face = root.walkmesh().raycast(_walkcheckSurfaces, objSpaceOrigin, objSpaceDir, kMaxCollisionDistanceWalk, distance);
+    if (!face || distance > maxDistance || distance > inOutMinDistance) {
+        return;
+    }
+    outCollision.user = root.user();
+    outCollision.intersection = origin + distance * dir;
+    outCollision.normal = root.absoluteTransform() * glm::vec4(face->normal, 0.0f);
+    outCollision.material = face->material;
+    inOutMinDistance = distance;
+}
 
-    for (auto &root : _walkmeshRoots) {
-        if (!root->isEnabled() || root->user() == excludeUser) {
-            continue;
-        }
-        if (!root->walkmesh().isAreaWalkmesh()) {
-            float distance2 = root->getSquareDistanceTo(origin);
-            if (distance2 > kMaxCollisionDistanceWalk2) {
-                continue;
-            }
-        }
-        glm::vec3 objSpaceOrigin(root->absoluteTransformInverse() * glm::vec4(origin, 1.0f));
-        glm::vec3 objSpaceDir(root->absoluteTransformInverse() * glm::vec4(dir, 0.0f));
-        float distance = 0.0f;
-        auto face = root->walkmesh().raycast(_walkcheckSurfaces, objSpaceOrigin, objSpaceDir, kMaxCollisionDistanceWalk, distance);
-        if (!face || distance > maxDistance || distance > minDistance) {
-            continue;
+void SceneGraph::testElevationBatch(std::vector<CollisionQuery> &queries, IThreadPool *threadPool) const {
+    processBatch(queries, threadPool, [this](auto &query) {
+        query.result = testElevation(glm::vec2(query.origin), query.collision);
+    });
+}
+
+void SceneGraph::testLineOfSightBatch(std::vector<CollisionQuery> &queries, IThreadPool *threadPool) const {
+    processBatch(queries, threadPool, [this](auto &query) {
+        query.result = testLineOfSight(query.origin, query.dest, query.collision);
+    });
+}
+
+void SceneGraph::testWalkBatch(std::vector<CollisionQuery> &queries, IThreadPool *threadPool) const {
+    processBatch(queries, threadPool, [this](auto &query) {
+        query.result = testWalk(query.origin, query.dest, query.excludeUser, query.collision);
+    });
+}
+
+void SceneGraph::processBatch(std::vector<CollisionQuery> &queries, IThreadPool *threadPool, const std::function<void(CollisionQuery &)> &fn) const {
+    if (!threadPool) {
+        for (auto &query : queries) {
+            fn(query);
         }
-        outCollision.user = root->user();
-        outCollision.intersection = origin + distance * dir;
-        outCollision.normal = root->absoluteTransform() * glm::vec4(face->normal, 0.0f);
-        outCollision.material = face->material;
-        minDistance = distance;
+        return;
     }
-
-    return minDistance != std::numeric_limits<float>::max();
+    // Walkmesh transforms are resolved lazily, which is not safe to do from worker threads
+    for (auto &root : _walkmeshRoots) {
+        root->absoluteTransformInverse();
+    }
+    parallelFor(*threadPool, queries.size(), kCollisionBatchGrainSize, [&queries, &fn](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            fn(queries[i]);
+        }
+    });
 }
 
 ModelSceneNode *SceneGraph::pickModelAt(int x, int y, IUser *except) const {
@@ -31,7 +31,8 @@ void SceneGraphs::reserve(std::string name) {
         _graphicsOpt,
         _graphicsSvc,
         _audioSvc,
-        _resourceSvc);
+        _resourceSvc,
+        &_threadPool);
 
     _scenes.insert(std::make_pair(name, std::move(scene)));
 }
@@ -22,41 +22,39 @@ namespace reone {
 namespace scene {
 
 void SceneNode::addChild(SceneNode &node) {
-    node._parent = this;
-    node.computeAbsoluteTransforms();
-    _children.insert(&node);
-}
-
-void SceneNode::computeAbsoluteTransforms() {
-    if (_parent) {
-        _absTransform = _parent->_absTransform * _localTransform;
-    } else {
-        _absTransform = _localTransform;
+    if (node._parent == this) {
+        return;
     }
-    _absTransformInv = glm::inverse(_absTransform);
-
-    for (auto &child : _children) {
-        child->computeAbsoluteTransforms();
+    if (node._parent) {
+        node._parent->removeChild(node);
+    }
+    node._parent = this;
+    node._childIndex = _children.size();
+    node.invalidateAbsoluteTransforms();
+    _children.push_back(&node);
+    if (node._subtreeDirty) {
+        markSubtreeDirty();
     }
-
-    onAbsoluteTransformChanged();
 }
 
 void SceneNode::removeChild(SceneNode &node) {
-    auto maybeChild = _children.find(&node);
-    if (maybeChild == _children.end()) {
+    if (node._parent != this) {
         return;
     }
-    auto child = *maybeChild;
-    child->_parent = nullptr;
-    child->computeAbsoluteTransforms();
-    _children.erase(maybeChild);
+    // Move last child in place of the removed one
+    auto last = _children.back();
+    _children[node._childIndex] = last;
+    last->_childIndex = node._childIndex;
+    _children.pop_back();
+
+    node._parent = nullptr;
+    node.invalidateAbsoluteTransforms();
 }
 
 void SceneNode::removeAllChildren() {
     for (auto &child : _children) {
         child->_parent = nullptr;
-        child->computeAbsoluteTransforms();
+        child->invalidateAbsoluteTransforms();
     }
     _children.clear();
 }
@@ -68,11 +66,11 @@ void SceneNode::update(float dt) {
 }
 
 glm::vec3 SceneNode::origin() const {
-    return glm::vec3(_absTransform[3]);
+    return glm::vec3(absoluteTransform()[3]);
 }
 
 glm::vec2 SceneNode::origin2D() const {
-    return glm::vec2(_absTransform[3]);
+    return glm::vec2(absoluteTransform()[3]);
 }
 
 float SceneNode::getDistanceTo(const glm::vec3 &point) const {
@@ -96,12 +94,60 @@ float SceneNode::getSquareDistanceTo2D(const glm::vec2 &point) const {
 }
 
 glm::vec3 SceneNode::getWorldCenterOfAABB() const {
-    return _absTransform * glm::vec4(0.5f * (_aabb.min() + _aabb.max()), 1.0f);
+    return absoluteTransform() * glm::vec4(0.5f * (_aabb.min() + _aabb.max()), 1.0f);
+}
+
+const glm::mat4 &SceneNode::absoluteTransform() const {
+    if (_absTransformDirty) {
+        _absTransform = _parent ? _parent->absoluteTransform() * _localTransform : _localTransform;
+        _absTransformDirty = false;
+    }
+    return _absTransform;
+}
+
+const glm::mat4 &SceneNode::absoluteTransformInverse() const {
+    if (_absTransformInvDirty) {
+        // Scene node transforms are composed of translation, rotation and scale only
+        _absTransformInv = glm::affineInverse(absoluteTransform());
+        _absTransformInvDirty = false;
+    }
+    return _absTransformInv;
 }
 
 void SceneNode::setLocalTransform(glm::mat4 transform) {
     _localTransform = std::move(transform);
-    computeAbsoluteTransforms();
+    invalidateAbsoluteTransforms();
+}
+
+void SceneNode::invalidateAbsoluteTransforms() {
+    _absTransformInvDirty = true;
+    if (_absTransformDirty) {
+        return;
+    }
+    _absTransformDirty = true;
+    markSubtreeDirty();
+    for (auto &child : _children) {
+        child->invalidateAbsoluteTransforms();
+    }
+    onAbsoluteTransformChanged();
+}
+
+void SceneNode::markSubtreeDirty() {
+    // Ancestors of a node with invalidated subtree are always marked already
+    for (auto node = this; node && !node->_subtreeDirty; node = node->_parent) {
+        node->_subtreeDirty = true;
+    }
+}
+
+void SceneNode::computeAbsoluteTransforms() {
+    if (!_subtreeDirty) {
+        return;
+    }
+    _subtreeDirty = false;
+    absoluteTransform();
+    for (auto &child : _children) {
+        child->computeAbsoluteTransforms();
+    }
 }
 
 } // namespace scene
@@ -26,34 +26,41 @@ namespace reone {
 
 namespace scene {
 
-void CameraSceneNode::onAbsoluteTransformChanged() {
-    if (_camera) {
-        _camera->setView(_absTransformInv);
+std::shared_ptr<Camera> CameraSceneNode::camera() const {
+    if (_camera && _viewDirty) {
+        _camera->setView(absoluteTransformInverse());
+        _viewDirty = false;
     }
+    return _camera;
+}
+
+void CameraSceneNode::onAbsoluteTransformChanged() {
+    _viewDirty = true;
 }
 
 bool CameraSceneNode::isInFrustum(const SceneNode &other) const {
-    if (!_camera) {
+    auto camera = this->camera();
+    if (!camera) {
         return false;
     }
     if (other.isPoint()) {
-        return _camera->isInFrustum(other.origin());
+        return camera->isInFrustum(other.origin());
     } else {
-        return _camera->isInFrustum(other.aabb() * other.absoluteTransform());
+        return camera->isInFrustum(other.aabb() * other.absoluteTransform());
     }
 }
 
 void CameraSceneNode::setOrthographicProjection(float left, float right, float bottom, float top, float zNear, float zFar) {
     auto camera = std::make_unique<OrthographicCamera>();
     camera->setProjection(left, right, bottom, top, zNear, zFar);
-    camera->setView(_absTransformInv);
+    camera->setView(absoluteTransformInverse());
     _camera = std::move(camera);
 }
 
 void CameraSceneNode::setPerspectiveProjection(float fovy, float aspect, float zNear, float zFar) {
     auto camera = std::make_shared<PerspectiveCamera>();
     camera->setProjection(fovy, aspect, zNear, zFar);
-    camera->setView(_absTransformInv);
+    camera->setView(absoluteTransformInverse());
     _camera = std::move(camera);
 }
 
@@ -196,7 +196,7 @@ void EmitterSceneNode::spawnLightningParticles() {
     float halfW = 0.005f * _size.x;
     float halfH = 0.005f * _size.y;
     glm::vec3 origin(randomFloat(-halfW, halfW), randomFloat(-halfH, halfH), 0.0f);
-    glm::vec3 emitterSpaceRefPos(_absTransformInv * glm::vec4((*ref)->origin(), 1.0f));
+    glm::vec3 emitterSpaceRefPos(absoluteTransformInverse() * glm::vec4((*ref)->origin(), 1.0f));
     glm::vec3 refToOrigin(emitterSpaceRefPos - origin);
     float distance = glm::abs(refToOrigin.z);
     float segmentLength = distance / static_cast<float>(_lightningSubDiv + 1);
@@ -217,15 +217,16 @@ void EmitterSceneNode::spawnLightningParticles() {
     segments[_lightningSubDiv].second = emitterSpaceRefPos;
 
     // Return all particles to pool
-    for (auto it = _children.begin(); it != _children.end();) {
-        auto child = *it;
-        if ((*it)->type() == SceneNodeType::Particle) {
-            _particlePool.push_back(static_cast<ParticleSceneNode *>(child));
-            it = _children.erase(it);
-        } else {
-            ++it;
+    std::vector<ParticleSceneNode *> particles;
+    for (auto &child : _children) {
+        if (child->type() == SceneNodeType::Particle) {
+            particles.push_back(static_cast<ParticleSceneNode *>(child));
         }
     }
+    for (auto &particle : particles) {
+        removeChild(*particle);
+        _particlePool.push_back(particle);
+    }
 
     for (auto &segment : segments) {
         // Take particle from the pool, if available
@@ -239,7 +240,7 @@ void EmitterSceneNode::spawnLightningParticles() {
         glm::vec3 endToStart(segment.second - segment.first);
         glm::vec3 center(0.5f * (segment.first + segment.second));
         particle->setLocalTransform(glm::translate(center));
-        particle->setDir(_absTransform * glm::vec4(glm::normalize(endToStart), 0.0f));
+        particle->setDir(absoluteTransform() * glm::vec4(glm::normalize(endToStart), 0.0f));
         particle->setSize(glm::vec2(_lightningScale, glm::length(endToStart)));
 
         addChild(*particle);
@@ -259,9 +260,9 @@ void EmitterSceneNode::renderLeafs(IRenderPass &pass, const std::vector<SceneNod
     if (!texture) {
         return;
     }
-    auto emitterRight = glm::vec3(_absTransform[0]);
-    auto emitterUp = glm::vec3(_absTransform[1]);
-    auto emitterForward = glm::vec3(_absTransform[2]);
+    auto emitterRight = glm::vec3(absoluteTransform()[0]);
+    auto emitterUp = glm::vec3(absoluteTransform()[1]);
+    auto emitterForward = glm::vec3(absoluteTransform()[2]);
 
     auto view = _sceneGraph.camera()->get().camera()->view();
     auto cameraRight = glm::vec3(view[0][0], view[1][0], view[2][0]);
@@ -72,7 +72,7 @@ void GrassSceneNode::update(float dt) {
     auto mesh = _aabbNode.mesh()->mesh;
     auto &faces = mesh->faces();
     auto cameraPos = camera->get().origin();
-    glm::vec3 meshSpaceCameraPos(_absTransformInv * glm::vec4(cameraPos, 1.0f));
+    glm::vec3 meshSpaceCameraPos(absoluteTransformInverse() * glm::vec4(cameraPos, 1.0f));
 
     // Return grass clusters in out-of-distance faces, to the pool
     std::set<int> outOfDistance;
@@ -88,7 +88,7 @@ void GrassSceneNode::update(float dt) {
     for (auto &faceIdx : outOfDistance) {
         auto &clusters = _materializedClusters.find(faceIdx)->second;
         for (auto &cluster : clusters) {
-            _children.erase(cluster);
+            removeChild(*cluster);
             _clusterPool.push(cluster);
         }
         _materializedClusters.erase(faceIdx);
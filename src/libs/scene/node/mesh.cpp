@@ -51,6 +51,10 @@ void MeshSceneNode::init() {
 
     initTextures();
     initDanglyMesh();
+
+    if (_modelNode.isSkinMesh()) {
+        _boneTransforms.reserve(kMaxBones);
+    }
 }
 
 void MeshSceneNode::initTextures() {
@@ -138,13 +142,13 @@ void MeshSceneNode::updateDanglyAnimation(float dt, const ModelNode::Danglymesh
     } else if (dt > 0.035f) {
         dt = 0.035f;
     }
-    glm::vec3 worldPos = _absTransform[3];
+    glm::vec3 worldPos = absoluteTransform()[3];
     glm::vec3 deltaPos {worldPos - _dangly.prevWorldPos};
-    glm::vec3 objSpaceDeltaPos = _absTransformInv * glm::vec4 {worldPos - _dangly.prevWorldPos, 0.0f};
+    glm::vec3 objSpaceDeltaPos = absoluteTransformInverse() * glm::vec4 {worldPos - _dangly.prevWorldPos, 0.0f};
 
     _windTime = glm::mod(_windTime + dt, glm::two_pi<float>());
     auto wind = 0.01f * glm::vec3 {glm::abs(glm::sin(_windTime)), 0.0f, 0.0f};
-    glm::vec3 objSpaceWind = _absTransformInv * glm::vec4 {wind, 0.0f};
+    glm::vec3 objSpaceWind = absoluteTransformInverse() * glm::vec4 {wind, 0.0f};
 
     float deltaPosMag = glm::length(deltaPos);
     if (deltaPosMag <= 5.0f) {
@@ -177,13 +181,13 @@ void MeshSceneNode::updateDanglyAnimation(float dt, const ModelNode::Danglymesh
 }
 
 void MeshSceneNode::updateSaberAnimation(float dt) {
-    glm::vec3 worldPos = _absTransform[3];
+    glm::vec3 worldPos = absoluteTransform()[3];
     glm::vec3 deltaPos = worldPos - _saber.prevWorldPos;
     float deltaPosMag = glm::length(deltaPos);
     if (deltaPosMag > 1.0f) {
         _saber.displacement = glm::vec3 {0.0f};
     } else if (deltaPosMag > 0.0f) {
-        glm::vec3 deltaLocal = _absTransformInv * glm::vec4 {deltaPos, 0.0f};
+        glm::vec3 deltaLocal = absoluteTransformInverse() * glm::vec4 {deltaPos, 0.0f};
         _saber.displacement += deltaLocal;
     }
     _saber.displacement -= _saber.displacement * glm::min(8.0f * dt, 1.0f);
@@ -290,26 +294,11 @@ void MeshSceneNode::render(IRenderPass &pass) {
     }
     material.faceCulling = _nodeTextures.diffuse->features().decal ? FaceCullMode::None : FaceCullMode::Back;
     if (_modelNode.isSkinMesh()) {
-        const auto &skin = *mesh->skin;
-        auto bones = std::vector<glm::mat4>(kMaxBones, glm::mat4(1.0f));
-        for (size_t i = 0; i < kMaxBones; ++i) {
-            if (i >= skin.boneNodeNumber.size()) {
-                break;
-            }
-            auto nodeNumber = skin.boneNodeNumber[i];
-            if (nodeNumber == 0xffff) {
-                continue;
-            }
-            auto bone = _model.getNodeByNumber(nodeNumber);
-            if (!bone) {
-                continue;
-            }
-            bones[i] = _modelNode.absoluteTransformInverse(); // convert bone transform in model space to bone transform in this model node space
-            bones[i] *= _model.absoluteTransformInverse();    // convert bone transform in world space to bone transform in model space
-            bones[i] *= bone->absoluteTransform();
-            bones[i] *= skin.boneMatrices[skin.boneSerial[i]]; // extract changes to the bone transform in this model node space
+        // Bone transforms are normally computed along with model animations
+        if (_boneTransforms.empty()) {
+            computeBoneTransforms();
         }
-        pass.drawSkinned(*mesh->mesh, material, _absTransform, _absTransformInv, std::move(bones));
+        pass.drawSkinned(*mesh->mesh, material, absoluteTransform(), absoluteTransformInverse(), _boneTransforms);
     } else if (_modelNode.isDanglymesh()) {
         std::vector<glm::vec4> positions;
         positions.reserve(_dangly.vertices.size());
@@ -318,17 +307,17 @@ void MeshSceneNode::render(IRenderPass &pass) {
         }
         pass.drawDangly(*mesh->mesh,
                         material,
-                        _absTransform,
-                        _absTransformInv,
+                        absoluteTransform(),
+                        absoluteTransformInverse(),
                         positions);
     } else if (_modelNode.isSaberMesh()) {
         pass.drawSaber(*mesh->mesh,
                        material,
-                       _absTransform,
-                       _absTransformInv,
+                       absoluteTransform(),
+                       absoluteTransformInverse(),
                        glm::vec4 {_saber.displacement, 0.0f});
     } else {
-        pass.draw(*mesh->mesh, material, _absTransform, _absTransformInv);
+        pass.draw(*mesh->mesh, material, absoluteTransform(), absoluteTransformInverse());
     }
 }
 
@@ -342,7 +331,7 @@ void MeshSceneNode::renderShadow(IRenderPass &pass) {
                         ? MaterialType::DirLightShadow
                         : MaterialType::PointLightShadow;
     material.color = glm::vec4(1.0f, 1.0f, 1.0f, _alpha);
-    pass.draw(*mesh->mesh, material, _absTransform, _absTransformInv);
+    pass.draw(*mesh->mesh, material, absoluteTransform(), absoluteTransformInverse());
 }
 
 bool MeshSceneNode::isLightingEnabled() const {
@@ -356,6 +345,29 @@ bool MeshSceneNode::isLightingEnabled() const {
     return true;
 }
 
+void MeshSceneNode::computeBoneTransforms() {
+    auto &skin = *_modelNode.mesh()->skin;
+    _boneTransforms.assign(kMaxBones, glm::mat4(1.0f));
+    for (size_t i = 0; i < kMaxBones; ++i) {
+        if (i >= skin.boneNodeNumber.size()) {
+            break;
+        }
+        auto nodeNumber = skin.boneNodeNumber[i];
+        if (nodeNumber == 0xffff) {
+            continue;
+        }
+        auto bone = _model.getNodeByNumber(nodeNumber);
+        if (!bone) {
+            continue;
+        }
+        auto &boneTransform = _boneTransforms[i];
+        boneTransform = _modelNode.absoluteTransformInverse(); // convert bone transform in model space to bone transform in this model node space
+        boneTransform *= _model.absoluteTransformInverse();    // convert bone transform in world space to bone transform in model space
+        boneTransform *= bone->absoluteTransform();
+        boneTransform *= skin.boneMatrices[skin.boneSerial[i]]; // extract changes to the bone transform in this model node space
+    }
+}
+
 void MeshSceneNode::setMainTexture(Texture *texture) {
     ModelNodeSceneNode::setMainTexture(texture);
     _nodeTextures.diffuse = texture;
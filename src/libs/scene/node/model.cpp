@@ -52,6 +52,7 @@ void ModelSceneNode::init() {
     if (_model->rootNode()) {
         buildNodeTree(*_model->rootNode(), *this);
     }
+    buildNodeIndex();
     computeAABB();
     _point = _aabb.isDegenerate();
 }
@@ -97,13 +98,48 @@ void ModelSceneNode::buildNodeTree(ModelNode &node, SceneNode &parent) {
     }
 }
 
+void ModelSceneNode::buildNodeIndex() {
+    _nodeByIndex.clear();
+    _skinMeshes.clear();
+    for (auto &node : _model->nodes()) {
+        auto sceneNode = getNodeByNumber(node->number());
+        _nodeByIndex.push_back(sceneNode);
+        if (sceneNode && node->isSkinMesh()) {
+            _skinMeshes.push_back(static_cast<MeshSceneNode *>(sceneNode));
+        }
+    }
+}
+
 void ModelSceneNode::update(float dt) {
     // Optimization: skip invisible models
     if (!_enabled) {
         return;
     }
+    if (!_animationsEvaluated) {
+        evaluateAnimations(dt);
+    }
     SceneNode::update(dt);
+    _animationsEvaluated = false;
+
+    for (auto &event : _pendingEvents) {
+        signalEvent(event);
+    }
+    _pendingEvents.clear();
+}
+
+void ModelSceneNode::evaluateAnimations(float dt) {
+    if (!_enabled) {
+        return;
+    }
     updateAnimations(dt);
+    _animationsEvaluated = true;
+
+    // Attachments must be evaluated after their parent nodes have been transformed
+    for (auto &attachment : _attachments) {
+        if (attachment.second->type() == SceneNodeType::Model) {
+            static_cast<ModelSceneNode *>(attachment.second)->evaluateAnimations(dt);
+        }
+    }
 }
 
 void ModelSceneNode::renderLeafs(IRenderPass &pass, const std::vector<SceneNode *> &leafs) {
@@ -113,7 +149,7 @@ void ModelSceneNode::renderLeafs(IRenderPass &pass, const std::vector<SceneNode
 }
 
 void ModelSceneNode::renderAABB(IRenderPass &pass) {
-    auto aabbWorld = _aabb * _absTransform;
+    auto aabbWorld = _aabb * absoluteTransform();
     std::vector<glm::vec4> corners;
     corners.reserve(8);
     for (const auto &corner : aabbWorld.corners()) {
@@ -126,7 +162,7 @@ void ModelSceneNode::computeAABB() {
     _aabb = _model->aabb();
     for (auto &attachment : _attachments) {
         if (attachment.second->type() == SceneNodeType::Model) {
-            AABB modelSpaceAABB(attachment.second->aabb() * attachment.second->absoluteTransform() * _absTransformInv);
+            AABB modelSpaceAABB(attachment.second->aabb() * attachment.second->absoluteTransform() * absoluteTransformInverse());
             _aabb.expand(modelSpaceAABB);
         }
     }
@@ -215,7 +251,7 @@ void ModelSceneNode::playAnimation(Animation &anim, LipAnimation *lipAnim, Anima
     case AnimationBlendMode::Single:
         // In Single mode, clear channels and add animation on top
         _animChannels.clear();
-        _animChannels.push_front(AnimationChannel(anim, lipAnim, properties));
+        _animChannels.push_front(AnimationChannel(anim, _model->getAnimationBinding(anim), lipAnim, properties));
         break;
 
     case AnimationBlendMode::Blend: {
@@ -228,7 +264,7 @@ void ModelSceneNode::playAnimation(Animation &anim, LipAnimation *lipAnim, Anima
             transition = true;
         }
         // Add animation on top
-        _animChannels.push_front(AnimationChannel(anim, lipAnim, properties));
+        _animChannels.push_front(AnimationChannel(anim, _model->getAnimationBinding(anim), lipAnim, properties));
         if (transition) {
             _animChannels[0].transition = true;
             _animChannels[0].time = glm::max(0.0f, _animChannels[0].anim->transitionTime() - kTransitionLength);
@@ -245,7 +281,7 @@ void ModelSceneNode::playAnimation(Animation &anim, LipAnimation *lipAnim, Anima
         if (_animBlendMode != AnimationBlendMode::Overlay) {
             _animChannels.clear();
         }
-        _animChannels.push_front(AnimationChannel(anim, lipAnim, properties));
+        _animChannels.push_front(AnimationChannel(anim, _model->getAnimationBinding(anim), lipAnim, properties));
         break;
 
     default:
@@ -305,7 +341,8 @@ void ModelSceneNode::updateAnimations(float dt) {
 
     // Apply states and compute bone transforms only when this model is not culled
     if (!_culled) {
-        applyAnimationStates(*_model->rootNode());
+        applyAnimationStates();
+        computeBoneTransforms();
     }
 }
 
@@ -325,15 +362,14 @@ void ModelSceneNode::updateAnimationChannel(AnimationChannel &channel, float dt)
     // Signal events between previous and current time
     for (auto &event : channel.anim->events()) {
         if (event.time > oldTime && event.time <= channel.time) {
-            signalEvent(event.name);
+            _pendingEvents.push_back(event.name);
         }
     }
 
     // Compute animation states only when this model is not culled
     if (!_culled) {
         float time = channel.transition ? channel.anim->transitionTime() : channel.time;
-        channel.stateByNodeNumber.clear();
-        computeAnimationStates(channel, time, *_model->rootNode());
+        computeAnimationStates(channel, time);
     }
 
     bool lastFrame = channel.time == length;
@@ -347,23 +383,19 @@ void ModelSceneNode::updateAnimationChannel(AnimationChannel &channel, float dt)
     }
 }
 
-static bool doesNodeHaveAncestor(const ModelNode &node, const std::string &name) {
-    if (name.empty()) {
-        return true;
-    }
-    if (node.name() == name) {
-        return true;
-    }
-    auto parent = node.parent();
-    if (!parent) {
-        return false;
-    }
-    return doesNodeHaveAncestor(*parent, name);
-}
-
-void ModelSceneNode::computeAnimationStates(AnimationChannel &channel, float time, const ModelNode &modelNode) {
-    std::shared_ptr<ModelNode> animNode(channel.anim->getNodeByName(modelNode.name()));
-    if (animNode && modelNode.isAnimated() && doesNodeHaveAncestor(modelNode, channel.anim->root())) {
+void ModelSceneNode::computeAnimationStates(AnimationChannel &channel, float time) {
+    auto &binding = *channel.binding;
+    auto &modelNodes = _model->nodes();
+    channel.states.resize(binding.size());
+    channel.cursors.resize(binding.size());
+    for (size_t i = 0; i < binding.size(); ++i) {
+        auto animNode = binding[i];
+        if (!animNode) {
+            channel.states[i].flags = 0;
+            continue;
+        }
+        auto &modelNode = *modelNodes[i];
+        auto &cursors = channel.cursors[i];
         AnimationState state;
         state.flags = 0;
 
@@ -393,14 +425,14 @@ void ModelSceneNode::computeAnimationStates(AnimationChannel &channel, float tim
             }
         } else {
             glm::vec3 animPosition;
-            if (animNode->positionAtTime(time, animPosition)) {
+            if (animNode->positionAtTime(time, animPosition, &cursors.position)) {
                 position += channel.properties.scale * animPosition;
                 state.flags |= AnimationStateFlags::transform;
             }
-            if (animNode->orientationAtTime(time, orientation)) {
+            if (animNode->orientationAtTime(time, orientation, &cursors.orientation)) {
                 state.flags |= AnimationStateFlags::transform;
             }
-            if (animNode->scaleAtTime(time, scale)) {
+            if (animNode->scaleAtTime(time, scale, &cursors.scale)) {
                 state.flags |= AnimationStateFlags::transform;
             }
         }
@@ -409,43 +441,48 @@ void ModelSceneNode::computeAnimationStates(AnimationChannel &channel, float tim
             state.transform *= glm::translate(position);
             state.transform *= glm::mat4_cast(orientation);
         }
-        if (animNode->floatValueAtTime(ControllerTypes::alpha, time, state.alpha)) {
+        if (animNode->floatValueAtTime(ControllerTypes::alpha, time, state.alpha, &cursors.alpha)) {
             state.flags |= AnimationStateFlags::alpha;
         }
-        if (animNode->vectorValueAtTime(ControllerTypes::selfIllumColor, time, state.selfIllumColor)) {
+        if (animNode->vectorValueAtTime(ControllerTypes::selfIllumColor, time, state.selfIllumColor, &cursors.selfIllumColor)) {
             state.flags |= AnimationStateFlags::selfIllumColor;
         }
-        if (animNode->vectorValueAtTime(ControllerTypes::color, time, state.color)) {
+        if (animNode->vectorValueAtTime(ControllerTypes::color, time, state.color, &cursors.color)) {
             state.flags |= AnimationStateFlags::color;
         }
-        channel.stateByNodeNumber[modelNode.number()] = std::move(state);
+        channel.states[i] = std::move(state);
     }
+}
 
-    for (auto &child : modelNode.children()) {
-        computeAnimationStates(channel, time, *child);
+static const ModelSceneNode::AnimationState *getAnimationState(const ModelSceneNode::AnimationChannel &channel, size_t nodeIndex) {
+    if (nodeIndex >= channel.states.size() || channel.states[nodeIndex].flags == 0) {
+        return nullptr;
     }
+    return &channel.states[nodeIndex];
 }
 
-void ModelSceneNode::applyAnimationStates(const ModelNode &modelNode) {
-    auto maybeSceneNode = _nodeByNumber.find(modelNode.number());
-    if (maybeSceneNode != _nodeByNumber.end()) {
-        auto sceneNode = maybeSceneNode->second;
+void ModelSceneNode::applyAnimationStates() {
+    for (size_t i = 0; i < _nodeByIndex.size(); ++i) {
+        auto sceneNode = _nodeByIndex[i];
+        if (!sceneNode) {
+            continue;
+        }
         AnimationState combined;
 
         switch (_animBlendMode) {
         case AnimationBlendMode::Single:
         case AnimationBlendMode::Blend: {
             AnimationState state1;
-            auto state1Iter = _animChannels[0].stateByNodeNumber.find(modelNode.number());
-            if (state1Iter != _animChannels[0].stateByNodeNumber.end()) {
-                state1 = state1Iter->second;
+            auto maybeState1 = getAnimationState(_animChannels[0], i);
+            if (maybeState1) {
+                state1 = *maybeState1;
             }
             bool blend = _animBlendMode == AnimationBlendMode::Blend && _animChannels[0].transition && _animChannels.size() > 1ll;
             if (blend) {
                 AnimationState state2;
-                auto state2Iter = _animChannels[1].stateByNodeNumber.find(modelNode.number());
-                if (state2Iter != _animChannels[1].stateByNodeNumber.end()) {
-                    state2 = state2Iter->second;
+                auto maybeState2 = getAnimationState(_animChannels[1], i);
+                if (maybeState2) {
+                    state2 = *maybeState2;
                 }
                 if (state1.flags & AnimationStateFlags::transform && state2.flags & AnimationStateFlags::transform) {
                     float factor = glm::min(1.0f, _animChannels[0].time / _animChannels[0].anim->transitionTime());
@@ -485,11 +522,11 @@ void ModelSceneNode::applyAnimationStates(const ModelNode &modelNode) {
         }
         case AnimationBlendMode::Overlay:
             for (auto &channel : _animChannels) {
-                auto maybeState = channel.stateByNodeNumber.find(modelNode.number());
-                if (maybeState == channel.stateByNodeNumber.end()) {
+                auto maybeState = getAnimationState(channel, i);
+                if (!maybeState) {
                     continue;
                 }
-                const AnimationState &state = maybeState->second;
+                const AnimationState &state = *maybeState;
                 if ((state.flags & AnimationStateFlags::transform) && !(combined.flags & AnimationStateFlags::transform)) {
                     combined.flags |= AnimationStateFlags::transform;
                     combined.transform = state.transform;
@@ -525,9 +562,11 @@ void ModelSceneNode::applyAnimationStates(const ModelNode &modelNode) {
             static_cast<LightSceneNode *>(sceneNode)->setColor(combined.color);
         }
     }
+}
 
-    for (auto &child : modelNode.children()) {
-        applyAnimationStates(*child);
+void ModelSceneNode::computeBoneTransforms() {
+    for (auto &mesh : _skinMeshes) {
+        mesh->computeBoneTransforms();
     }
 }
 
@@ -577,7 +616,7 @@ std::string ModelSceneNode::activeAnimationName() const {
 }
 
 void ModelSceneNode::setModel(Model &model) {
-    _children.clear();
+    removeAllChildren();
 
     _model = &model;
 
@@ -589,6 +628,7 @@ void ModelSceneNode::setModel(Model &model) {
     _animBlendMode = AnimationBlendMode::Single;
 
     buildNodeTree(*_model->rootNode(), *this);
+    buildNodeIndex();
     computeAABB();
 }
 
@@ -105,13 +105,13 @@ void TriggerSceneNode::render(IRenderPass &pass) {
     Material material;
     material.type = MaterialType::Walkmesh;
     material.faceCulling = FaceCullMode::Back;
-    pass.draw(*_mesh, material, _absTransform, _absTransformInv);
+    pass.draw(*_mesh, material, absoluteTransform(), absoluteTransformInverse());
 }
 
 bool TriggerSceneNode::isIn(const glm::vec2 &pt) const {
     static glm::vec3 down(0.0f, 0.0f, -1.0f);
 
-    auto pointObjSpace = glm::vec3(_absTransformInv * glm::vec4(pt, 1000.0f, 1.0f));
+    auto pointObjSpace = glm::vec3(absoluteTransformInverse() * glm::vec4(pt, 1000.0f, 1.0f));
     auto intersection = glm::vec2(0.0f);
     float distance = 0.0f;
 
@@ -40,8 +40,6 @@ void NcsReader::load() {
 }
 
 void NcsReader::readInstruction(size_t &offset) {
-    _ncs.seek(offset);
-
     uint8_t byteCode = _ncs.readByte();
     uint8_t qualifier = _ncs.readByte();
 
@@ -34,6 +34,8 @@ void ScriptProgram::add(Instruction instr) {
     _length += size;
     _insIdxByOffset.insert(std::make_pair(instr.offset, static_cast<int>(_instructions.size())));
     _instructions.push_back(std::move(instr));
+    _compiledValid = false;
+    _verified = false;
 }
 
 const Instruction &ScriptProgram::getInstruction(uint32_t offset) const {
@@ -41,6 +43,50 @@ const Instruction &ScriptProgram::getInstruction(uint32_t offset) const {
     return _instructions[idx];
 }
 
+int ScriptProgram::getInstructionIndex(uint32_t offset) const {
+    if (offset >= _length) {
+        return static_cast<int>(_instructions.size());
+    }
+    auto maybeIdx = _insIdxByOffset.find(offset);
+    if (maybeIdx == _insIdxByOffset.end()) {
+        return -1;
+    }
+    return maybeIdx->second;
+}
+
+const std::vector<CompiledInstruction> &ScriptProgram::compiled() const {
+    if (!_compiledValid) {
+        std::lock_guard<std::mutex> lock {_compileMutex};
+        if (!_compiledValid) {
+            compile();
+            _compiledValid = true;
+        }
+    }
+    return _compiled;
+}
+
+void ScriptProgram::compile() const {
+    _compiled.clear();
+    _compiled.reserve(_instructions.size());
+    for (auto &ins : _instructions) {
+        auto compiled = CompiledInstruction();
+        compiled.ins = &ins;
+        compiled.type = ins.type;
+        compiled.nextIdx = getInstructionIndex(ins.nextOffset);
+        switch (ins.type) {
+        case InstructionType::JMP:
+        case InstructionType::JSR:
+        case InstructionType::JZ:
+        case InstructionType::JNZ:
+            compiled.jumpIdx = getInstructionIndex(ins.offset + ins.jumpOffset);
+            break;
+        default:
+            break;
+        }
+        _compiled.push_back(std::move(compiled));
+    }
+}
+
 Instruction Instruction::newCPDOWNSP(int stackOffset, uint16_t size) {
     Instruction val;
     val.type = InstructionType::CPDOWNSP;
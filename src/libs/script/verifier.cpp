@@ -0,0 +1,484 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "reone/script/verifier.h"
+
+#include "reone/script/program.h"
+#include "reone/script/routine.h"
+#include "reone/script/routines.h"
+
+namespace reone {
+
+namespace script {
+
+static constexpr int kStartInstructionOffset = 13;
+static constexpr int kMaxCallDepth = 64;
+
+static void requireRange(const std::vector<VariableType> &stack, int first, int count) {
+    if (first < 0 || count < 0 || first + count > static_cast<int>(stack.size())) {
+        throw std::runtime_error(str(boost::format("Stack access out of bounds: first=%d, count=%d, size=%d") % first % count % stack.size()));
+    }
+}
+
+static void requireType(VariableType expected, VariableType actual) {
+    if (actual != expected) {
+        throw std::runtime_error(str(boost::format("Invalid variable type: expected=%d, actual=%d") %
+                                     static_cast<int>(expected) %
+                                     static_cast<int>(actual)));
+    }
+}
+
+static void pop(std::vector<VariableType> &stack, VariableType expected) {
+    requireRange(stack, static_cast<int>(stack.size()) - 1, 1);
+    requireType(expected, stack.back());
+    stack.pop_back();
+}
+
+static void popVector(std::vector<VariableType> &stack) {
+    for (int i = 0; i < 3; ++i) {
+        pop(stack, VariableType::Float);
+    }
+}
+
+static void pushVector(std::vector<VariableType> &stack) {
+    stack.insert(stack.end(), 3, VariableType::Float);
+}
+
+static void binary(std::vector<VariableType> &stack, VariableType left, VariableType right, VariableType result) {
+    pop(stack, right);
+    pop(stack, left);
+    stack.push_back(result);
+}
+
+static void copyDown(std::vector<VariableType> &stack, int dstIdx, int count) {
+    int srcIdx = static_cast<int>(stack.size()) - count;
+    requireRange(stack, srcIdx, count);
+    requireRange(stack, dstIdx, count);
+    for (int i = 0; i < count; ++i) {
+        stack[dstIdx + i] = stack[srcIdx + i];
+    }
+}
+
+static void copyTop(std::vector<VariableType> &stack, int srcIdx, int count) {
+    requireRange(stack, srcIdx, count);
+    for (int i = 0; i < count; ++i) {
+        VariableType type = stack[srcIdx + i];
+        stack.push_back(type);
+    }
+}
+
+static void requireInt(const std::vector<VariableType> &stack, int idx) {
+    requireRange(stack, idx, 1);
+    requireType(VariableType::Int, stack[idx]);
+}
+
+static void requireBasePointer(int bp) {
+    if (bp == -1) {
+        throw std::runtime_error("Base pointer is unknown");
+    }
+}
+
+void ScriptVerifier::verify(const ScriptProgram &program) {
+    _program = &program;
+    _compiled = &program.compiled();
+    _subroutines.clear();
+    _resumePoints.clear();
+
+    analyze(program.getInstructionIndex(kStartInstructionOffset), State(), 0);
+
+    // Resumption points can themselves store states, so iterate by index
+    std::vector<std::pair<int, State>> verified;
+    for (size_t i = 0; i < _resumePoints.size(); ++i) {
+        auto resumePoint = _resumePoints[i];
+        if (std::find(verified.begin(), verified.end(), resumePoint) != verified.end()) {
+            continue;
+        }
+        analyze(resumePoint.first, resumePoint.second, 0);
+        verified.push_back(std::move(resumePoint));
+    }
+
+    _subroutines.clear();
+    _resumePoints.clear();
+    _compiled = nullptr;
+    _program = nullptr;
+}
+
+std::optional<ScriptVerifier::State> ScriptVerifier::analyze(int entryIdx, State entry, int depth) {
+    int numInstructions = static_cast<int>(_compiled->size());
+    std::unordered_map<int, State> states;
+    std::vector<int> worklist;
+    std::optional<State> exit;
+
+    auto flow = [&](int idx, const State &state) {
+        if (idx < 0 || idx > numInstructions) {
+            throw std::runtime_error(str(boost::format("Invalid instruction index: %d") % idx));
+        }
+        auto maybeState = states.find(idx);
+        if (maybeState != states.end()) {
+            if (maybeState->second != state) {
+                throw std::runtime_error(str(boost::format("Inconsistent stack at instruction %d") % idx));
+            }
+            return;
+        }
+        states.insert(std::make_pair(idx, state));
+        worklist.push_back(idx);
+    };
+
+    flow(entryIdx, entry);
+
+    while (!worklist.empty()) {
+        int idx = worklist.back();
+        worklist.pop_back();
+        if (idx == numInstructions) {
+            // Program ends here
+            continue;
+        }
+        auto &compiled = (*_compiled)[idx];
+        State state = states.at(idx);
+
+        switch (compiled.type) {
+        case InstructionType::JMP:
+            flow(compiled.jumpIdx, state);
+            break;
+        case InstructionType::JSR: {
+            auto returned = call(compiled.jumpIdx, state, depth + 1);
+            if (returned) {
+                flow(compiled.nextIdx, *returned);
+            }
+            break;
+        }
+        case InstructionType::JZ:
+        case InstructionType::JNZ:
+            execute(compiled, state);
+            flow(compiled.jumpIdx, state);
+            flow(compiled.nextIdx, state);
+            break;
+        case InstructionType::RETN:
+            if (exit && *exit != state) {
+                throw std::runtime_error(str(boost::format("Inconsistent stack on return from instruction %d") % entryIdx));
+            }
+            exit = std::move(state);
+            break;
+        default:
+            execute(compiled, state);
+            flow(compiled.nextIdx, state);
+            break;
+        }
+    }
+
+    return exit;
+}
+
+std::optional<ScriptVerifier::State> ScriptVerifier::call(int entryIdx, const State &entry, int depth) {
+    if (depth > kMaxCallDepth) {
+        throw std::runtime_error("Maximum call depth exceeded");
+    }
+    for (auto &subroutine : _subroutines) {
+        if (subroutine.entryIdx != entryIdx || subroutine.entry != entry) {
+            continue;
+        }
+        if (!subroutine.analyzed) {
+            throw std::runtime_error(str(boost::format("Recursive call to instruction %d") % entryIdx));
+        }
+        return subroutine.exit;
+    }
+    auto &subroutine = _subroutines.emplace_back();
+    subroutine.entryIdx = entryIdx;
+    subroutine.entry = entry;
+    auto exit = analyze(entryIdx, entry, depth);
+    subroutine.exit = exit;
+    subroutine.analyzed = true;
+    return exit;
+}
+
+void ScriptVerifier::execute(const CompiledInstruction &compiled, State &state) {
+    auto &ins = *compiled.ins;
+    auto &stack = state.stack;
+    int size = static_cast<int>(stack.size());
+
+    switch (compiled.type) {
+    case InstructionType::NOP:
+    case InstructionType::NOP2:
+        break;
+    case InstructionType::CPDOWNSP:
+        copyDown(stack, size + ins.stackOffset / 4, ins.size / 4);
+        break;
+    case InstructionType::RSADDI:
+    case InstructionType::CONSTI:
+        stack.push_back(VariableType::Int);
+        break;
+    case InstructionType::RSADDF:
+    case InstructionType::CONSTF:
+        stack.push_back(VariableType::Float);
+        break;
+    case InstructionType::RSADDS:
+    case InstructionType::CONSTS:
+        stack.push_back(VariableType::String);
+        break;
+    case InstructionType::RSADDO:
+    case InstructionType::CONSTO:
+        stack.push_back(VariableType::Object);
+        break;
+    case InstructionType::RSADDEFF:
+        stack.push_back(VariableType::Effect);
+        break;
+    case InstructionType::RSADDEVT:
+        stack.push_back(VariableType::Event);
+        break;
+    case InstructionType::RSADDLOC:
+        stack.push_back(VariableType::Location);
+        break;
+    case InstructionType::RSADDTAL:
+        stack.push_back(VariableType::Talent);
+        break;
+    case InstructionType::CPTOPSP:
+        copyTop(stack, size + ins.stackOffset / 4, ins.size / 4);
+        break;
+    case InstructionType::ACTION:
+        executeAction(ins, state);
+        break;
+    case InstructionType::LOGANDII:
+    case InstructionType::LOGORII:
+    case InstructionType::INCORII:
+    case InstructionType::EXCORII:
+    case InstructionType::BOOLANDII:
+    case InstructionType::EQUALII:
+    case InstructionType::NEQUALII:
+    case InstructionType::GEQII:
+    case InstructionType::GTII:
+    case InstructionType::LTII:
+    case InstructionType::LEQII:
+    case InstructionType::SHLEFTII:
+    case InstructionType::SHRIGHTII:
+    case InstructionType::USHRIGHTII:
+    case InstructionType::ADDII:
+    case InstructionType::SUBII:
+    case InstructionType::MULII:
+    case InstructionType::DIVII:
+    case InstructionType::MODII:
+        binary(stack, VariableType::Int, VariableType::Int, VariableType::Int);
+        break;
+    case InstructionType::EQUALFF:
+    case InstructionType::NEQUALFF:
+    case InstructionType::GEQFF:
+    case InstructionType::GTFF:
+    case InstructionType::LTFF:
+    case InstructionType::LEQFF:
+        binary(stack, VariableType::Float, VariableType::Float, VariableType::Int);
+        break;
+    case InstructionType::EQUALSS:
+    case InstructionType::NEQUALSS:
+        binary(stack, VariableType::String, VariableType::String, VariableType::Int);
+        break;
+    case InstructionType::EQUALOO:
+    case InstructionType::NEQUALOO:
+        binary(stack, VariableType::Object, VariableType::Object, VariableType::Int);
+        break;
+    case InstructionType::EQUALEFFEFF:
+    case InstructionType::NEQUALEFFEFF:
+        binary(stack, VariableType::Effect, VariableType::Effect, VariableType::Int);
+        break;
+    case InstructionType::EQUALEVTEVT:
+    case InstructionType::NEQUALEVTEVT:
+        binary(stack, VariableType::Event, VariableType::Event, VariableType::Int);
+        break;
+    case InstructionType::EQUALLOCLOC:
+    case InstructionType::NEQUALLOCLOC:
+        binary(stack, VariableType::Location, VariableType::Location, VariableType::Int);
+        break;
+    case InstructionType::EQUALTALTAL:
+    case InstructionType::NEQUALTALTAL:
+        binary(stack, VariableType::Talent, VariableType::Talent, VariableType::Int);
+        break;
+    case InstructionType::EQUALTT:
+    case InstructionType::NEQUALTT: {
+        int count = 2 * (ins.size / 4);
+        requireRange(stack, size - count, count);
+        stack.resize(size - count);
+        stack.push_back(VariableType::Int);
+        break;
+    }
+    case InstructionType::ADDIF:
+    case InstructionType::SUBIF:
+    case InstructionType::MULIF:
+    case InstructionType::DIVIF:
+        binary(stack, VariableType::Int, VariableType::Float, VariableType::Float);
+        break;
+    case InstructionType::ADDFI:
+    case InstructionType::SUBFI:
+    case InstructionType::MULFI:
+    case InstructionType::DIVFI:
+        binary(stack, VariableType::Float, VariableType::Int, VariableType::Float);
+        break;
+    case InstructionType::ADDFF:
+    case InstructionType::SUBFF:
+    case InstructionType::MULFF:
+    case InstructionType::DIVFF:
+        binary(stack, VariableType::Float, VariableType::Float, VariableType::Float);
+        break;
+    case InstructionType::ADDSS:
+        binary(stack, VariableType::String, VariableType::String, VariableType::String);
+        break;
+    case InstructionType::ADDVV:
+    case InstructionType::SUBVV:
+        popVector(stack);
+        popVector(stack);
+        pushVector(stack);
+        break;
+    case InstructionType::MULVF:
+    case InstructionType::DIVVF:
+        pop(stack, VariableType::Float);
+        popVector(stack);
+        pushVector(stack);
+        break;
+    case InstructionType::MULFV:
+    case InstructionType::DIVFV:
+        popVector(stack);
+        pop(stack, VariableType::Float);
+        pushVector(stack);
+        break;
+    case InstructionType::NEGI:
+        requireInt(stack, size - 1);
+        break;
+    case InstructionType::NEGF:
+        requireRange(stack, size - 1, 1);
+        requireType(VariableType::Float, stack.back());
+        break;
+    case InstructionType::MOVSP: {
+        int count = -ins.stackOffset / 4;
+        requireRange(stack, size - count, count);
+        stack.resize(size - count);
+        break;
+    }
+    case InstructionType::JZ:
+    case InstructionType::JNZ:
+        pop(stack, VariableType::Int);
+        break;
+    case InstructionType::DESTRUCT: {
+        int count = ins.size / 4;
+        int startIdx = size - count;
+        int keepOffset = ins.stackOffset / 4;
+        int keepCount = ins.sizeNoDestroy / 4;
+        requireRange(stack, startIdx, count);
+        if (keepOffset < 0 || keepCount < 0 || keepOffset + keepCount > count) {
+            throw std::runtime_error("Invalid DESTRUCT range");
+        }
+        for (int i = 0; i < keepCount; ++i) {
+            stack[startIdx + i] = stack[startIdx + keepOffset + i];
+        }
+        stack.resize(startIdx + keepCount);
+        break;
+    }
+    case InstructionType::DECISP:
+    case InstructionType::INCISP:
+        requireInt(stack, size + ins.stackOffset / 4);
+        break;
+    case InstructionType::NOTI:
+        pop(stack, VariableType::Int);
+        stack.push_back(VariableType::Int);
+        break;
+    case InstructionType::CPDOWNBP:
+        requireBasePointer(state.bp);
+        copyDown(stack, state.bp + ins.stackOffset / 4, ins.size / 4);
+        break;
+    case InstructionType::CPTOPBP:
+        requireBasePointer(state.bp);
+        copyTop(stack, state.bp + ins.stackOffset / 4, ins.size / 4);
+        break;
+    case InstructionType::DECIBP:
+    case InstructionType::INCIBP:
+        requireBasePointer(state.bp);
+        requireInt(stack, state.bp + ins.stackOffset / 4);
+        break;
+    case InstructionType::SAVEBP:
+        state.bp = size;
+        stack.push_back(VariableType::Int);
+        break;
+    case InstructionType::RESTOREBP:
+        // Restored value is not tracked, so base pointer relative access is rejected from here on
+        pop(stack, VariableType::Int);
+        state.bp = -1;
+        break;
+    case InstructionType::STORE_STATE:
+        executeStoreState(ins, state);
+        break;
+    default:
+        throw std::runtime_error(str(boost::format("Unsupported instruction type: %04x") % static_cast<int>(compiled.type)));
+    }
+}
+
+void ScriptVerifier::executeAction(const Instruction &ins, State &state) {
+    if (ins.routine < 0 || ins.routine >= _routines.getNumRoutines()) {
+        throw std::runtime_error("Invalid routine: " + std::to_string(ins.routine));
+    }
+    auto &routine = _routines.get(ins.routine);
+    if (ins.argCount > routine.getArgumentCount()) {
+        throw std::runtime_error("Too many routine arguments");
+    }
+    auto &stack = state.stack;
+    for (int i = 0; i < ins.argCount; ++i) {
+        VariableType type = routine.getArgumentType(i);
+        switch (type) {
+        case VariableType::Vector:
+            popVector(stack);
+            break;
+        case VariableType::Action:
+            break;
+        default:
+            pop(stack, type);
+            break;
+        }
+    }
+    switch (routine.returnType()) {
+    case VariableType::Void:
+        break;
+    case VariableType::Vector:
+        pushVector(stack);
+        break;
+    default:
+        stack.push_back(routine.returnType());
+        break;
+    }
+}
+
+void ScriptVerifier::executeStoreState(const Instruction &ins, const State &state) {
+    requireBasePointer(state.bp);
+
+    auto &stack = state.stack;
+    int numGlobals = ins.size / 4;
+    int globalsIdx = state.bp - numGlobals;
+    requireRange(stack, globalsIdx, numGlobals);
+    int numLocals = ins.sizeLocals / 4;
+    int localsIdx = static_cast<int>(stack.size()) - numLocals;
+    requireRange(stack, localsIdx, numLocals);
+
+    State resumed;
+    resumed.stack.insert(resumed.stack.end(), stack.begin() + globalsIdx, stack.begin() + globalsIdx + numGlobals);
+    resumed.stack.insert(resumed.stack.end(), stack.begin() + localsIdx, stack.end());
+    resumed.bp = numGlobals;
+
+    // Stored state is resumed past the JMP that follows STORE_STATE
+    int resumeIdx = _program->getInstructionIndex(ins.offset + 0x10);
+    if (resumeIdx == -1) {
+        throw std::runtime_error(str(boost::format("Invalid resume offset: %04x") % (ins.offset + 0x10)));
+    }
+    _resumePoints.push_back(std::make_pair(resumeIdx, std::move(resumed)));
+}
+
+} // namespace script
+
+} // namespace reone
@@ -33,152 +33,177 @@ namespace script {
 static constexpr int kStartInstructionOffset = 13;
 static constexpr float kFloatTolerance = 1e-5;
 
+static const std::string g_emptyString;
+static const std::shared_ptr<EngineType> g_nullEngineType;
+static const std::shared_ptr<ExecutionContext> g_nullAction;
+
 VirtualMachine::VirtualMachine(std::shared_ptr<ScriptProgram> program, std::unique_ptr<ExecutionContext> context) :
     _context(std::move(context)),
     _program(std::move(program)) {
 
-    static std::unordered_map<InstructionType, std::function<void(VirtualMachine *, const Instruction &)>> g_handlers {
-        {InstructionType::CPDOWNSP, &VirtualMachine::executeCPDOWNSP},
-        {InstructionType::RSADDI, &VirtualMachine::executeRSADDI},
-        {InstructionType::RSADDF, &VirtualMachine::executeRSADDF},
-        {InstructionType::RSADDS, &VirtualMachine::executeRSADDS},
-        {InstructionType::RSADDO, &VirtualMachine::executeRSADDO},
-        {InstructionType::RSADDEFF, &VirtualMachine::executeRSADDEFF},
-        {InstructionType::RSADDEVT, &VirtualMachine::executeRSADDEVT},
-        {InstructionType::RSADDLOC, &VirtualMachine::executeRSADDLOC},
-        {InstructionType::RSADDTAL, &VirtualMachine::executeRSADDTAL},
-        {InstructionType::CPTOPSP, &VirtualMachine::executeCPTOPSP},
-        {InstructionType::CONSTI, &VirtualMachine::executeCONSTI},
-        {InstructionType::CONSTF, &VirtualMachine::executeCONSTF},
-        {InstructionType::CONSTS, &VirtualMachine::executeCONSTS},
-        {InstructionType::CONSTO, &VirtualMachine::executeCONSTO},
-        {InstructionType::ACTION, &VirtualMachine::executeACTION},
-        {InstructionType::LOGANDII, &VirtualMachine::executeLOGANDII},
-        {InstructionType::LOGORII, &VirtualMachine::executeLOGORII},
-        {InstructionType::INCORII, &VirtualMachine::executeINCORII},
-        {InstructionType::EXCORII, &VirtualMachine::executeEXCORII},
-        {InstructionType::BOOLANDII, &VirtualMachine::executeBOOLANDII},
-        {InstructionType::EQUALII, &VirtualMachine::executeEQUALII},
-        {InstructionType::EQUALFF, &VirtualMachine::executeEQUALFF},
-        {InstructionType::EQUALSS, &VirtualMachine::executeEQUALSS},
-        {InstructionType::EQUALOO, &VirtualMachine::executeEQUALOO},
-        {InstructionType::EQUALTT, &VirtualMachine::executeEQUALTT},
-        {InstructionType::EQUALEFFEFF, &VirtualMachine::executeEQUALEFFEFF},
-        {InstructionType::EQUALEVTEVT, &VirtualMachine::executeEQUALEVTEVT},
-        {InstructionType::EQUALLOCLOC, &VirtualMachine::executeEQUALLOCLOC},
-        {InstructionType::EQUALTALTAL, &VirtualMachine::executeEQUALTALTAL},
-        {InstructionType::NEQUALII, &VirtualMachine::executeNEQUALII},
-        {InstructionType::NEQUALFF, &VirtualMachine::executeNEQUALFF},
-        {InstructionType::NEQUALSS, &VirtualMachine::executeNEQUALSS},
-        {InstructionType::NEQUALOO, &VirtualMachine::executeNEQUALOO},
-        {InstructionType::NEQUALTT, &VirtualMachine::executeNEQUALTT},
-        {InstructionType::NEQUALEFFEFF, &VirtualMachine::executeNEQUALEFFEFF},
-        {InstructionType::NEQUALEVTEVT, &VirtualMachine::executeNEQUALEVTEVT},
-        {InstructionType::NEQUALLOCLOC, &VirtualMachine::executeNEQUALLOCLOC},
-        {InstructionType::NEQUALTALTAL, &VirtualMachine::executeNEQUALTALTAL},
-        {InstructionType::GEQII, &VirtualMachine::executeGEQII},
-        {InstructionType::GEQFF, &VirtualMachine::executeGEQFF},
-        {InstructionType::GTII, &VirtualMachine::executeGTII},
-        {InstructionType::GTFF, &VirtualMachine::executeGTFF},
-        {InstructionType::LTII, &VirtualMachine::executeLTII},
-        {InstructionType::LTFF, &VirtualMachine::executeLTFF},
-        {InstructionType::LEQII, &VirtualMachine::executeLEQII},
-        {InstructionType::LEQFF, &VirtualMachine::executeLEQFF},
-        {InstructionType::SHLEFTII, &VirtualMachine::executeSHLEFTII},
-        {InstructionType::SHRIGHTII, &VirtualMachine::executeSHRIGHTII},
-        {InstructionType::USHRIGHTII, &VirtualMachine::executeUSHRIGHTII},
-        {InstructionType::ADDII, &VirtualMachine::executeADDII},
-        {InstructionType::ADDIF, &VirtualMachine::executeADDIF},
-        {InstructionType::ADDFI, &VirtualMachine::executeADDFI},
-        {InstructionType::ADDFF, &VirtualMachine::executeADDFF},
-        {InstructionType::ADDSS, &VirtualMachine::executeADDSS},
-        {InstructionType::ADDVV, &VirtualMachine::executeADDVV},
-        {InstructionType::SUBII, &VirtualMachine::executeSUBII},
-        {InstructionType::SUBIF, &VirtualMachine::executeSUBIF},
-        {InstructionType::SUBFI, &VirtualMachine::executeSUBFI},
-        {InstructionType::SUBFF, &VirtualMachine::executeSUBFF},
-        {InstructionType::SUBVV, &VirtualMachine::executeSUBVV},
-        {InstructionType::MULII, &VirtualMachine::executeMULII},
-        {InstructionType::MULIF, &VirtualMachine::executeMULIF},
-        {InstructionType::MULFI, &VirtualMachine::executeMULFI},
-        {InstructionType::MULFF, &VirtualMachine::executeMULFF},
-        {InstructionType::MULVF, &VirtualMachine::executeMULVF},
-        {InstructionType::MULFV, &VirtualMachine::executeMULFV},
-        {InstructionType::DIVII, &VirtualMachine::executeDIVII},
-        {InstructionType::DIVIF, &VirtualMachine::executeDIVIF},
-        {InstructionType::DIVFI, &VirtualMachine::executeDIVFI},
-        {InstructionType::DIVFF, &VirtualMachine::executeDIVFF},
-        {InstructionType::DIVVF, &VirtualMachine::executeDIVVF},
-        {InstructionType::DIVFV, &VirtualMachine::executeDIVFV},
-        {InstructionType::MODII, &VirtualMachine::executeMODII},
-        {InstructionType::NEGI, &VirtualMachine::executeNEGI},
-        {InstructionType::NEGF, &VirtualMachine::executeNEGF},
-        {InstructionType::MOVSP, &VirtualMachine::executeMOVSP},
-        {InstructionType::JMP, &VirtualMachine::executeJMP},
-        {InstructionType::JSR, &VirtualMachine::executeJSR},
-        {InstructionType::JZ, &VirtualMachine::executeJZ},
-        {InstructionType::RETN, &VirtualMachine::executeRETN},
-        {InstructionType::DESTRUCT, &VirtualMachine::executeDESTRUCT},
-        {InstructionType::NOTI, &VirtualMachine::executeNOTI},
-        {InstructionType::DECISP, &VirtualMachine::executeDECISP},
-        {InstructionType::INCISP, &VirtualMachine::executeINCISP},
-        {InstructionType::JNZ, &VirtualMachine::executeJNZ},
-        {InstructionType::CPDOWNBP, &VirtualMachine::executeCPDOWNBP},
-        {InstructionType::CPTOPBP, &VirtualMachine::executeCPTOPBP},
-        {InstructionType::DECIBP, &VirtualMachine::executeDECIBP},
-        {InstructionType::INCIBP, &VirtualMachine::executeINCIBP},
-        {InstructionType::SAVEBP, &VirtualMachine::executeSAVEBP},
-        {InstructionType::RESTOREBP, &VirtualMachine::executeRESTOREBP},
-        {InstructionType::STORE_STATE, &VirtualMachine::executeSTORE_STATE}};
-    for (auto &pair : g_handlers) {
-        registerHandler(pair.first, pair.second);
-    }
-    _handlers.insert(std::make_pair(InstructionType::NOP, [](auto &) {}));
-    _handlers.insert(std::make_pair(InstructionType::NOP2, [](auto &) {}));
+    _checked = !_program->isVerified();
+}
+
+VirtualMachine::~VirtualMachine() {
 }
 
+#define R_INSTR_CASE(a)            \
+    case InstructionType::a:       \
+        execute##a(*compiled.ins); \
+        break;
+
+#define R_JUMP_CASE(a)        \
+    case InstructionType::a:  \
+        execute##a(compiled); \
+        break;
+
 int VirtualMachine::run() {
+    auto &instructions = _program->compiled();
+    int numInstructions = static_cast<int>(instructions.size());
     uint32_t insOff = kStartInstructionOffset;
 
     if (_context->savedState) {
-        std::vector<Variable> globals(_context->savedState->globals);
-        copy(globals.begin(), globals.end(), back_inserter(_stack));
+        for (auto &global : _context->savedState->globals) {
+            _stack.push_back(toSlot(global));
+        }
         _globalCount = static_cast<int>(_stack.size());
 
-        std::vector<Variable> locals(_context->savedState->locals);
-        copy(locals.begin(), locals.end(), back_inserter(_stack));
+        for (auto &local : _context->savedState->locals) {
+            _stack.push_back(toSlot(local));
+        }
 
         insOff = _context->savedState->insOffset;
     }
 
-    debug(str(boost::format("Run '%s': offset=%04x, caller=%u, triggerrer=%u") %
-              _program->name() %
-              insOff %
-              _context->callerId %
-              _context->triggererId),
-          LogChannel::Script);
+    if (Logger::instance.isChannelEnabled(LogChannel::Script)) {
+        debug(str(boost::format("Run '%s': offset=%04x, caller=%u, triggerrer=%u") %
+                  _program->name() %
+                  insOff %
+                  _context->callerId %
+                  _context->triggererId),
+              LogChannel::Script);
+    }
 
-    while (insOff < _program->length()) {
-        const Instruction &ins = _program->getInstruction(insOff);
-        auto handler = _handlers.find(ins.type);
+    bool traceInstructions = Logger::instance.isChannelEnabled(LogChannel::Script3);
+    int insIdx = _program->getInstructionIndex(insOff);
 
-        if (handler == _handlers.end()) {
-            error(str(boost::format("Instruction not implemented: %04x") % static_cast<int>(ins.type)), LogChannel::Script);
-            return -1;
-        }
-        _nextInstruction = ins.nextOffset;
+    try {
+        while (insIdx != numInstructions) {
+            if (_checked && (insIdx < 0 || insIdx > numInstructions)) {
+                throw std::runtime_error(str(boost::format("Invalid instruction index: %d") % insIdx));
+            }
+            const CompiledInstruction &compiled = instructions[insIdx];
+            _nextIdx = compiled.nextIdx;
 
-        if (Logger::instance.isChannelEnabled(LogChannel::Script3)) {
-            debug(str(boost::format("Instruction: %s") % describeInstruction(ins, *_context->routines)), LogChannel::Script3);
-        }
-        try {
-            handler->second(ins);
-        } catch (const std::exception &ex) {
-            debug(str(boost::format("Halt '%s'") % _program->name()), LogChannel::Script);
-            return -1;
-        }
+            if (traceInstructions) {
+                debug(str(boost::format("Instruction: %s") % describeInstruction(*compiled.ins, *_context->routines)), LogChannel::Script3);
+            }
+            switch (compiled.type) {
+            case InstructionType::NOP:
+            case InstructionType::NOP2:
+                break;
+            R_INSTR_CASE(CPDOWNSP)
+            R_INSTR_CASE(RSADDI)
+            R_INSTR_CASE(RSADDF)
+            R_INSTR_CASE(RSADDS)
+            R_INSTR_CASE(RSADDO)
+            R_INSTR_CASE(RSADDEFF)
+            R_INSTR_CASE(RSADDEVT)
+            R_INSTR_CASE(RSADDLOC)
+            R_INSTR_CASE(RSADDTAL)
+            R_INSTR_CASE(CPTOPSP)
+            R_INSTR_CASE(CONSTI)
+            R_INSTR_CASE(CONSTF)
+            R_INSTR_CASE(CONSTS)
+            R_INSTR_CASE(CONSTO)
+            R_INSTR_CASE(ACTION)
+            R_INSTR_CASE(LOGANDII)
+            R_INSTR_CASE(LOGORII)
+            R_INSTR_CASE(INCORII)
+            R_INSTR_CASE(EXCORII)
+            R_INSTR_CASE(BOOLANDII)
+            R_INSTR_CASE(EQUALII)
+            R_INSTR_CASE(EQUALFF)
+            R_INSTR_CASE(EQUALSS)
+            R_INSTR_CASE(EQUALOO)
+            R_INSTR_CASE(EQUALTT)
+            R_INSTR_CASE(EQUALEFFEFF)
+            R_INSTR_CASE(EQUALEVTEVT)
+            R_INSTR_CASE(EQUALLOCLOC)
+            R_INSTR_CASE(EQUALTALTAL)
+            R_INSTR_CASE(NEQUALII)
+            R_INSTR_CASE(NEQUALFF)
+            R_INSTR_CASE(NEQUALSS)
+            R_INSTR_CASE(NEQUALOO)
+            R_INSTR_CASE(NEQUALTT)
+            R_INSTR_CASE(NEQUALEFFEFF)
+            R_INSTR_CASE(NEQUALEVTEVT)
+            R_INSTR_CASE(NEQUALLOCLOC)
+            R_INSTR_CASE(NEQUALTALTAL)
+            R_INSTR_CASE(GEQII)
+            R_INSTR_CASE(GEQFF)
+            R_INSTR_CASE(GTII)
+            R_INSTR_CASE(GTFF)
+            R_INSTR_CASE(LTII)
+            R_INSTR_CASE(LTFF)
+            R_INSTR_CASE(LEQII)
+            R_INSTR_CASE(LEQFF)
+            R_INSTR_CASE(SHLEFTII)
+            R_INSTR_CASE(SHRIGHTII)
+            R_INSTR_CASE(USHRIGHTII)
+            R_INSTR_CASE(ADDII)
+            R_INSTR_CASE(ADDIF)
+            R_INSTR_CASE(ADDFI)
+            R_INSTR_CASE(ADDFF)
+            R_INSTR_CASE(ADDSS)
+            R_INSTR_CASE(ADDVV)
+            R_INSTR_CASE(SUBII)
+            R_INSTR_CASE(SUBIF)
+            R_INSTR_CASE(SUBFI)
+            R_INSTR_CASE(SUBFF)
+            R_INSTR_CASE(SUBVV)
+            R_INSTR_CASE(MULII)
+            R_INSTR_CASE(MULIF)
+            R_INSTR_CASE(MULFI)
+            R_INSTR_CASE(MULFF)
+            R_INSTR_CASE(MULVF)
+            R_INSTR_CASE(MULFV)
+            R_INSTR_CASE(DIVII)
+            R_INSTR_CASE(DIVIF)
+            R_INSTR_CASE(DIVFI)
+            R_INSTR_CASE(DIVFF)
+            R_INSTR_CASE(DIVVF)
+            R_INSTR_CASE(DIVFV)
+            R_INSTR_CASE(MODII)
+            R_INSTR_CASE(NEGI)
+            R_INSTR_CASE(NEGF)
+            R_INSTR_CASE(MOVSP)
+            R_JUMP_CASE(JMP)
+            R_JUMP_CASE(JSR)
+            R_JUMP_CASE(JZ)
+            R_JUMP_CASE(RETN)
+            R_INSTR_CASE(DESTRUCT)
+            R_INSTR_CASE(NOTI)
+            R_INSTR_CASE(DECISP)
+            R_INSTR_CASE(INCISP)
+            R_JUMP_CASE(JNZ)
+            R_INSTR_CASE(CPDOWNBP)
+            R_INSTR_CASE(CPTOPBP)
+            R_INSTR_CASE(DECIBP)
+            R_INSTR_CASE(INCIBP)
+            R_INSTR_CASE(SAVEBP)
+            R_INSTR_CASE(RESTOREBP)
+            R_INSTR_CASE(STORE_STATE)
+            default:
+                error(str(boost::format("Instruction not implemented: %04x") % static_cast<int>(compiled.type)), LogChannel::Script);
+                return -1;
+            }
 
-        insOff = _nextInstruction;
+            insIdx = _nextIdx;
+        }
+    } catch (const std::exception &ex) {
+        debug(str(boost::format("Halt '%s'") % _program->name()), LogChannel::Script);
+        return -1;
     }
 
     if (!_stack.empty() && _stack.back().type == VariableType::Int) {
@@ -188,6 +213,26 @@ int VirtualMachine::run() {
     return -1;
 }
 
+#undef R_JUMP_CASE
+#undef R_INSTR_CASE
+
+void VirtualMachine::reset(std::shared_ptr<ScriptProgram> program) {
+    _program = std::move(program);
+    _checked = !_program || !_program->isVerified();
+    _stack.clear();
+    _returnIndices.clear();
+    _nextIdx = 0;
+    _globalCount = 0;
+    _savedState.program.reset();
+    _savedState.globals.clear();
+    _savedState.locals.clear();
+    _savedState.insOffset = 0;
+    _strings.clear();
+    _engineTypes.clear();
+    _actions.clear();
+    _routineArgs.clear();
+}
+
 void VirtualMachine::executeCPDOWNSP(const Instruction &ins) {
     int count = ins.size / 4;
     int srcIdx = static_cast<int>(_stack.size()) - count;
@@ -199,35 +244,35 @@ void VirtualMachine::executeCPDOWNSP(const Instruction &ins) {
 }
 
 void VirtualMachine::executeRSADDI(const Instruction &ins) {
-    _stack.push_back(Variable::ofInt(0));
+    _stack.push_back(StackSlot::ofInt(0));
 }
 
 void VirtualMachine::executeRSADDF(const Instruction &ins) {
-    _stack.push_back(Variable::ofFloat(0.0f));
+    _stack.push_back(StackSlot::ofFloat(0.0f));
 }
 
 void VirtualMachine::executeRSADDS(const Instruction &ins) {
-    _stack.push_back(Variable::ofString(""));
+    _stack.push_back(StackSlot::ofString(g_emptyString));
 }
 
 void VirtualMachine::executeRSADDO(const Instruction &ins) {
-    _stack.push_back(Variable::ofObject(kObjectInvalid));
+    _stack.push_back(StackSlot::ofObject(kObjectInvalid));
 }
 
 void VirtualMachine::executeRSADDEFF(const Instruction &ins) {
-    _stack.push_back(Variable::ofEffect(nullptr));
+    _stack.push_back(StackSlot::ofRef(VariableType::Effect, StackSlot::kNullRef));
 }
 
 void VirtualMachine::executeRSADDEVT(const Instruction &ins) {
-    _stack.push_back(Variable::ofEvent(nullptr));
+    _stack.push_back(StackSlot::ofRef(VariableType::Event, StackSlot::kNullRef));
 }
 
 void VirtualMachine::executeRSADDLOC(const Instruction &ins) {
-    _stack.push_back(Variable::ofLocation(nullptr));
+    _stack.push_back(StackSlot::ofRef(VariableType::Location, StackSlot::kNullRef));
 }
 
 void VirtualMachine::executeRSADDTAL(const Instruction &ins) {
-    _stack.push_back(Variable::ofTalent(nullptr));
+    _stack.push_back(StackSlot::ofRef(VariableType::Talent, StackSlot::kNullRef));
 }
 
 void VirtualMachine::executeCPTOPSP(const Instruction &ins) {
@@ -240,20 +285,20 @@ void VirtualMachine::executeCPTOPSP(const Instruction &ins) {
 }
 
 void VirtualMachine::executeCONSTI(const Instruction &ins) {
-    _stack.push_back(Variable::ofInt(ins.intValue));
+    _stack.push_back(StackSlot::ofInt(ins.intValue));
 }
 
 void VirtualMachine::executeCONSTF(const Instruction &ins) {
-    _stack.push_back(Variable::ofFloat(ins.floatValue));
+    _stack.push_back(StackSlot::ofFloat(ins.floatValue));
 }
 
 void VirtualMachine::executeCONSTS(const Instruction &ins) {
-    _stack.push_back(Variable::ofString(ins.strValue));
+    _stack.push_back(StackSlot::ofString(ins.strValue));
 }
 
 void VirtualMachine::executeCONSTO(const Instruction &ins) {
     uint32_t objectId = ins.objectId == kObjectSelf ? _context->callerId : ins.objectId;
-    _stack.push_back(Variable::ofObject(objectId));
+    _stack.push_back(StackSlot::ofObject(objectId));
 }
 
 void VirtualMachine::executeACTION(const Instruction &ins) {
@@ -262,7 +307,8 @@ void VirtualMachine::executeACTION(const Instruction &ins) {
         throw std::invalid_argument("Too many routine arguments");
     }
 
-    std::vector<Variable> args;
+    auto &args = _routineArgs;
+    args.clear();
     for (int i = 0; i < ins.argCount; ++i) {
         VariableType type = routine.getArgumentType(i);
         switch (type) {
@@ -277,17 +323,20 @@ void VirtualMachine::executeACTION(const Instruction &ins) {
             break;
         }
         default:
-            Variable var(_stack.back());
-            if (var.type != type) {
+            if (_checked && _stack.back().type != type) {
                 throw std::runtime_error("Invalid argument variable type");
             }
-            args.push_back(std::move(var));
+            args.push_back(toVariable(_stack.back()));
             _stack.pop_back();
             break;
         }
     }
 
     Variable retValue = routine.invoke(args, *_context);
+    if (!_checked && routine.returnType() != VariableType::Void && retValue.type != routine.returnType()) {
+        // Verified programs rely on routines honoring their declared return type
+        throw std::runtime_error("Invalid return variable type");
+    }
     if (Logger::instance.isChannelEnabled(LogChannel::Script2)) {
         std::vector<std::string> argStrings;
         for (auto &arg : args) {
@@ -300,225 +349,223 @@ void VirtualMachine::executeACTION(const Instruction &ins) {
     case VariableType::Void:
         break;
     case VariableType::Vector:
-        _stack.push_back(Variable::ofFloat(retValue.vecValue.z));
-        _stack.push_back(Variable::ofFloat(retValue.vecValue.y));
-        _stack.push_back(Variable::ofFloat(retValue.vecValue.x));
+        _stack.push_back(StackSlot::ofFloat(retValue.vecValue.z));
+        _stack.push_back(StackSlot::ofFloat(retValue.vecValue.y));
+        _stack.push_back(StackSlot::ofFloat(retValue.vecValue.x));
         break;
     default:
-        _stack.push_back(retValue);
+        _stack.push_back(toSlot(std::move(retValue)));
         break;
     }
 }
 
 void VirtualMachine::executeLOGANDII(const Instruction &ins) {
     withIntsFromStack([this](int left, int right) {
-        _stack.push_back(Variable::ofInt(static_cast<int>(left && right)));
+        _stack.push_back(StackSlot::ofInt(static_cast<int>(left && right)));
     });
 }
 
 void VirtualMachine::executeLOGORII(const Instruction &ins) {
     withIntsFromStack([this](int left, int right) {
-        _stack.push_back(Variable::ofInt(static_cast<int>(left || right)));
+        _stack.push_back(StackSlot::ofInt(static_cast<int>(left || right)));
     });
 }
 
 void VirtualMachine::executeINCORII(const Instruction &ins) {
     withIntsFromStack([this](int left, int right) {
-        _stack.push_back(Variable::ofInt(left | right));
+        _stack.push_back(StackSlot::ofInt(left | right));
     });
 }
 
 void VirtualMachine::executeEXCORII(const Instruction &ins) {
     withIntsFromStack([this](int left, int right) {
-        _stack.push_back(Variable::ofInt(left ^ right));
+        _stack.push_back(StackSlot::ofInt(left ^ right));
     });
 }
 
 void VirtualMachine::executeBOOLANDII(const Instruction &ins) {
     withIntsFromStack([this](int left, int right) {
-        _stack.push_back(Variable::ofInt(left & right));
+        _stack.push_back(StackSlot::ofInt(left & right));
     });
 }
 
 void VirtualMachine::executeEQUALII(const Instruction &ins) {
     withIntsFromStack([this](int left, int right) {
-        _stack.push_back(Variable::ofInt(static_cast<int>(left == right)));
+        _stack.push_back(StackSlot::ofInt(static_cast<int>(left == right)));
     });
 }
 
 void VirtualMachine::executeEQUALFF(const Instruction &ins) {
     withFloatsFromStack([this](float left, float right) {
-        _stack.push_back(Variable::ofInt(static_cast<int>(fabs(left - right) < kFloatTolerance)));
+        _stack.push_back(StackSlot::ofInt(static_cast<int>(fabs(left - right) < kFloatTolerance)));
     });
 }
 
 void VirtualMachine::executeEQUALSS(const Instruction &ins) {
     withStringsFromStack([this](auto &left, auto &right) {
-        _stack.push_back(Variable::ofInt(static_cast<int>(left == right)));
+        _stack.push_back(StackSlot::ofInt(static_cast<int>(left == right)));
     });
 }
 
 void VirtualMachine::executeEQUALOO(const Instruction &ins) {
     withObjectsFromStack([this](uint32_t left, uint32_t right) {
-        _stack.push_back(Variable::ofInt(static_cast<int>(left == right)));
+        _stack.push_back(StackSlot::ofInt(static_cast<int>(left == right)));
     });
 }
 
 void VirtualMachine::executeEQUALTT(const Instruction &ins) {
     int numVariables = ins.size / 4;
-    std::vector<Variable> vars1;
-    for (int i = 0; i < numVariables; ++i) {
-        vars1.push_back(std::move(_stack.back()));
-        _stack.pop_back();
-    }
-    std::vector<Variable> vars2;
+    int rightIdx = static_cast<int>(_stack.size()) - numVariables;
+    int leftIdx = rightIdx - numVariables;
+    bool equal = true;
     for (int i = 0; i < numVariables; ++i) {
-        vars2.push_back(std::move(_stack.back()));
-        _stack.pop_back();
+        if (!slotsEqual(_stack[leftIdx + i], _stack[rightIdx + i])) {
+            equal = false;
+            break;
+        }
     }
-    bool equal = std::equal(vars1.begin(), vars1.end(), vars2.begin());
-    _stack.push_back(Variable::ofInt(static_cast<int>(equal)));
+    _stack.resize(leftIdx);
+    _stack.push_back(StackSlot::ofInt(static_cast<int>(equal)));
 }
 
 void VirtualMachine::executeEQUALEFFEFF(const Instruction &ins) {
     withEffectsFromStack([this](auto &left, auto &right) {
-        _stack.push_back(Variable::ofInt(static_cast<int>(left == right)));
+        _stack.push_back(StackSlot::ofInt(static_cast<int>(left == right)));
     });
 }
 
 void VirtualMachine::executeEQUALEVTEVT(const Instruction &ins) {
     withEventsFromStack([this](auto &left, auto &right) {
-        _stack.push_back(Variable::ofInt(static_cast<int>(left == right)));
+        _stack.push_back(StackSlot::ofInt(static_cast<int>(left == right)));
     });
 }
 
 void VirtualMachine::executeEQUALLOCLOC(const Instruction &ins) {
     withLocationsFromStack([this](auto &left, auto &right) {
-        _stack.push_back(Variable::ofInt(static_cast<int>(left == right)));
+        _stack.push_back(StackSlot::ofInt(static_cast<int>(left == right)));
     });
 }
 
 void VirtualMachine::executeEQUALTALTAL(const Instruction &ins) {
     withTalentsFromStack([this](auto &left, auto &right) {
-        _stack.push_back(Variable::ofInt(static_cast<int>(left == right)));
+        _stack.push_back(StackSlot::ofInt(static_cast<int>(left == right)));
     });
 }
 
 void VirtualMachine::executeNEQUALII(const Instruction &ins) {
     withIntsFromStack([this](int left, int right) {
-        _stack.push_back(Variable::ofInt(static_cast<int>(left != right)));
+        _stack.push_back(StackSlot::ofInt(static_cast<int>(left != right)));
     });
 }
 
 void VirtualMachine::executeNEQUALFF(const Instruction &ins) {
     withFloatsFromStack([this](float left, float right) {
-        _stack.push_back(Variable::ofInt(static_cast<int>(left != right)));
+        _stack.push_back(StackSlot::ofInt(static_cast<int>(left != right)));
     });
 }
 
 void VirtualMachine::executeNEQUALSS(const Instruction &ins) {
     withStringsFromStack([this](auto &left, auto &right) {
-        _stack.push_back(Variable::ofInt(static_cast<int>(left != right)));
+        _stack.push_back(StackSlot::ofInt(static_cast<int>(left != right)));
     });
 }
 
 void VirtualMachine::executeNEQUALOO(const Instruction &ins) {
     withObjectsFromStack([this](uint32_t left, uint32_t right) {
-        _stack.push_back(Variable::ofInt(static_cast<int>(left != right)));
+        _stack.push_back(StackSlot::ofInt(static_cast<int>(left != right)));
     });
 }
 
 void VirtualMachine::executeNEQUALTT(const Instruction &ins) {
     int numVariables = ins.size / 4;
-    std::vector<Variable> vars1;
+    int rightIdx = static_cast<int>(_stack.size()) - numVariables;
+    int leftIdx = rightIdx - numVariables;
+    bool equal = true;
     for (int i = 0; i < numVariables; ++i) {
-        vars1.push_back(std::move(_stack.back()));
-        _stack.pop_back();
-    }
-    std::vector<Variable> vars2;
-    for (int i = 0; i < numVariables; ++i) {
-        vars2.push_back(std::move(_stack.back()));
-        _stack.pop_back();
+        if (!slotsEqual(_stack[leftIdx + i], _stack[rightIdx + i])) {
+            equal = false;
+            break;
+        }
     }
-    bool notEqual = !std::equal(vars1.begin(), vars1.end(), vars2.begin());
-    _stack.push_back(Variable::ofInt(static_cast<int>(notEqual)));
+    _stack.resize(leftIdx);
+    _stack.push_back(StackSlot::ofInt(static_cast<int>(!equal)));
 }
 
 void VirtualMachine::executeNEQUALEFFEFF(const Instruction &ins) {
     withEffectsFromStack([this](auto &left, auto &right) {
-        _stack.push_back(Variable::ofInt(static_cast<int>(left != right)));
+        _stack.push_back(StackSlot::ofInt(static_cast<int>(left != right)));
     });
 }
 
 void VirtualMachine::executeNEQUALEVTEVT(const Instruction &ins) {
     withEventsFromStack([this](auto &left, auto &right) {
-        _stack.push_back(Variable::ofInt(static_cast<int>(left != right)));
+        _stack.push_back(StackSlot::ofInt(static_cast<int>(left != right)));
     });
 }
 
 void VirtualMachine::executeNEQUALLOCLOC(const Instruction &ins) {
     withLocationsFromStack([this](auto &left, auto &right) {
-        _stack.push_back(Variable::ofInt(static_cast<int>(left != right)));
+        _stack.push_back(StackSlot::ofInt(static_cast<int>(left != right)));
     });
 }
 
 void VirtualMachine::executeNEQUALTALTAL(const Instruction &ins) {
     withTalentsFromStack([this](auto &left, auto &right) {
-        _stack.push_back(Variable::ofInt(static_cast<int>(left != right)));
+        _stack.push_back(StackSlot::ofInt(static_cast<int>(left != right)));
     });
 }
 
 void VirtualMachine::executeGEQII(const Instruction &ins) {
     withIntsFromStack([this](int left, int right) {
-        _stack.push_back(Variable::ofInt(static_cast<int>(left >= right)));
+        _stack.push_back(StackSlot::ofInt(static_cast<int>(left >= right)));
     });
 }
 
 void VirtualMachine::executeGEQFF(const Instruction &ins) {
     withFloatsFromStack([this](float left, float right) {
-        _stack.push_back(Variable::ofInt(static_cast<int>(left >= right)));
+        _stack.push_back(StackSlot::ofInt(static_cast<int>(left >= right)));
     });
 }
 
 void VirtualMachine::executeGTII(const Instruction &ins) {
     withIntsFromStack([this](int left, int right) {
-        _stack.push_back(Variable::ofInt(static_cast<int>(left > right)));
+        _stack.push_back(StackSlot::ofInt(static_cast<int>(left > right)));
     });
 }
 
 void VirtualMachine::executeGTFF(const Instruction &ins) {
     withFloatsFromStack([this](float left, float right) {
-        _stack.push_back(Variable::ofInt(static_cast<int>(left > right)));
+        _stack.push_back(StackSlot::ofInt(static_cast<int>(left > right)));
     });
 }
 
 void VirtualMachine::executeLTII(const Instruction &ins) {
     withIntsFromStack([this](int left, int right) {
-        _stack.push_back(Variable::ofInt(static_cast<int>(left < right)));
+        _stack.push_back(StackSlot::ofInt(static_cast<int>(left < right)));
     });
 }
 
 void VirtualMachine::executeLTFF(const Instruction &ins) {
     withFloatsFromStack([this](float left, float right) {
-        _stack.push_back(Variable::ofInt(static_cast<int>(left < right)));
+        _stack.push_back(StackSlot::ofInt(static_cast<int>(left < right)));
     });
 }
 
 void VirtualMachine::executeLEQII(const Instruction &ins) {
     withIntsFromStack([this](int left, int right) {
-        _stack.push_back(Variable::ofInt(static_cast<int>(left <= right)));
+        _stack.push_back(StackSlot::ofInt(static_cast<int>(left <= right)));
     });
 }
 
 void VirtualMachine::executeLEQFF(const Instruction &ins) {
     withFloatsFromStack([this](float left, float right) {
-        _stack.push_back(Variable::ofInt(static_cast<int>(left <= right)));
+        _stack.push_back(StackSlot::ofInt(static_cast<int>(left <= right)));
     });
 }
 
 void VirtualMachine::executeSHLEFTII(const Instruction &ins) {
     withIntsFromStack([this](int left, int right) {
-        _stack.push_back(Variable::ofInt(left << right));
+        _stack.push_back(StackSlot::ofInt(left << right));
     });
 }
 
@@ -530,175 +577,175 @@ void VirtualMachine::executeSHRIGHTII(const Instruction &ins) {
         } else {
             result >>= right;
         }
-        _stack.push_back(Variable::ofInt(result));
+        _stack.push_back(StackSlot::ofInt(result));
     });
 }
 
 void VirtualMachine::executeUSHRIGHTII(const Instruction &ins) {
     withIntsFromStack([this](int left, int right) {
-        _stack.push_back(Variable::ofInt(static_cast<unsigned int>(left) >> right));
+        _stack.push_back(StackSlot::ofInt(static_cast<unsigned int>(left) >> right));
     });
 }
 
 void VirtualMachine::executeADDII(const Instruction &ins) {
     withIntsFromStack([this](int left, int right) {
-        _stack.push_back(Variable::ofInt(left + right));
+        _stack.push_back(StackSlot::ofInt(left + right));
     });
 }
 
 void VirtualMachine::executeADDIF(const Instruction &ins) {
     withIntFloatFromStack([this](int left, float right) {
-        _stack.push_back(Variable::ofFloat(left + right));
+        _stack.push_back(StackSlot::ofFloat(left + right));
     });
 }
 
 void VirtualMachine::executeADDFI(const Instruction &ins) {
     withFloatIntFromStack([this](float left, int right) {
-        _stack.push_back(Variable::ofFloat(left + right));
+        _stack.push_back(StackSlot::ofFloat(left + right));
     });
 }
 
 void VirtualMachine::executeADDFF(const Instruction &ins) {
     withFloatsFromStack([this](float left, float right) {
-        _stack.push_back(Variable::ofFloat(left + right));
+        _stack.push_back(StackSlot::ofFloat(left + right));
     });
 }
 
 void VirtualMachine::executeADDSS(const Instruction &ins) {
     withStringsFromStack([this](auto &left, auto &right) {
-        _stack.push_back(Variable::ofString(left + right));
+        _stack.push_back(StackSlot::ofString(_strings.emplace_back(left + right)));
     });
 }
 
 void VirtualMachine::executeADDVV(const Instruction &ins) {
     withVectorsFromStack([this](auto &left, auto &right) {
         auto result = left + right;
-        _stack.push_back(Variable::ofFloat(result.x));
-        _stack.push_back(Variable::ofFloat(result.y));
-        _stack.push_back(Variable::ofFloat(result.z));
+        _stack.push_back(StackSlot::ofFloat(result.x));
+        _stack.push_back(StackSlot::ofFloat(result.y));
+        _stack.push_back(StackSlot::ofFloat(result.z));
     });
 }
 
 void VirtualMachine::executeSUBII(const Instruction &ins) {
     withIntsFromStack([this](int left, int right) {
-        _stack.push_back(Variable::ofInt(left - right));
+        _stack.push_back(StackSlot::ofInt(left - right));
     });
 }
 
 void VirtualMachine::executeSUBIF(const Instruction &ins) {
     withIntFloatFromStack([this](int left, float right) {
-        _stack.push_back(Variable::ofFloat(left - right));
+        _stack.push_back(StackSlot::ofFloat(left - right));
     });
 }
 
 void VirtualMachine::executeSUBFI(const Instruction &ins) {
     withFloatIntFromStack([this](float left, int right) {
-        _stack.push_back(Variable::ofFloat(left - right));
+        _stack.push_back(StackSlot::ofFloat(left - right));
     });
 }
 
 void VirtualMachine::executeSUBFF(const Instruction &ins) {
     withFloatsFromStack([this](float left, float right) {
-        _stack.push_back(Variable::ofFloat(left - right));
+        _stack.push_back(StackSlot::ofFloat(left - right));
     });
 }
 
 void VirtualMachine::executeSUBVV(const Instruction &ins) {
     withVectorsFromStack([this](auto &left, auto &right) {
         auto result = left - right;
-        _stack.push_back(Variable::ofFloat(result.x));
-        _stack.push_back(Variable::ofFloat(result.y));
-        _stack.push_back(Variable::ofFloat(result.z));
+        _stack.push_back(StackSlot::ofFloat(result.x));
+        _stack.push_back(StackSlot::ofFloat(result.y));
+        _stack.push_back(StackSlot::ofFloat(result.z));
     });
 }
 
 void VirtualMachine::executeMULII(const Instruction &ins) {
     withIntsFromStack([this](int left, int right) {
-        _stack.push_back(Variable::ofInt(left * right));
+        _stack.push_back(StackSlot::ofInt(left * right));
     });
 }
 
 void VirtualMachine::executeMULIF(const Instruction &ins) {
     withIntFloatFromStack([this](int left, float right) {
-        _stack.push_back(Variable::ofFloat(left * right));
+        _stack.push_back(StackSlot::ofFloat(left * right));
     });
 }
 
 void VirtualMachine::executeMULFI(const Instruction &ins) {
     withFloatIntFromStack([this](float left, int right) {
-        _stack.push_back(Variable::ofFloat(left * right));
+        _stack.push_back(StackSlot::ofFloat(left * right));
     });
 }
 
 void VirtualMachine::executeMULFF(const Instruction &ins) {
     withFloatsFromStack([this](float left, float right) {
-        _stack.push_back(Variable::ofFloat(left * right));
+        _stack.push_back(StackSlot::ofFloat(left * right));
     });
 }
 
 void VirtualMachine::executeMULVF(const Instruction &ins) {
     withVectorFloatFromStack([this](auto &left, float right) {
         auto result = left * right;
-        _stack.push_back(Variable::ofFloat(result.x));
-        _stack.push_back(Variable::ofFloat(result.y));
-        _stack.push_back(Variable::ofFloat(result.z));
+        _stack.push_back(StackSlot::ofFloat(result.x));
+        _stack.push_back(StackSlot::ofFloat(result.y));
+        _stack.push_back(StackSlot::ofFloat(result.z));
     });
 }
 
 void VirtualMachine::executeMULFV(const Instruction &ins) {
     withFloatVectorFromStack([this](float left, auto &right) {
         auto result = left * right;
-        _stack.push_back(Variable::ofFloat(result.x));
-        _stack.push_back(Variable::ofFloat(result.y));
-        _stack.push_back(Variable::ofFloat(result.z));
+        _stack.push_back(StackSlot::ofFloat(result.x));
+        _stack.push_back(StackSlot::ofFloat(result.y));
+        _stack.push_back(StackSlot::ofFloat(result.z));
     });
 }
 
 void VirtualMachine::executeDIVII(const Instruction &ins) {
     withIntsFromStack([this](int left, int right) {
-        _stack.push_back(Variable::ofInt(left / right));
+        _stack.push_back(StackSlot::ofInt(left / right));
     });
 }
 
 void VirtualMachine::executeDIVIF(const Instruction &ins) {
     withIntFloatFromStack([this](int left, float right) {
-        _stack.push_back(Variable::ofFloat(left / std::max(kFloatTolerance, right)));
+        _stack.push_back(StackSlot::ofFloat(left / std::max(kFloatTolerance, right)));
     });
 }
 
 void VirtualMachine::executeDIVFI(const Instruction &ins) {
     withFloatIntFromStack([this](float left, int right) {
-        _stack.push_back(Variable::ofFloat(left / right));
+        _stack.push_back(StackSlot::ofFloat(left / right));
     });
 }
 
 void VirtualMachine::executeDIVFF(const Instruction &ins) {
     withFloatsFromStack([this](float left, float right) {
-        _stack.push_back(Variable::ofFloat(left / std::max(kFloatTolerance, right)));
+        _stack.push_back(StackSlot::ofFloat(left / std::max(kFloatTolerance, right)));
     });
 }
 
 void VirtualMachine::executeDIVVF(const Instruction &ins) {
     withVectorFloatFromStack([this](auto &left, float right) {
         auto result = left / right;
-        _stack.push_back(Variable::ofFloat(result.x));
-        _stack.push_back(Variable::ofFloat(result.y));
-        _stack.push_back(Variable::ofFloat(result.z));
+        _stack.push_back(StackSlot::ofFloat(result.x));
+        _stack.push_back(StackSlot::ofFloat(result.y));
+        _stack.push_back(StackSlot::ofFloat(result.z));
     });
 }
 
 void VirtualMachine::executeDIVFV(const Instruction &ins) {
     withFloatVectorFromStack([this](float left, auto &right) {
         auto result = left / right;
-        _stack.push_back(Variable::ofFloat(result.x));
-        _stack.push_back(Variable::ofFloat(result.y));
-        _stack.push_back(Variable::ofFloat(result.z));
+        _stack.push_back(StackSlot::ofFloat(result.x));
+        _stack.push_back(StackSlot::ofFloat(result.y));
+        _stack.push_back(StackSlot::ofFloat(result.z));
     });
 }
 
 void VirtualMachine::executeMODII(const Instruction &ins) {
     withIntsFromStack([this](int left, int right) {
-        _stack.push_back(Variable::ofInt(left % right));
+        _stack.push_back(StackSlot::ofInt(left % right));
     });
 }
 
@@ -717,28 +764,28 @@ void VirtualMachine::executeMOVSP(const Instruction &ins) {
     }
 }
 
-void VirtualMachine::executeJMP(const Instruction &ins) {
-    _nextInstruction = ins.offset + ins.jumpOffset;
+void VirtualMachine::executeJMP(const CompiledInstruction &ins) {
+    _nextIdx = getJumpTarget(ins);
 }
 
-void VirtualMachine::executeJSR(const Instruction &ins) {
-    _returnOffsets.push_back(ins.nextOffset);
-    _nextInstruction = ins.offset + ins.jumpOffset;
+void VirtualMachine::executeJSR(const CompiledInstruction &ins) {
+    _returnIndices.push_back(ins.nextIdx);
+    _nextIdx = getJumpTarget(ins);
 }
 
-void VirtualMachine::executeJZ(const Instruction &ins) {
+void VirtualMachine::executeJZ(const CompiledInstruction &ins) {
     bool zero = getIntFromStack() == 0;
     if (zero) {
-        _nextInstruction = ins.offset + ins.jumpOffset;
+        _nextIdx = getJumpTarget(ins);
     }
 }
 
-void VirtualMachine::executeRETN(const Instruction &ins) {
-    if (_returnOffsets.empty()) {
-        _nextInstruction = _program->length();
+void VirtualMachine::executeRETN(const CompiledInstruction &ins) {
+    if (_returnIndices.empty()) {
+        _nextIdx = static_cast<int>(_program->instructions().size());
     } else {
-        _nextInstruction = _returnOffsets.back();
-        _returnOffsets.pop_back();
+        _nextIdx = _returnIndices.back();
+        _returnIndices.pop_back();
     }
 }
 
@@ -765,13 +812,13 @@ void VirtualMachine::executeINCISP(const Instruction &ins) {
 
 void VirtualMachine::executeNOTI(const Instruction &ins) {
     int value = getIntFromStack();
-    _stack.push_back(Variable::ofInt(static_cast<int>(!value)));
+    _stack.push_back(StackSlot::ofInt(static_cast<int>(!value)));
 }
 
-void VirtualMachine::executeJNZ(const Instruction &ins) {
+void VirtualMachine::executeJNZ(const CompiledInstruction &ins) {
     bool notZero = getIntFromStack() != 0;
     if (notZero) {
-        _nextInstruction = ins.offset + ins.jumpOffset;
+        _nextIdx = getJumpTarget(ins);
     }
 }
 
@@ -806,7 +853,7 @@ void VirtualMachine::executeINCIBP(const Instruction &ins) {
 
 void VirtualMachine::executeSAVEBP(const Instruction &ins) {
     _globalCount = static_cast<int>(_stack.size());
-    _stack.push_back(Variable::ofInt(_globalCount));
+    _stack.push_back(StackSlot::ofInt(_globalCount));
 }
 
 void VirtualMachine::executeRESTOREBP(const Instruction &ins) {
@@ -819,7 +866,7 @@ void VirtualMachine::executeSTORE_STATE(const Instruction &ins) {
 
     _savedState.globals.clear();
     for (int i = 0; i < count; ++i) {
-        _savedState.globals.push_back(_stack[srcIdx++]);
+        _savedState.globals.push_back(toVariable(_stack[srcIdx++]));
     }
 
     count = ins.sizeLocals / 4;
@@ -827,7 +874,7 @@ void VirtualMachine::executeSTORE_STATE(const Instruction &ins) {
 
     _savedState.locals.clear();
     for (int i = 0; i < count; ++i) {
-        _savedState.locals.push_back(_stack[srcIdx++]);
+        _savedState.locals.push_back(toVariable(_stack[srcIdx++]));
     }
 
     _savedState.program = _program;
@@ -835,21 +882,21 @@ void VirtualMachine::executeSTORE_STATE(const Instruction &ins) {
 }
 
 int VirtualMachine::getIntFromStack() {
-    Variable var(std::move(_stack.back()));
+    StackSlot slot = _stack.back();
     _stack.pop_back();
 
-    throwIfInvalidType(VariableType::Int, var.type);
+    throwIfInvalidType(VariableType::Int, slot.type);
 
-    return var.intValue;
+    return slot.intValue;
 }
 
 float VirtualMachine::getFloatFromStack() {
-    Variable var(std::move(_stack.back()));
+    StackSlot slot = _stack.back();
     _stack.pop_back();
 
-    throwIfInvalidType(VariableType::Float, var.type);
+    throwIfInvalidType(VariableType::Float, slot.type);
 
-    return var.floatValue;
+    return slot.floatValue;
 }
 
 glm::vec3 VirtualMachine::getVectorFromStack() {
@@ -860,18 +907,18 @@ glm::vec3 VirtualMachine::getVectorFromStack() {
     return glm::vec3(x, y, z);
 }
 
-void VirtualMachine::withStackVariables(const std::function<void(const Variable &, const Variable &)> &fn) {
-    Variable second(std::move(_stack.back()));
+void VirtualMachine::withStackSlots(const std::function<void(const StackSlot &, const StackSlot &)> &fn) {
+    StackSlot second = _stack.back();
     _stack.pop_back();
 
-    Variable first(std::move(_stack.back()));
+    StackSlot first = _stack.back();
     _stack.pop_back();
 
     fn(first, second);
 }
 
 void VirtualMachine::withIntsFromStack(const std::function<void(int, int)> &fn) {
-    withStackVariables([this, &fn](auto &left, auto &right) {
+    withStackSlots([this, &fn](auto &left, auto &right) {
         throwIfInvalidType(VariableType::Int, left.type);
         throwIfInvalidType(VariableType::Int, right.type);
         fn(left.intValue, right.intValue);
@@ -879,7 +926,7 @@ void VirtualMachine::withIntsFromStack(const std::function<void(int, int)> &fn)
 }
 
 void VirtualMachine::withIntFloatFromStack(const std::function<void(int, float)> &fn) {
-    withStackVariables([this, &fn](auto &left, auto &right) {
+    withStackSlots([this, &fn](auto &left, auto &right) {
         throwIfInvalidType(VariableType::Int, left.type);
         throwIfInvalidType(VariableType::Float, right.type);
         fn(left.intValue, right.floatValue);
@@ -887,7 +934,7 @@ void VirtualMachine::withIntFloatFromStack(const std::function<void(int, float)>
 }
 
 void VirtualMachine::withFloatIntFromStack(const std::function<void(float, int)> &fn) {
-    withStackVariables([this, &fn](auto &left, auto &right) {
+    withStackSlots([this, &fn](auto &left, auto &right) {
         throwIfInvalidType(VariableType::Float, left.type);
         throwIfInvalidType(VariableType::Int, right.type);
         fn(left.floatValue, right.intValue);
@@ -895,7 +942,7 @@ void VirtualMachine::withFloatIntFromStack(const std::function<void(float, int)>
 }
 
 void VirtualMachine::withFloatsFromStack(const std::function<void(float, float)> &fn) {
-    withStackVariables([this, &fn](auto &left, auto &right) {
+    withStackSlots([this, &fn](auto &left, auto &right) {
         throwIfInvalidType(VariableType::Float, left.type);
         throwIfInvalidType(VariableType::Float, right.type);
         fn(left.floatValue, right.floatValue);
@@ -903,15 +950,15 @@ void VirtualMachine::withFloatsFromStack(const std::function<void(float, float)>
 }
 
 void VirtualMachine::withStringsFromStack(const std::function<void(const std::string &, const std::string &)> &fn) {
-    withStackVariables([this, &fn](auto &left, auto &right) {
+    withStackSlots([this, &fn](auto &left, auto &right) {
         throwIfInvalidType(VariableType::String, left.type);
         throwIfInvalidType(VariableType::String, right.type);
-        fn(left.strValue, right.strValue);
+        fn(*left.strValue, *right.strValue);
     });
 }
 
 void VirtualMachine::withObjectsFromStack(const std::function<void(uint32_t, uint32_t)> &fn) {
-    withStackVariables([this, &fn](auto &left, auto &right) {
+    withStackSlots([this, &fn](auto &left, auto &right) {
         throwIfInvalidType(VariableType::Object, left.type);
         throwIfInvalidType(VariableType::Object, right.type);
         fn(left.objectId, right.objectId);
@@ -919,34 +966,34 @@ void VirtualMachine::withObjectsFromStack(const std::function<void(uint32_t, uin
 }
 
 void VirtualMachine::withEffectsFromStack(const std::function<void(const std::shared_ptr<EngineType> &, const std::shared_ptr<EngineType> &)> &fn) {
-    withStackVariables([this, &fn](auto &left, auto &right) {
+    withStackSlots([this, &fn](auto &left, auto &right) {
         throwIfInvalidType(VariableType::Effect, left.type);
         throwIfInvalidType(VariableType::Effect, right.type);
-        fn(left.engineType, right.engineType);
+        fn(getEngineType(left), getEngineType(right));
     });
 }
 
 void VirtualMachine::withEventsFromStack(const std::function<void(const std::shared_ptr<EngineType> &, const std::shared_ptr<EngineType> &)> &fn) {
-    withStackVariables([this, &fn](auto &left, auto &right) {
+    withStackSlots([this, &fn](auto &left, auto &right) {
         throwIfInvalidType(VariableType::Event, left.type);
         throwIfInvalidType(VariableType::Event, right.type);
-        fn(left.engineType, right.engineType);
+        fn(getEngineType(left), getEngineType(right));
     });
 }
 
 void VirtualMachine::withLocationsFromStack(const std::function<void(const std::shared_ptr<EngineType> &, const std::shared_ptr<EngineType> &)> &fn) {
-    withStackVariables([this, &fn](auto &left, auto &right) {
+    withStackSlots([this, &fn](auto &left, auto &right) {
         throwIfInvalidType(VariableType::Location, left.type);
         throwIfInvalidType(VariableType::Location, right.type);
-        fn(left.engineType, right.engineType);
+        fn(getEngineType(left), getEngineType(right));
     });
 }
 
 void VirtualMachine::withTalentsFromStack(const std::function<void(const std::shared_ptr<EngineType> &, const std::shared_ptr<EngineType> &)> &fn) {
-    withStackVariables([this, &fn](auto &left, auto &right) {
+    withStackSlots([this, &fn](auto &left, auto &right) {
         throwIfInvalidType(VariableType::Talent, left.type);
         throwIfInvalidType(VariableType::Talent, right.type);
-        fn(left.engineType, right.engineType);
+        fn(getEngineType(left), getEngineType(right));
     });
 }
 
@@ -971,8 +1018,15 @@ void VirtualMachine::withVectorsFromStack(const std::function<void(const glm::ve
     fn(left, right);
 }
 
+int VirtualMachine::getJumpTarget(const CompiledInstruction &ins) const {
+    if (ins.jumpIdx == -1) {
+        throw std::runtime_error(str(boost::format("Invalid jump target: %04x") % (ins.ins->offset + ins.ins->jumpOffset)));
+    }
+    return ins.jumpIdx;
+}
+
 void VirtualMachine::throwIfInvalidType(VariableType expected, VariableType actual) {
-    if (actual != expected) {
+    if (_checked && actual != expected) {
         throw std::runtime_error(str(boost::format("Invalid variable type: expected=%d, actual=%d") %
                                      static_cast<int>(expected) %
                                      static_cast<int>(actual)));
@@ -983,8 +1037,90 @@ int VirtualMachine::getStackSize() const {
     return static_cast<int>(_stack.size());
 }
 
-const Variable &VirtualMachine::getStackVariable(int index) const {
-    return _stack[index];
+Variable VirtualMachine::getStackVariable(int index) const {
+    return toVariable(_stack[index]);
+}
+
+StackSlot VirtualMachine::toSlot(Variable var) {
+    switch (var.type) {
+    case VariableType::String:
+        return StackSlot::ofString(_strings.emplace_back(std::move(var.strValue)));
+    case VariableType::Effect:
+    case VariableType::Event:
+    case VariableType::Location:
+    case VariableType::Talent:
+        if (!var.engineType) {
+            return StackSlot::ofRef(var.type, StackSlot::kNullRef);
+        }
+        _engineTypes.push_back(std::move(var.engineType));
+        return StackSlot::ofRef(var.type, static_cast<uint32_t>(_engineTypes.size() - 1));
+    case VariableType::Action:
+        if (!var.context) {
+            return StackSlot::ofRef(var.type, StackSlot::kNullRef);
+        }
+        _actions.push_back(std::move(var.context));
+        return StackSlot::ofRef(var.type, static_cast<uint32_t>(_actions.size() - 1));
+    case VariableType::Vector:
+        throw std::invalid_argument("Vector variables must be pushed as three floats");
+    default: {
+        StackSlot slot;
+        slot.type = var.type;
+        slot.intValue = var.intValue;
+        return slot;
+    }
+    }
+}
+
+Variable VirtualMachine::toVariable(const StackSlot &slot) const {
+    switch (slot.type) {
+    case VariableType::Int:
+        return Variable::ofInt(slot.intValue);
+    case VariableType::Float:
+        return Variable::ofFloat(slot.floatValue);
+    case VariableType::String:
+        return Variable::ofString(*slot.strValue);
+    case VariableType::Object:
+        return Variable::ofObject(slot.objectId);
+    case VariableType::Effect:
+        return Variable::ofEffect(getEngineType(slot));
+    case VariableType::Event:
+        return Variable::ofEvent(getEngineType(slot));
+    case VariableType::Location:
+        return Variable::ofLocation(getEngineType(slot));
+    case VariableType::Talent:
+        return Variable::ofTalent(getEngineType(slot));
+    case VariableType::Action:
+        return Variable::ofAction(getAction(slot));
+    default:
+        return Variable::ofNull();
+    }
+}
+
+const std::shared_ptr<EngineType> &VirtualMachine::getEngineType(const StackSlot &slot) const {
+    return slot.refIdx == StackSlot::kNullRef ? g_nullEngineType : _engineTypes[slot.refIdx];
+}
+
+const std::shared_ptr<ExecutionContext> &VirtualMachine::getAction(const StackSlot &slot) const {
+    return slot.refIdx == StackSlot::kNullRef ? g_nullAction : _actions[slot.refIdx];
+}
+
+bool VirtualMachine::slotsEqual(const StackSlot &lhs, const StackSlot &rhs) const {
+    if (lhs.type != rhs.type) {
+        return false;
+    }
+    switch (lhs.type) {
+    case VariableType::String:
+        return *lhs.strValue == *rhs.strValue;
+    case VariableType::Effect:
+    case VariableType::Event:
+    case VariableType::Location:
+    case VariableType::Talent:
+        return getEngineType(lhs) == getEngineType(rhs);
+    case VariableType::Action:
+        return getAction(lhs) == getAction(rhs);
+    default:
+        return lhs.intValue == rhs.intValue;
+    }
 }
 
 } // namespace script
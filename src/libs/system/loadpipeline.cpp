@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "reone/system/loadpipeline.h"
+
+namespace reone {
+
+using Clock = std::chrono::steady_clock;
+
+static float millisBetween(Clock::time_point start, Clock::time_point end) {
+    return std::chrono::duration<float, std::milli>(end - start).count();
+}
+
+void LoadPipeline::addStage(std::string name, ResolveFunc resolve) {
+    _stages.push_back(PendingStage {std::move(name), std::move(resolve)});
+}
+
+void LoadPipeline::run(ProgressCallback progress) {
+    auto stages = std::move(_stages);
+    _stages.clear();
+    _timings.clear();
+    for (size_t i = 0; i < stages.size(); ++i) {
+        _timings.push_back(runStage(stages[i], static_cast<int>(i), static_cast<int>(stages.size()), progress));
+    }
+}
+
+LoadPipeline::StageTimings LoadPipeline::runStage(PendingStage &pending, int stageIdx, int numStages, const ProgressCallback &progress) {
+    auto timings = StageTimings();
+    timings.name = pending.name;
+
+    auto stage = Stage(pending.name);
+    auto resolveStart = Clock::now();
+    pending.resolve(stage);
+    timings.resolveMs = millisBetween(resolveStart, Clock::now());
+    timings.numJobs = static_cast<int>(stage._jobs.size());
+
+    if (stage._jobs.empty()) {
+        if (progress) {
+            progress((stageIdx + 1) / static_cast<float>(numStages));
+        }
+        return timings;
+    }
+
+    // Completions are shared with worker tasks, which may still be unwinding
+    // after the last one has been consumed
+    struct Completion {
+        UploadFunc upload;
+        std::exception_ptr exception;
+        Clock::time_point decodedAt;
+    };
+    struct CompletionQueue {
+        std::queue<Completion> completions;
+        std::mutex mutex;
+        std::condition_variable condVar;
+    };
+    auto queue = std::make_shared<CompletionQueue>();
+
+    auto decodeStart = Clock::now();
+    for (auto &job : stage._jobs) {
+        _threadPool.enqueue([queue, job = std::move(job)](const std::atomic_bool &canceled) {
+            auto completion = Completion();
+            if (!canceled) {
+                try {
+                    completion.upload = job();
+                } catch (...) {
+                    completion.exception = std::current_exception();
+                }
+            }
+            completion.decodedAt = Clock::now();
+            std::lock_guard<std::mutex> lock {queue->mutex};
+            queue->completions.push(std::move(completion));
+            queue->condVar.notify_one();
+        });
+    }
+
+    auto decodeEnd = decodeStart;
+    std::exception_ptr firstException;
+    for (int numDone = 0; numDone < timings.numJobs; ++numDone) {
+        Completion completion;
+        {
+            std::unique_lock<std::mutex> lock {queue->mutex};
+            queue->condVar.wait(lock, [&queue]() { return !queue->completions.empty(); });
+            completion = std::move(queue->completions.front());
+            queue->completions.pop();
+        }
+        decodeEnd = std::max(decodeEnd, completion.decodedAt);
+        if (completion.exception) {
+            if (!firstException) {
+                firstException = completion.exception;
+            }
+        } else if (completion.upload && !firstException) {
+            auto uploadStart = Clock::now();
+            try {
+                completion.upload();
+            } catch (...) {
+                firstException = std::current_exception();
+            }
+            timings.uploadMs += millisBetween(uploadStart, Clock::now());
+        }
+        if (progress) {
+            progress((stageIdx + (numDone + 1) / static_cast<float>(timings.numJobs)) / numStages);
+        }
+    }
+    timings.decodeMs = millisBetween(decodeStart, decodeEnd);
+
+    if (firstException) {
+        std::rethrow_exception(firstException);
+    }
+
+    return timings;
+}
+
+} // namespace reone
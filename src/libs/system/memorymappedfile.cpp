@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "reone/system/memorymappedfile.h"
+
+#include "reone/system/exception/filenotfound.h"
+
+using namespace boost::interprocess;
+
+namespace reone {
+
+void MemoryMappedFile::init() {
+    if (!std::filesystem::exists(_path)) {
+        throw FileNotFoundException(_path.string());
+    }
+    _size = static_cast<size_t>(std::filesystem::file_size(_path));
+    if (_size == 0) {
+        // Zero-length regions cannot be mapped
+        return;
+    }
+    _mapping = file_mapping(_path.string().c_str(), read_only);
+    _region = mapped_region(_mapping, read_only);
+    _data = static_cast<const char *>(_region.get_address());
+}
+
+} // namespace reone
@@ -23,10 +23,10 @@ void ThreadPool::init() {
     if (_numThreads == -1) {
         _numThreads = static_cast<int>(std::thread::hardware_concurrency());
     }
+    _running = true;
     for (auto i = 0; i < _numThreads; ++i) {
         _threads.emplace_back(std::bind(&ThreadPool::workerThreadFunc, this));
     }
-    _running = true;
 }
 
 void ThreadPool::deinit() {
@@ -41,6 +41,61 @@ void ThreadPool::deinit() {
         }
     }
     _threads.clear();
+
+    // Drop tasks that will never run, releasing whatever they captured
+    std::queue<std::shared_ptr<Task>> tasks;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::swap(tasks, _tasks);
+    }
+}
+
+void parallelFor(IThreadPool &threadPool, size_t count, size_t grainSize, const std::function<void(size_t begin, size_t end)> &fn) {
+    if (count == 0) {
+        return;
+    }
+    grainSize = std::max<size_t>(1, grainSize);
+    size_t numRanges = (count + grainSize - 1) / grainSize;
+    if (numRanges == 1) {
+        fn(0, count);
+        return;
+    }
+
+    // Shared with workers, which might only start after this function returns
+    struct State {
+        const std::function<void(size_t, size_t)> *fn {nullptr};
+        size_t count {0};
+        size_t grainSize {0};
+        size_t numRanges {0};
+        std::atomic_size_t nextRange {0};
+        std::atomic_size_t numProcessed {0};
+        std::mutex mutex;
+        std::condition_variable condVar;
+    };
+    auto state = std::make_shared<State>();
+    state->fn = &fn;
+    state->count = count;
+    state->grainSize = grainSize;
+    state->numRanges = numRanges;
+
+    auto processRanges = [](State &state) {
+        for (size_t range = state.nextRange++; range < state.numRanges; range = state.nextRange++) {
+            size_t begin = range * state.grainSize;
+            (*state.fn)(begin, std::min(begin + state.grainSize, state.count));
+            if (++state.numProcessed == state.numRanges) {
+                std::lock_guard<std::mutex> lock(state.mutex);
+                state.condVar.notify_all();
+            }
+        }
+    };
+    size_t numWorkers = std::min<size_t>(numRanges - 1, std::max(1u, std::thread::hardware_concurrency()) - 1);
+    for (size_t i = 0; i < numWorkers; ++i) {
+        threadPool.enqueue([state, processRanges](auto &) { processRanges(*state); });
+    }
+    processRanges(*state);
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->condVar.wait(lock, [&state]() { return state->numProcessed == state->numRanges; });
 }
 
 } // namespace reone
@@ -34,7 +34,11 @@ namespace reone {
 class TestEngine : boost::noncopyable {
 public:
     void init() {
-        Logger::instance.init(LogSeverity::Error, {}, std::nullopt);
+        // Logger is global and can only be initialized once per process
+        static std::once_flag loggerInitFlag;
+        std::call_once(loggerInitFlag, []() {
+            Logger::instance.init(LogSeverity::Error, {}, std::nullopt);
+        });
 
         _gameModule = std::make_unique<game::TestGameModule>();
         _movieModule = std::make_unique<movie::TestMovieModule>();
@@ -23,6 +23,7 @@
 #include "reone/system/exception/notimplemented.h"
 
 #include "reone/game/camerastyles.h"
+#include "reone/game/console.h"
 #include "reone/game/d20/classes.h"
 #include "reone/game/d20/feats.h"
 #include "reone/game/d20/skills.h"
@@ -30,10 +31,12 @@
 #include "reone/game/footstepsounds.h"
 #include "reone/game/gui/sounds.h"
 #include "reone/game/options.h"
+#include "reone/game/pathfinder.h"
 #include "reone/game/portraits.h"
 #include "reone/game/reputes.h"
 #include "reone/game/surfaces.h"
 #include "reone/game/types.h"
+#include "reone/graphics/walkmesh.h"
 
 namespace reone {
 
@@ -51,6 +54,12 @@ public:
     MOCK_METHOD(std::shared_ptr<CreatureClass>, get, (ClassType key), (override));
 };
 
+class MockConsole : public IConsole, boost::noncopyable {
+public:
+    MOCK_METHOD(void, registerCommand, (std::string name, std::string description, CommandHandler handler), (override));
+    MOCK_METHOD(void, printLine, (const std::string &text), (override));
+};
+
 class MockFeats : public IFeats, boost::noncopyable {
 public:
     MOCK_METHOD(void, init, (), (override));
@@ -150,6 +159,71 @@ private:
     std::unique_ptr<GameServices> _services;
 };
 
+/**
+ * Builds a graph of size x size points on a jittered grid, with random
+ * horizontal, vertical and diagonal edges removed.
+ */
+inline std::vector<resource::Path::Point> makeRandomGridGraph(int size, std::mt19937 &random) {
+    std::uniform_real_distribution<float> jitter(-0.3f, 0.3f);
+    std::bernoulli_distribution keepEdge(0.8);
+
+    std::vector<resource::Path::Point> points(size * size);
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            auto &point = points[y * size + x];
+            point.x = x + jitter(random);
+            point.y = y + jitter(random);
+        }
+    }
+    auto connect = [&points](int a, int b) {
+        points[a].adjPoints.push_back(b);
+        points[b].adjPoints.push_back(a);
+    };
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            int idx = y * size + x;
+            if (x + 1 < size && keepEdge(random)) {
+                connect(idx, idx + 1);
+            }
+            if (y + 1 < size && keepEdge(random)) {
+                connect(idx, idx + size);
+            }
+            if (x + 1 < size && y + 1 < size && keepEdge(random)) {
+                connect(idx, idx + size + 1);
+            }
+        }
+    }
+    return points;
+}
+
+/**
+ * Builds a flat walkmesh of unit squares, two faces each, one square per
+ * character of rows. '.' marks a walkable square, any other character marks
+ * an obstacle.
+ */
+inline std::unique_ptr<graphics::Walkmesh> makeGridWalkmesh(const std::vector<std::string> &rows, uint32_t walkableMaterial, uint32_t obstacleMaterial) {
+    auto walkmesh = std::make_unique<graphics::Walkmesh>();
+    int index = 0;
+    for (int y = 0; y < static_cast<int>(rows.size()); ++y) {
+        for (int x = 0; x < static_cast<int>(rows[y].size()); ++x) {
+            uint32_t material = rows[y][x] == '.' ? walkableMaterial : obstacleMaterial;
+            glm::vec3 v00(x, y, 0.0f);
+            glm::vec3 v10(x + 1.0f, y, 0.0f);
+            glm::vec3 v01(x, y + 1.0f, 0.0f);
+            glm::vec3 v11(x + 1.0f, y + 1.0f, 0.0f);
+            for (auto &vertices : {std::array<glm::vec3, 3> {v00, v10, v11}, std::array<glm::vec3, 3> {v00, v01, v11}}) {
+                graphics::Walkmesh::Face face;
+                face.index = index++;
+                face.material = material;
+                face.vertices = vertices;
+                face.normal = glm::vec3(0.0f, 0.0f, 1.0f);
+                walkmesh->add(std::move(face));
+            }
+        }
+    }
+    return walkmesh;
+}
+
 } // namespace game
 
 } // namespace reone
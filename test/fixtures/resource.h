@@ -50,6 +50,9 @@ class MockGffs : public IGffs, boost::noncopyable {
 public:
     MOCK_METHOD(void, clear, (), (override));
     MOCK_METHOD(std::shared_ptr<Gff>, get, (const std::string &resRef, ResType type), (override));
+    MOCK_METHOD(std::shared_ptr<Gff>, decode, (const ResourceId &id), (override));
+    MOCK_METHOD(void, add, (ResourceId id, std::shared_ptr<Gff> gff), (override));
+    MOCK_METHOD(bool, contains, (const ResourceId &id), (const, override));
 };
 
 class MockResources : public IResources, boost::noncopyable {
@@ -64,6 +67,8 @@ public:
 
     MOCK_METHOD(Resource, get, (const ResourceId &id), (override));
     MOCK_METHOD(std::optional<Resource>, find, (const ResourceId &id), (override));
+    MOCK_METHOD(std::optional<ResourceView>, findView, (const ResourceId &id), (override));
+    MOCK_METHOD(std::vector<std::future<bool>>, prefetch, (const std::vector<ResourceId> &ids, IThreadPool &threadPool), (override));
 };
 
 class MockStrings : public IStrings, boost::noncopyable {
@@ -81,6 +86,7 @@ public:
 class MockScripts : public IScripts, boost::noncopyable {
 public:
     MOCK_METHOD(void, clear, (), (override));
+    MOCK_METHOD(void, enableVerification, (script::IRoutines & routines), (override));
     MOCK_METHOD(std::shared_ptr<script::ScriptProgram>, get, (const std::string &key), (override));
 };
 
@@ -116,6 +122,9 @@ public:
 class MockModels : public IModels, boost::noncopyable {
 public:
     MOCK_METHOD(std::shared_ptr<graphics::Model>, get, (const std::string &resRef), (override));
+    MOCK_METHOD(std::shared_ptr<graphics::Model>, decode, (const std::string &resRef), (override));
+    MOCK_METHOD(void, add, (const std::string &resRef, std::shared_ptr<graphics::Model> model), (override));
+    MOCK_METHOD(bool, contains, (const std::string &resRef), (const, override));
 };
 
 class MockTextures : public ITextures, boost::noncopyable {
@@ -123,12 +132,18 @@ public:
     MOCK_METHOD(void, clear, (), (override));
 
     MOCK_METHOD(std::shared_ptr<graphics::Texture>, get, (const std::string &resRef, graphics::TextureUsage usage), (override));
+    MOCK_METHOD(std::shared_ptr<graphics::Texture>, decode, (const std::string &resRef, graphics::TextureUsage usage), (override));
+    MOCK_METHOD(void, add, (const std::string &resRef, std::shared_ptr<graphics::Texture> texture), (override));
+    MOCK_METHOD(bool, contains, (const std::string &resRef), (const, override));
 };
 
 class MockWalkmeshes : public IWalkmeshes, boost::noncopyable {
 public:
     MOCK_METHOD(void, clear, (), (override));
     MOCK_METHOD(std::shared_ptr<graphics::Walkmesh>, get, (const std::string &resRef, ResType type), (override));
+    MOCK_METHOD(std::shared_ptr<graphics::Walkmesh>, decode, (const std::string &resRef, ResType type), (override));
+    MOCK_METHOD(void, add, (const std::string &resRef, std::shared_ptr<graphics::Walkmesh> walkmesh), (override));
+    MOCK_METHOD(bool, contains, (const std::string &resRef), (const, override));
 };
 
 class MockDialogs : public IDialogs, boost::noncopyable {
@@ -249,6 +264,10 @@ public:
         return *_models;
     }
 
+    MockTextures &textures() {
+        return *_textures;
+    }
+
     MockWalkmeshes &walkmeshes() {
         return *_walkmeshes;
     }
@@ -19,6 +19,7 @@
 
 #include <gmock/gmock.h>
 
+#include "reone/scene/collision.h"
 #include "reone/scene/di/services.h"
 #include "reone/scene/graph.h"
 #include "reone/scene/graphs.h"
@@ -51,6 +52,10 @@ public:
     MOCK_METHOD(bool, testLineOfSight, (const glm::vec3 &, const glm::vec3 &, Collision &), (const override));
     MOCK_METHOD(bool, testWalk, (const glm::vec3 &, const glm::vec3 &, const IUser *, Collision &), (const override));
 
+    MOCK_METHOD(void, testElevationBatch, (std::vector<CollisionQuery> &, IThreadPool *), (const override));
+    MOCK_METHOD(void, testLineOfSightBatch, (std::vector<CollisionQuery> &, IThreadPool *), (const override));
+    MOCK_METHOD(void, testWalkBatch, (std::vector<CollisionQuery> &, IThreadPool *), (const override));
+
     MOCK_METHOD(ModelSceneNode *, pickModelAt, (int, int, IUser *), (const override));
     MOCK_METHOD(std::optional<std::reference_wrapper<ModelSceneNode>>, pickModelRay, (const glm::vec3 &, const glm::vec3 &), (const override));
 
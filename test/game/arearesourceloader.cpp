@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "reone/game/arearesourceloader.h"
+#include "reone/graphics/animation.h"
+#include "reone/graphics/model.h"
+#include "reone/graphics/modelnode.h"
+#include "reone/graphics/walkmesh.h"
+#include "reone/resource/layout.h"
+#include "reone/system/threadpool.h"
+
+#include "../fixtures/resource.h"
+
+using namespace reone;
+using namespace reone::game;
+using namespace reone::graphics;
+using namespace reone::resource;
+
+using testing::_;
+using testing::Invoke;
+
+/**
+ * Records which stage resource providers were called in, and on which thread.
+ * Called concurrently from decode functions.
+ */
+class LoadLog {
+public:
+    void record(int stage, bool upload) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stages.push_back(stage);
+        if (upload) {
+            _uploadThreads.insert(std::this_thread::get_id());
+        }
+    }
+
+    const std::vector<int> &stages() const { return _stages; }
+    const std::set<std::thread::id> &uploadThreads() const { return _uploadThreads; }
+
+private:
+    std::mutex _mutex;
+    std::vector<int> _stages;
+    std::set<std::thread::id> _uploadThreads;
+};
+
+static std::shared_ptr<Model> makeRoomModel(const std::string &diffuseMap, const std::string &lightmap) {
+    auto rootNode = std::make_shared<ModelNode>(0, "root_node", glm::vec3(0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), true, nullptr);
+    auto mesh = std::make_shared<ModelNode::TriangleMesh>();
+    mesh->diffuseMap = diffuseMap;
+    mesh->lightmap = lightmap;
+    auto meshNode = std::make_shared<ModelNode>(1, "mesh_node", glm::vec3(0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), true, rootNode.get());
+    meshNode->setMesh(mesh);
+    rootNode->addChild(meshNode);
+    return std::make_shared<Model>("room", 0, rootNode, std::vector<std::shared_ptr<Animation>>(), "", 1.0f);
+}
+
+TEST(AreaResourceLoader, should_load_synthetic_module_in_stages_uploading_on_calling_thread) {
+    // given
+    auto resourceModule = TestResourceModule();
+    resourceModule.init();
+    ThreadPool threadPool;
+    threadPool.init();
+    auto log = LoadLog();
+
+    auto git = generated::GIT();
+    git.Creature_List.resize(2);
+    git.Creature_List[0].TemplateResRef = "c_bandit";
+    git.Creature_List[1].TemplateResRef = "c_bandit";
+    git.Placeable_List.resize(1);
+    git.Placeable_List[0].TemplateResRef = "plc_chest";
+    git.Door_List.resize(1);
+    git.WaypointList.resize(1);
+    git.WaypointList[0].TemplateResRef = "wp_start";
+
+    auto are = generated::ARE();
+    are.Grass_TexName = "Grass01";
+
+    auto layout = std::make_shared<Layout>();
+    layout->rooms.push_back(Layout::Room {"M01AA_01A"});
+    layout->rooms.push_back(Layout::Room {"m01aa_01a"});
+    layout->rooms.push_back(Layout::Room {"m01aa_02a"});
+
+    auto &gffs = resourceModule.gffs();
+    EXPECT_CALL(gffs, contains(_)).WillRepeatedly(Invoke([](auto &id) {
+        return id.resRef.value() == "wp_start";
+    }));
+    EXPECT_CALL(gffs, decode(_)).Times(2).WillRepeatedly(Invoke([&log](auto &id) {
+        log.record(0, false);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        return nullptr;
+    }));
+    EXPECT_CALL(gffs, add(_, _)).Times(2).WillRepeatedly(Invoke([&log](auto id, auto gff) {
+        log.record(0, true);
+    }));
+
+    EXPECT_CALL(resourceModule.layouts(), get("m01aa")).WillOnce(Invoke([&log, &layout](auto &key) {
+        log.record(1, true);
+        return layout;
+    }));
+    auto &models = resourceModule.models();
+    EXPECT_CALL(models, contains(_)).WillRepeatedly(Invoke([](auto &resRef) {
+        return resRef == "m01aa_02a";
+    }));
+    EXPECT_CALL(models, decode("m01aa_01a")).WillOnce(Invoke([&log](auto &resRef) {
+        log.record(1, false);
+        return makeRoomModel("LDA_Floor01", "m01aa_01a_lm0");
+    }));
+    EXPECT_CALL(models, add("m01aa_01a", _)).WillOnce(Invoke([&log](auto &resRef, auto model) {
+        log.record(1, true);
+    }));
+    auto &walkmeshes = resourceModule.walkmeshes();
+    EXPECT_CALL(walkmeshes, contains(_)).WillRepeatedly(Invoke([](auto &resRef) {
+        return false;
+    }));
+    EXPECT_CALL(walkmeshes, decode(_, ResType::Wok)).Times(2).WillRepeatedly(Invoke([&log](auto &resRef, auto type) {
+        log.record(1, false);
+        return std::make_shared<Walkmesh>();
+    }));
+    EXPECT_CALL(walkmeshes, add(_, _)).Times(2).WillRepeatedly(Invoke([&log](auto &resRef, auto walkmesh) {
+        log.record(1, true);
+    }));
+
+    // Textures of room models can only be resolved once rooms are uploaded
+    auto &textures = resourceModule.textures();
+    EXPECT_CALL(textures, contains(_)).WillRepeatedly(Invoke([](auto &resRef) {
+        return false;
+    }));
+    EXPECT_CALL(textures, decode("grass01", TextureUsage::MainTex)).WillOnce(Invoke([&log](auto &resRef, auto usage) {
+        log.record(2, false);
+        return nullptr;
+    }));
+    EXPECT_CALL(textures, decode("lda_floor01", TextureUsage::MainTex)).WillOnce(Invoke([&log](auto &resRef, auto usage) {
+        log.record(2, false);
+        return nullptr;
+    }));
+    EXPECT_CALL(textures, decode("m01aa_01a_lm0", TextureUsage::Lightmap)).WillOnce(Invoke([&log](auto &resRef, auto usage) {
+        log.record(2, false);
+        return nullptr;
+    }));
+    EXPECT_CALL(textures, add(_, _)).Times(3).WillRepeatedly(Invoke([&log](auto &resRef, auto texture) {
+        log.record(2, true);
+    }));
+
+    auto loader = AreaResourceLoader(resourceModule.services(), threadPool);
+    std::vector<float> progress;
+
+    // when
+    loader.load("m01aa", are, git, [&progress](float value) {
+        progress.push_back(value);
+    });
+
+    // then
+    EXPECT_TRUE(std::is_sorted(log.stages().begin(), log.stages().end()));
+    EXPECT_EQ(log.uploadThreads(), std::set<std::thread::id> {std::this_thread::get_id()});
+
+    auto &timings = loader.timings();
+    ASSERT_EQ(timings.size(), 3);
+    EXPECT_EQ(timings[0].name, "blueprints");
+    EXPECT_EQ(timings[0].numJobs, 2);
+    EXPECT_GE(timings[0].decodeMs, 2.0f);
+    EXPECT_EQ(timings[1].name, "rooms");
+    EXPECT_EQ(timings[1].numJobs, 3);
+    EXPECT_EQ(timings[2].name, "textures");
+    EXPECT_EQ(timings[2].numJobs, 3);
+    for (auto &stage : timings) {
+        EXPECT_GE(stage.resolveMs, 0.0f);
+        EXPECT_GE(stage.decodeMs, 0.0f);
+        EXPECT_GE(stage.uploadMs, 0.0f);
+    }
+
+    EXPECT_TRUE(std::is_sorted(progress.begin(), progress.end()));
+    ASSERT_FALSE(progress.empty());
+    EXPECT_FLOAT_EQ(progress.back(), 1.0f);
+}
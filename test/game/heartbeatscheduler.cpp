@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "reone/game/heartbeatscheduler.h"
+#include "reone/system/clock.h"
+
+using namespace reone;
+using namespace reone::game;
+
+class FakeClock : public IClock {
+public:
+    void init() override {
+    }
+
+    uint32_t millis() const override {
+        return static_cast<uint32_t>(_micros / 1000);
+    }
+
+    uint64_t micros() const override {
+        return _micros;
+    }
+
+    void advance(uint64_t micros) {
+        _micros += micros;
+    }
+
+private:
+    uint64_t _micros {0};
+};
+
+TEST(HeartbeatScheduler, should_spread_heartbeats_evenly_over_interval) {
+    // given
+    FakeClock clock;
+    HeartbeatScheduler scheduler(clock, 6.0f, 100);
+    for (uint32_t objectId = 1; objectId <= 60; ++objectId) {
+        scheduler.add(objectId);
+    }
+    std::map<uint32_t, int> numRunsById;
+    int maxRunsPerFrame = 0;
+
+    // when
+    for (int frame = 0; frame < 60; ++frame) {
+        scheduler.update(0.1f, [&numRunsById](uint32_t objectId) {
+            ++numRunsById[objectId];
+        });
+        maxRunsPerFrame = std::max(maxRunsPerFrame, scheduler.frameStats().numRun);
+    }
+
+    // then
+    EXPECT_EQ(numRunsById.size(), 60);
+    for (auto &[objectId, numRuns] : numRunsById) {
+        EXPECT_EQ(numRuns, 1) << objectId;
+    }
+    EXPECT_LE(maxRunsPerFrame, 3);
+}
+
+TEST(HeartbeatScheduler, should_defer_heartbeats_exceeding_script_budget) {
+    // given
+    FakeClock clock;
+    HeartbeatScheduler scheduler(clock, 6.0f, 4);
+    for (uint32_t objectId = 1; objectId <= 10; ++objectId) {
+        scheduler.add(objectId);
+    }
+    std::vector<int> numRunsPerFrame;
+    std::set<uint32_t> runIds;
+    auto run = [&runIds](uint32_t objectId) {
+        runIds.insert(objectId);
+    };
+
+    // when
+    scheduler.update(6.0f, run);
+    numRunsPerFrame.push_back(scheduler.frameStats().numRun);
+    EXPECT_EQ(scheduler.frameStats().numPending, 6);
+    scheduler.update(0.0f, run);
+    numRunsPerFrame.push_back(scheduler.frameStats().numRun);
+    scheduler.update(0.0f, run);
+    numRunsPerFrame.push_back(scheduler.frameStats().numRun);
+
+    // then
+    EXPECT_EQ(numRunsPerFrame, (std::vector<int> {4, 4, 2}));
+    EXPECT_EQ(runIds.size(), 10);
+    EXPECT_EQ(scheduler.frameStats().numPending, 0);
+}
+
+TEST(HeartbeatScheduler, should_not_run_removed_objects) {
+    // given
+    FakeClock clock;
+    HeartbeatScheduler scheduler(clock, 6.0f, 1);
+    scheduler.add(1);
+    scheduler.add(2);
+    scheduler.add(3);
+    std::vector<uint32_t> runIds;
+    auto run = [&runIds](uint32_t objectId) {
+        runIds.push_back(objectId);
+    };
+    scheduler.update(6.0f, run);
+
+    // when
+    scheduler.remove(1);
+    scheduler.remove(2);
+    scheduler.remove(3);
+    scheduler.update(0.0f, run);
+
+    // then
+    EXPECT_EQ(runIds.size(), 1);
+    EXPECT_EQ(scheduler.frameStats().numRun, 0);
+    EXPECT_EQ(scheduler.frameStats().numPending, 0);
+}
+
+TEST(HeartbeatScheduler, should_measure_script_time_per_frame) {
+    // given
+    FakeClock clock;
+    HeartbeatScheduler scheduler(clock, 6.0f);
+    scheduler.add(1);
+    scheduler.add(2);
+
+    // when
+    scheduler.update(6.0f, [&clock](uint32_t objectId) {
+        clock.advance(250 * objectId);
+    });
+
+    // then
+    EXPECT_EQ(scheduler.frameStats().numRun, 2);
+    EXPECT_EQ(scheduler.frameStats().scriptTime, 750);
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "reone/game/lineofsightcache.h"
+
+using namespace reone;
+using namespace reone::game;
+
+TEST(LineOfSightCache, should_return_cached_result_until_endpoint_moves) {
+    // given
+    LineOfSightCache cache(0.5f);
+    cache.put(1, glm::vec3(0.0f), 2, glm::vec3(10.0f, 0.0f, 0.0f), true);
+
+    // when
+    bool visible = false;
+    bool hitStill = cache.get(1, glm::vec3(0.0f), 2, glm::vec3(10.0f, 0.0f, 0.0f), visible);
+    bool hitNudged = cache.get(1, glm::vec3(0.25f, 0.0f, 0.0f), 2, glm::vec3(10.0f, 0.25f, 0.0f), visible);
+    bool hitObserverMoved = cache.get(1, glm::vec3(1.0f, 0.0f, 0.0f), 2, glm::vec3(10.0f, 0.0f, 0.0f), visible);
+    bool hitTargetMoved = cache.get(1, glm::vec3(0.0f), 2, glm::vec3(10.0f, 1.0f, 0.0f), visible);
+    bool hitReversed = cache.get(2, glm::vec3(10.0f, 0.0f, 0.0f), 1, glm::vec3(0.0f), visible);
+
+    // then
+    EXPECT_TRUE(hitStill);
+    EXPECT_TRUE(hitNudged);
+    EXPECT_TRUE(visible);
+    EXPECT_FALSE(hitObserverMoved);
+    EXPECT_FALSE(hitTargetMoved);
+    EXPECT_FALSE(hitReversed);
+}
+
+TEST(LineOfSightCache, should_forget_results_on_invalidation_and_removal) {
+    // given
+    LineOfSightCache cache;
+    cache.put(1, glm::vec3(0.0f), 2, glm::vec3(1.0f), false);
+    cache.put(2, glm::vec3(1.0f), 3, glm::vec3(2.0f), true);
+    cache.put(3, glm::vec3(2.0f), 1, glm::vec3(0.0f), true);
+
+    // when
+    cache.remove(1);
+    int sizeAfterRemoval = cache.size();
+    cache.invalidate();
+
+    // then
+    EXPECT_EQ(sizeAfterRemoval, 1);
+    EXPECT_EQ(cache.size(), 0);
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "reone/game/navmesh.h"
+
+#include "../fixtures/game.h"
+
+using namespace reone;
+using namespace reone::game;
+using namespace reone::graphics;
+
+static constexpr uint32_t kWalkable = 1;
+static constexpr uint32_t kObstacle = 2;
+
+static std::unique_ptr<Walkmesh> makeWalkmesh(const std::vector<std::string> &rows) {
+    return makeGridWalkmesh(rows, kWalkable, kObstacle);
+}
+
+TEST(NavMesh, should_build_from_walkable_faces) {
+    // given
+    auto walkmesh = makeWalkmesh({"..#",
+                                  "..."});
+    NavMesh navMesh;
+
+    // when
+    navMesh.add(*walkmesh, {kWalkable});
+    navMesh.build();
+
+    // then
+    EXPECT_EQ(navMesh.numFaces(), 10);
+    EXPECT_EQ(navMesh.numVertices(), 11);
+    EXPECT_NE(navMesh.findFace(glm::vec3(0.5f, 0.5f, 0.0f)), -1);
+    EXPECT_EQ(navMesh.findFace(glm::vec3(2.5f, 0.5f, 0.0f)), -1);
+    EXPECT_EQ(navMesh.findFace(glm::vec3(5.0f, 5.0f, 0.0f)), -1);
+}
+
+TEST(NavMesh, should_find_straight_path_in_open_area) {
+    // given
+    auto walkmesh = makeWalkmesh({"....",
+                                  "...."});
+    NavMesh navMesh;
+    navMesh.add(*walkmesh, {kWalkable});
+    navMesh.build();
+    std::vector<glm::vec3> path;
+
+    // when
+    bool found = navMesh.findPath(glm::vec3(0.5f, 0.5f, 0.0f), glm::vec3(3.5f, 1.5f, 0.0f), path);
+
+    // then
+    EXPECT_TRUE(found);
+    EXPECT_EQ(path, (std::vector<glm::vec3> {glm::vec3(0.5f, 0.5f, 0.0f), glm::vec3(3.5f, 1.5f, 0.0f)}));
+}
+
+TEST(NavMesh, should_pull_path_around_corners) {
+    // given
+    auto walkmesh = makeWalkmesh({"...",
+                                  "##.",
+                                  "..."});
+    NavMesh navMesh;
+    navMesh.add(*walkmesh, {kWalkable});
+    navMesh.build();
+    std::vector<glm::vec3> path;
+
+    // when
+    bool found = navMesh.findPath(glm::vec3(0.5f, 0.5f, 0.0f), glm::vec3(0.5f, 2.5f, 0.0f), path);
+
+    // then
+    EXPECT_TRUE(found);
+    EXPECT_EQ(path, (std::vector<glm::vec3> {glm::vec3(0.5f, 0.5f, 0.0f),
+                                             glm::vec3(2.0f, 1.0f, 0.0f),
+                                             glm::vec3(2.0f, 2.0f, 0.0f),
+                                             glm::vec3(0.5f, 2.5f, 0.0f)}));
+}
+
+TEST(NavMesh, should_not_find_path_between_disconnected_areas) {
+    // given
+    auto walkmesh = makeWalkmesh({"..#.."});
+    NavMesh navMesh;
+    navMesh.add(*walkmesh, {kWalkable});
+    navMesh.build();
+    std::vector<glm::vec3> path;
+
+    // when
+    bool found = navMesh.findPath(glm::vec3(0.5f, 0.5f, 0.0f), glm::vec3(4.5f, 0.5f, 0.0f), path);
+
+    // then
+    EXPECT_FALSE(found);
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "reone/game/objectregistry.h"
+
+using namespace reone;
+using namespace reone::game;
+
+struct TestObject {
+    ObjectType objectType;
+
+    ObjectType type() const { return objectType; }
+};
+
+TEST(ObjectRegistry, should_allocate_sequential_ids_after_reserved_ones) {
+    // given
+    ObjectRegistry<TestObject> registry;
+
+    // when
+    auto id1 = registry.allocate();
+    registry.set(id1, std::make_shared<TestObject>(TestObject {ObjectType::Creature}));
+    auto id2 = registry.allocate();
+    registry.set(id2, std::make_shared<TestObject>(TestObject {ObjectType::Door}));
+
+    // then
+    EXPECT_EQ(id1, 2);
+    EXPECT_EQ(id2, 3);
+    EXPECT_EQ(registry.size(), 2);
+    EXPECT_FALSE(registry.get(0));
+    EXPECT_FALSE(registry.get(1));
+    EXPECT_EQ(registry.get(id2)->type(), ObjectType::Door);
+}
+
+TEST(ObjectRegistry, should_not_resolve_ids_of_removed_objects) {
+    // given
+    ObjectRegistry<TestObject> registry;
+    auto oldId = registry.allocate();
+    registry.set(oldId, std::make_shared<TestObject>(TestObject {ObjectType::Creature}));
+
+    // when
+    registry.remove(oldId);
+    auto newId = registry.allocate();
+    registry.set(newId, std::make_shared<TestObject>(TestObject {ObjectType::Placeable}));
+
+    // then
+    EXPECT_NE(newId, oldId);
+    EXPECT_EQ(ObjectRegistry<TestObject>::getIndex(newId), ObjectRegistry<TestObject>::getIndex(oldId));
+    EXPECT_FALSE(registry.get(oldId));
+    EXPECT_EQ(registry.get(newId)->type(), ObjectType::Placeable);
+    EXPECT_EQ(registry.size(), 1);
+}
+
+TEST(ObjectRegistry, should_get_object_by_id_and_type) {
+    // given
+    ObjectRegistry<TestObject> registry;
+    auto id = registry.allocate();
+    registry.set(id, std::make_shared<TestObject>(TestObject {ObjectType::Creature}));
+
+    // when
+    auto creature = registry.get(id, ObjectType::Creature);
+    auto door = registry.get(id, ObjectType::Door);
+
+    // then
+    EXPECT_TRUE(creature);
+    EXPECT_FALSE(door);
+}
+
+TEST(ObjectRegistry, should_retire_slots_out_of_generations) {
+    // given
+    ObjectRegistry<TestObject> registry;
+    auto id = registry.allocate();
+    auto index = ObjectRegistry<TestObject>::getIndex(id);
+
+    // when
+    for (uint32_t i = 0; i <= ObjectRegistry<TestObject>::kMaxGeneration; ++i) {
+        EXPECT_EQ(ObjectRegistry<TestObject>::getIndex(id), index);
+        registry.remove(id);
+        id = registry.allocate();
+    }
+
+    // then
+    EXPECT_NE(ObjectRegistry<TestObject>::getIndex(id), index);
+}
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "reone/game/action/wait.h"
+#include "reone/game/effect/haste.h"
+#include "reone/game/game.h"
+#include "reone/game/object/placeable.h"
+#include "reone/game/objectupdatelist.h"
+#include "reone/graphics/model.h"
+#include "reone/graphics/modelnode.h"
+#include "reone/scene/node/model.h"
+
+#include "../fixtures/engine.h"
+
+using namespace reone;
+using namespace reone::game;
+using namespace reone::graphics;
+using namespace reone::resource;
+using namespace reone::scene;
+
+class TestObject : public Object {
+public:
+    TestObject(uint32_t id, ObjectType type, Game &game, ServicesView &services) :
+        Object(id, type, "", game, services) {
+    }
+
+    void update(float dt) override {
+        Object::update(dt);
+        ++_numUpdates;
+        if (_onUpdate) {
+            _onUpdate();
+        }
+    }
+
+    bool isSelectable() const override { return _selectable; }
+
+    int numUpdates() const { return _numUpdates; }
+
+    void setSceneNode(std::shared_ptr<SceneNode> sceneNode) { _sceneNode = std::move(sceneNode); }
+    void setSelectable(bool selectable) { _selectable = selectable; }
+    void setOnUpdate(std::function<void()> onUpdate) { _onUpdate = std::move(onUpdate); }
+
+private:
+    bool _selectable {false};
+    int _numUpdates {0};
+    std::function<void()> _onUpdate;
+};
+
+struct TestGame {
+    TestEngine engine;
+    MockConsole console;
+    std::unique_ptr<Game> game;
+
+    TestGame() {
+        engine.init();
+        game = std::make_unique<Game>(GameID::KotOR, "", engine.options(), engine.services(), console);
+    }
+
+    std::unique_ptr<TestObject> newObject(uint32_t id, ObjectType type) {
+        return std::make_unique<TestObject>(id, type, *game, engine.services());
+    }
+};
+
+TEST(ObjectUpdateList, should_remove_idle_placeable_after_update) {
+    // given
+    auto testGame = TestGame();
+    auto placeable = Placeable(2, "", *testGame.game, testGame.engine.services());
+    auto creature = testGame.newObject(3, ObjectType::Creature);
+    auto list = ObjectUpdateList();
+    placeable.setUpdateList(&list);
+    placeable.wake();
+    creature->setUpdateList(&list);
+    creature->wake();
+
+    // when
+    list.update(1.0f);
+
+    // then
+    EXPECT_TRUE(placeable.isIdle());
+    EXPECT_FALSE(list.contains(placeable));
+    EXPECT_TRUE(list.contains(*creature));
+    EXPECT_EQ(list.size(), 1);
+}
+
+TEST(ObjectUpdateList, should_wake_object_on_actions_and_temporary_effects) {
+    // given
+    auto testGame = TestGame();
+    auto &services = testGame.engine.services();
+    auto withAction = testGame.newObject(2, ObjectType::Placeable);
+    auto withDelayedAction = testGame.newObject(3, ObjectType::Placeable);
+    auto withEffect = testGame.newObject(4, ObjectType::Placeable);
+    auto list = ObjectUpdateList();
+    for (auto object : {withAction.get(), withDelayedAction.get(), withEffect.get()}) {
+        object->setUpdateList(&list);
+        object->wake();
+    }
+    list.update(1.0f);
+    ASSERT_EQ(list.size(), 0);
+
+    // when
+    withAction->addAction(std::make_shared<WaitAction>(*testGame.game, services, 1.0f));
+    withDelayedAction->delayAction(std::make_shared<WaitAction>(*testGame.game, services, 1.0f), 1.0f);
+    withEffect->applyEffect(std::make_shared<HasteEffect>(), DurationType::Temporary, 1.0f);
+
+    // then
+    EXPECT_TRUE(list.contains(*withAction));
+    EXPECT_TRUE(list.contains(*withDelayedAction));
+    EXPECT_TRUE(list.contains(*withEffect));
+    EXPECT_EQ(list.size(), 3);
+    list.update(0.5f);
+    EXPECT_EQ(list.size(), 3);
+}
+
+TEST(ObjectUpdateList, should_skip_object_removed_during_update) {
+    // given
+    auto testGame = TestGame();
+    auto remover = testGame.newObject(2, ObjectType::Creature);
+    auto removed = testGame.newObject(3, ObjectType::Creature);
+    auto list = ObjectUpdateList();
+    remover->setUpdateList(&list);
+    remover->wake();
+    removed->setUpdateList(&list);
+    removed->wake();
+    remover->setOnUpdate([&removed]() {
+        removed->setUpdateList(nullptr);
+        removed.reset();
+    });
+
+    // when
+    list.update(1.0f);
+
+    // then
+    EXPECT_FALSE(removed);
+    EXPECT_EQ(remover->numUpdates(), 1);
+    EXPECT_TRUE(list.contains(*remover));
+    EXPECT_EQ(list.size(), 1);
+}
+
+TEST(ObjectUpdateList, should_reapply_pickability_after_selectability_is_invalidated) {
+    // given
+    auto testGame = TestGame();
+    auto &engine = testGame.engine;
+    auto sceneGraph = MockSceneGraph();
+    auto rootNode = std::make_shared<ModelNode>(0, "root_node", glm::vec3(0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), true, nullptr);
+    auto model = Model("some_model", 0, rootNode, std::vector<std::shared_ptr<Animation>>(), "", 1.0f);
+    auto sceneNode = std::make_shared<ModelSceneNode>(
+        model,
+        ModelUsage::Placeable,
+        sceneGraph,
+        engine.graphicsModule().services(),
+        engine.audioModule().services(),
+        engine.resourceModule().services());
+
+    auto object = testGame.newObject(2, ObjectType::Placeable);
+    object->setSceneNode(sceneNode);
+    auto list = ObjectUpdateList();
+    object->setUpdateList(&list);
+    object->wake();
+    list.update(1.0f);
+    object->setSelectable(true);
+    list.update(1.0f);
+    ASSERT_FALSE(sceneNode->isPickable());
+
+    // when
+    object->invalidateSelectable();
+    list.update(1.0f);
+
+    // then
+    EXPECT_TRUE(sceneNode->isPickable());
+    EXPECT_FALSE(list.contains(*object));
+}
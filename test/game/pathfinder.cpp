@@ -19,6 +19,8 @@
 
 #include "reone/game/pathfinder.h"
 
+#include "../fixtures/game.h"
+
 using namespace reone;
 using namespace reone::game;
 using namespace reone::resource;
@@ -75,3 +77,70 @@ TEST(Pathfinder, should_find_shortest_path) {
     EXPECT_EQ(path.at(3), (glm::vec3 {0.0f, 3.0f, 0.0f}));
     EXPECT_EQ(path.at(4), (glm::vec3 {1.0f, 3.0f, 0.0f}));
 }
+
+static float getShortestDistance(const std::vector<Path::Point> &points, int from, int to) {
+    std::vector<float> distances(points.size(), std::numeric_limits<float>::max());
+    std::priority_queue<std::pair<float, int>, std::vector<std::pair<float, int>>, std::greater<std::pair<float, int>>> queue;
+    distances[from] = 0.0f;
+    queue.push(std::make_pair(0.0f, from));
+    while (!queue.empty()) {
+        auto [distance, idx] = queue.top();
+        queue.pop();
+        if (distance > distances[idx]) {
+            continue;
+        }
+        for (auto &adjIdx : points[idx].adjPoints) {
+            float adjDistance = distance + glm::distance(glm::vec2(points[idx].x, points[idx].y), glm::vec2(points[adjIdx].x, points[adjIdx].y));
+            if (adjDistance < distances[adjIdx]) {
+                distances[adjIdx] = adjDistance;
+                queue.push(std::make_pair(adjDistance, adjIdx));
+            }
+        }
+    }
+    return distances[to];
+}
+
+TEST(Pathfinder, should_find_shortest_paths_in_large_random_graph) {
+    // given
+    std::mt19937 random(42);
+    int size = 48;
+    auto points = makeRandomGridGraph(size, random);
+    Pathfinder pathfinder;
+    pathfinder.load(points, std::unordered_map<int, float>());
+    std::uniform_int_distribution<int> pointIdx(0, size * size - 1);
+    std::vector<std::pair<int, int>> queries;
+    while (queries.size() < 20) {
+        int fromIdx = pointIdx(random);
+        int toIdx = pointIdx(random);
+        if (fromIdx != toIdx) {
+            queries.push_back(std::make_pair(fromIdx, toIdx));
+        }
+    }
+
+    // when
+    std::vector<std::vector<glm::vec3>> paths;
+    for (auto &[fromIdx, toIdx] : queries) {
+        glm::vec3 from {points[fromIdx].x + 0.01f, points[fromIdx].y, 0.0f};
+        glm::vec3 to {points[toIdx].x, points[toIdx].y - 0.01f, 0.0f};
+        paths.push_back(pathfinder.findPath(from, to));
+    }
+
+    // then
+    for (size_t i = 0; i < queries.size(); ++i) {
+        auto &[fromIdx, toIdx] = queries[i];
+        auto &path = paths[i];
+        float expectedDistance = getShortestDistance(points, fromIdx, toIdx);
+        if (expectedDistance == std::numeric_limits<float>::max()) {
+            EXPECT_EQ(path.size(), 2);
+            continue;
+        }
+        ASSERT_GE(path.size(), 2);
+        EXPECT_EQ(path.front(), (glm::vec3 {points[fromIdx].x, points[fromIdx].y, 0.0f}));
+        EXPECT_EQ(path.back(), (glm::vec3 {points[toIdx].x, points[toIdx].y, 0.0f}));
+        float distance = 0.0f;
+        for (size_t j = 1; j < path.size(); ++j) {
+            distance += glm::distance(path[j - 1], path[j]);
+        }
+        EXPECT_NEAR(distance, expectedDistance, 1e-3f);
+    }
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "reone/game/pathrequests.h"
+
+#include "../fixtures/game.h"
+
+using namespace reone;
+using namespace reone::game;
+using namespace reone::resource;
+
+class DeferredThreadPool : public IThreadPool, boost::noncopyable {
+public:
+    std::shared_ptr<Task> enqueue(TaskFunc func) override {
+        _funcs.push_back(std::move(func));
+        return nullptr;
+    }
+
+    void runAll() {
+        std::atomic_bool canceled {false};
+        for (auto &func : _funcs) {
+            func(canceled);
+        }
+        _funcs.clear();
+    }
+
+    int numEnqueued() const { return static_cast<int>(_funcs.size()); }
+
+private:
+    std::vector<TaskFunc> _funcs;
+};
+
+static std::shared_ptr<Pathfinder> makeLinePathfinder() {
+    // 0 - 1 - 2 - 3, 4 is disconnected
+    std::vector<Path::Point> points {{0.0f, 0.0f, {1}},
+                                     {1.0f, 0.0f, {0, 2}},
+                                     {2.0f, 0.0f, {1, 3}},
+                                     {3.0f, 0.0f, {2}},
+                                     {10.0f, 10.0f, {}}};
+    auto pathfinder = std::make_shared<Pathfinder>();
+    pathfinder->load(points, std::unordered_map<int, float>());
+    return pathfinder;
+}
+
+TEST(PathRequests, should_solve_batched_requests_in_background) {
+    // given
+    DeferredThreadPool threadPool;
+    PathRequests requests(threadPool);
+    requests.init(makeLinePathfinder());
+    std::vector<PathRequests::Result> results;
+    auto collect = [&results](auto &result) { results.push_back(result); };
+
+    requests.request(1, glm::vec3(0.0f), glm::vec3(3.0f, 0.0f, 0.0f));
+    requests.request(1, glm::vec3(0.0f), glm::vec3(2.0f, 0.0f, 0.0f));
+    requests.request(2, glm::vec3(3.0f, 0.0f, 0.0f), glm::vec3(10.0f, 10.0f, 0.0f));
+
+    // when
+    requests.flush();
+    requests.collect(collect);
+    int numResultsBeforeSolved = static_cast<int>(results.size());
+    threadPool.runAll();
+    requests.collect(collect);
+
+    // then
+    EXPECT_EQ(numResultsBeforeSolved, 0);
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(results[0].requesterId, 1);
+    EXPECT_EQ(results[0].destination, glm::vec3(3.0f, 0.0f, 0.0f));
+    EXPECT_EQ(results[0].points.size(), 4);
+    EXPECT_EQ(results[1].requesterId, 2);
+    EXPECT_EQ(results[1].points, (std::vector<glm::vec3> {glm::vec3(3.0f, 0.0f, 0.0f), glm::vec3(10.0f, 10.0f, 0.0f)}));
+    EXPECT_FALSE(requests.isPending(1));
+    EXPECT_FALSE(requests.isPending(2));
+}
+
+TEST(PathRequests, should_serve_memoized_paths_without_solving) {
+    // given
+    DeferredThreadPool threadPool;
+    PathRequests requests(threadPool);
+    requests.init(makeLinePathfinder());
+    std::vector<PathRequests::Result> results;
+    auto collect = [&results](auto &result) { results.push_back(result); };
+
+    requests.request(1, glm::vec3(0.0f), glm::vec3(3.0f, 0.0f, 0.0f));
+    requests.flush();
+    threadPool.runAll();
+    requests.collect(collect);
+
+    // when
+    requests.request(2, glm::vec3(0.1f, 0.0f, 0.0f), glm::vec3(3.1f, 0.0f, 0.0f));
+    requests.flush();
+    requests.collect(collect);
+
+    // then
+    EXPECT_EQ(threadPool.numEnqueued(), 0);
+    EXPECT_EQ(requests.numCachedPaths(), 1);
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(results[1].requesterId, 2);
+    EXPECT_EQ(results[1].points, results[0].points);
+}
+
+TEST(PathRequests, should_prefer_nav_mesh_paths) {
+    // given
+    auto walkmesh = makeGridWalkmesh({"...."}, 1, 2);
+    auto navMesh = std::make_shared<NavMesh>();
+    navMesh->add(*walkmesh, {1});
+    navMesh->build();
+
+    DeferredThreadPool threadPool;
+    PathRequests requests(threadPool);
+    requests.init(makeLinePathfinder(), navMesh);
+    std::vector<PathRequests::Result> results;
+    auto collect = [&results](auto &result) { results.push_back(result); };
+
+    requests.request(1, glm::vec3(0.5f, 0.5f, 0.0f), glm::vec3(3.5f, 0.5f, 0.0f));
+    requests.request(2, glm::vec3(0.0f), glm::vec3(10.0f, 10.0f, 0.0f));
+
+    // when
+    requests.flush();
+    threadPool.runAll();
+    requests.collect(collect);
+
+    // then
+    EXPECT_EQ(requests.numCachedPaths(), 1);
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(results[0].points, (std::vector<glm::vec3> {glm::vec3(0.5f, 0.5f, 0.0f), glm::vec3(3.5f, 0.5f, 0.0f)}));
+    EXPECT_EQ(results[1].points, (std::vector<glm::vec3> {glm::vec3(0.0f), glm::vec3(10.0f, 10.0f, 0.0f)}));
+}
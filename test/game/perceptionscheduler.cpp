@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "reone/game/perceptionscheduler.h"
+
+using namespace reone;
+using namespace reone::game;
+
+TEST(PerceptionScheduler, should_spread_observers_over_frames_within_ray_budget) {
+    // given
+    PerceptionScheduler scheduler(4);
+    scheduler.schedule({1, 2, 3, 4, 5});
+    std::vector<std::vector<uint32_t>> frames;
+    auto evaluate = [&frames](uint32_t observerId) {
+        frames.back().push_back(observerId);
+        return observerId == 3 ? 10 : 2;
+    };
+
+    // when
+    while (!scheduler.isIdle()) {
+        frames.push_back(std::vector<uint32_t>());
+        scheduler.update(evaluate);
+    }
+
+    // then
+    EXPECT_EQ(frames.size(), 3);
+    EXPECT_EQ(frames[0], (std::vector<uint32_t> {1, 2}));
+    EXPECT_EQ(frames[1], (std::vector<uint32_t> {3}));
+    EXPECT_EQ(frames[2], (std::vector<uint32_t> {4, 5}));
+}
+
+TEST(PerceptionScheduler, should_evaluate_at_least_one_observer_per_frame) {
+    // given
+    PerceptionScheduler scheduler(0);
+    scheduler.schedule({1, 2});
+    std::vector<uint32_t> evaluated;
+
+    // when
+    scheduler.update([&evaluated](uint32_t observerId) {
+        evaluated.push_back(observerId);
+        return 0;
+    });
+
+    // then
+    EXPECT_EQ(evaluated, (std::vector<uint32_t> {1}));
+    EXPECT_FALSE(scheduler.isIdle());
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "reone/game/spatialgrid.h"
+
+using namespace reone;
+using namespace reone::game;
+
+TEST(SpatialGrid, should_find_values_in_radius) {
+    // given
+    SpatialGrid<int> grid(4.0f);
+    grid.add(1, 1, glm::vec3(0.0f, 0.0f, 0.0f));
+    grid.add(2, 2, glm::vec3(3.0f, 0.0f, 10.0f));
+    grid.add(3, 3, glm::vec3(-9.0f, 0.0f, 0.0f));
+    grid.add(4, 4, glm::vec3(20.0f, 20.0f, 0.0f), 30.0f);
+
+    // when
+    std::vector<int> values;
+    grid.forEachInRadius(glm::vec3(1.0f, 1.0f, 0.0f), 5.0f, [&values](auto &value, auto &) {
+        values.push_back(value);
+    });
+    std::sort(values.begin(), values.end());
+
+    // then
+    EXPECT_EQ(values, (std::vector<int> {1, 2, 4}));
+}
+
+TEST(SpatialGrid, should_track_moved_and_removed_values) {
+    // given
+    SpatialGrid<int> grid(4.0f);
+    grid.add(1, 1, glm::vec3(0.0f));
+    grid.add(2, 2, glm::vec3(1.0f, 0.0f, 0.0f));
+    grid.add(3, 3, glm::vec3(2.0f, 0.0f, 0.0f));
+
+    // when
+    grid.move(1, glm::vec3(50.0f, 50.0f, 0.0f));
+    grid.move(2, glm::vec3(1.5f, 0.0f, 0.0f));
+    grid.remove(3);
+
+    // then
+    EXPECT_EQ(grid.size(), 2);
+    EXPECT_FALSE(grid.contains(3));
+    auto nearOrigin = grid.findNearest(glm::vec3(0.0f), 10, [](auto &) { return true; });
+    ASSERT_EQ(nearOrigin.size(), 2);
+    EXPECT_EQ(nearOrigin[0].first, 2);
+    EXPECT_FLOAT_EQ(nearOrigin[0].second, 2.25f);
+    EXPECT_EQ(nearOrigin[1].first, 1);
+}
+
+TEST(SpatialGrid, should_find_nearest_values_same_as_exhaustive_search) {
+    // given
+    SpatialGrid<int> grid(4.0f);
+    std::vector<glm::vec3> positions;
+    for (int i = 0; i < 200; ++i) {
+        auto position = glm::vec3((i * 37 % 101) - 50.0f, (i * 53 % 97) - 48.0f, (i % 7) * 0.5f);
+        positions.push_back(position);
+        grid.add(i, i, position);
+    }
+    auto origin = glm::vec3(7.0f, -3.0f, 1.0f);
+    auto isEven = [](int value) { return value % 2 == 0; };
+
+    // when
+    auto nearest = grid.findNearest(origin, 5, isEven);
+
+    // then
+    std::vector<std::pair<float, int>> expected;
+    for (int i = 0; i < 200; i += 2) {
+        expected.push_back(std::make_pair(glm::distance2(positions[i], origin), i));
+    }
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(nearest.size(), 5);
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(nearest[i].first, expected[i].second);
+    }
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "reone/graphics/keyframetrack.h"
+
+using namespace reone;
+using namespace reone::graphics;
+
+static KeyframeTrack<float> makeLinearTrack(int numKeyframes) {
+    KeyframeTrack<float> track;
+    for (int i = numKeyframes - 1; i >= 0; --i) {
+        track.add(static_cast<float>(i), 10.0f * i);
+    }
+    track.update();
+    return track;
+}
+
+TEST(KeyframeTrack, should_sort_keyframes_by_time) {
+    // given
+    auto track = makeLinearTrack(4);
+
+    // when
+    auto &times = track.times();
+    auto &values = track.values();
+
+    // then
+    EXPECT_EQ((std::vector<float> {0.0f, 1.0f, 2.0f, 3.0f}), times);
+    EXPECT_EQ((std::vector<float> {0.0f, 10.0f, 20.0f, 30.0f}), values);
+}
+
+TEST(KeyframeTrack, should_interpolate_between_keyframes) {
+    // given
+    auto track = makeLinearTrack(4);
+
+    // when
+    float before = -1.0f;
+    float within = -1.0f;
+    float after = -1.0f;
+    bool sampledBefore = track.valueAtTime(-1.0f, before);
+    bool sampledWithin = track.valueAtTime(1.25f, within);
+    bool sampledAfter = track.valueAtTime(3.0f, after);
+
+    // then
+    EXPECT_TRUE(sampledBefore);
+    EXPECT_TRUE(sampledWithin);
+    EXPECT_TRUE(sampledAfter);
+    EXPECT_NEAR(0.0f, before, 1e-5);
+    EXPECT_NEAR(12.5f, within, 1e-5);
+    EXPECT_NEAR(30.0f, after, 1e-5);
+}
+
+TEST(KeyframeTrack, should_sample_same_values_with_cursor_forwards_backwards_and_on_seeks) {
+    // given
+    auto track = makeLinearTrack(32);
+    std::vector<float> times;
+    for (float time = 0.0f; time < 31.0f; time += 0.3f) {
+        times.push_back(time);
+    }
+    for (float time = 31.0f; time > 0.0f; time -= 0.7f) {
+        times.push_back(time);
+    }
+    times.insert(times.end(), {2.5f, 29.5f, 0.5f, 17.25f, 17.25f, 3.0f});
+
+    // when
+    KeyframeCursor cursor;
+    std::vector<std::pair<float, float>> samples;
+    for (auto time : times) {
+        float expected = -1.0f;
+        float actual = -1.0f;
+        track.valueAtTime(time, expected);
+        track.valueAtTime(time, actual, cursor);
+        samples.push_back(std::make_pair(expected, actual));
+    }
+
+    // then
+    for (auto &[expected, actual] : samples) {
+        EXPECT_EQ(expected, actual);
+    }
+}
+
+TEST(KeyframeTrack, should_not_sample_empty_track) {
+    // given
+    KeyframeTrack<glm::vec3> track;
+
+    // when
+    KeyframeCursor cursor;
+    glm::vec3 value(1.0f);
+    bool sampled = track.valueAtTime(1.0f, value, cursor);
+
+    // then
+    EXPECT_FALSE(sampled);
+    EXPECT_EQ(glm::vec3(1.0f), value);
+}
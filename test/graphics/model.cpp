@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "reone/graphics/animation.h"
+#include "reone/graphics/model.h"
+#include "reone/graphics/modelnode.h"
+
+using namespace reone;
+using namespace reone::graphics;
+
+static std::shared_ptr<Animation> makeAnimation(const std::string &name) {
+    auto rootNode = std::make_shared<ModelNode>(0, "root_node", glm::vec3(0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), true);
+    return std::make_shared<Animation>(name, 1.0f, 0.0f, "", rootNode, std::vector<Animation::Event>());
+}
+
+static std::shared_ptr<Model> makeModel(std::vector<std::shared_ptr<Animation>> animations) {
+    auto rootNode = std::make_shared<ModelNode>(0, "root_node", glm::vec3(0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), true);
+    return std::make_shared<Model>("some_model", 0, rootNode, std::move(animations), "", 1.0f);
+}
+
+TEST(Model, should_cache_binding_of_own_animation) {
+    // given
+    auto anim = makeAnimation("some_anim");
+    auto model = makeModel({anim});
+
+    // when
+    auto binding1 = model->getAnimationBinding(*anim);
+    auto binding2 = model->getAnimationBinding(*anim);
+
+    // then
+    ASSERT_EQ(binding1->size(), 1ll);
+    EXPECT_EQ((*binding1)[0], anim->getNodeByName("root_node").get());
+    EXPECT_EQ(binding1, binding2);
+}
+
+TEST(Model, should_not_cache_binding_of_animation_owned_by_another_model) {
+    // given
+    auto ownAnim = makeAnimation("some_anim");
+    auto model = makeModel({ownAnim});
+    auto otherAnim = makeAnimation("some_anim");
+
+    // when
+    auto binding1 = model->getAnimationBinding(*otherAnim);
+    auto binding2 = model->getAnimationBinding(*otherAnim);
+
+    // then
+    ASSERT_EQ(binding1->size(), 1ll);
+    EXPECT_EQ((*binding1)[0], otherAnim->getNodeByName("root_node").get());
+    EXPECT_NE(binding1, binding2);
+}
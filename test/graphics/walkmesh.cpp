@@ -25,10 +25,10 @@ using namespace reone::graphics;
 TEST(Walkmesh, should_find_ray_walkmesh_intersection__intersection_from_close) {
     // given
     auto walkmesh = Walkmesh();
-    walkmesh.add(Walkmesh::Face {0, 0, std::vector<glm::vec3> {glm::vec3(-1.0f, 0.0f, 0.0f), glm::vec3(-1.0f, 1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f)}, glm::vec3(1.0f, 0.0f, 0.0f)});
-    walkmesh.add(Walkmesh::Face {1, 0, std::vector<glm::vec3> {glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(-1.0f, 1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f)}, glm::vec3(1.0f, 0.0f, 0.0f)});
-    walkmesh.add(Walkmesh::Face {2, 0, std::vector<glm::vec3> {glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(1.0f, -1.0f, 0.0f)}, glm::vec3(1.0f, 0.0f, 0.0f)});
-    walkmesh.add(Walkmesh::Face {3, 0, std::vector<glm::vec3> {glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(1.0f, -1.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f)}, glm::vec3(1.0f, 0.0f, 0.0f)});
+    walkmesh.add(Walkmesh::Face {0, 0, {glm::vec3(-1.0f, 0.0f, 0.0f), glm::vec3(-1.0f, 1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f)}, glm::vec3(1.0f, 0.0f, 0.0f)});
+    walkmesh.add(Walkmesh::Face {1, 0, {glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(-1.0f, 1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f)}, glm::vec3(1.0f, 0.0f, 0.0f)});
+    walkmesh.add(Walkmesh::Face {2, 0, {glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(1.0f, -1.0f, 0.0f)}, glm::vec3(1.0f, 0.0f, 0.0f)});
+    walkmesh.add(Walkmesh::Face {3, 0, {glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(1.0f, -1.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f)}, glm::vec3(1.0f, 0.0f, 0.0f)});
     auto rootAabb = std::make_shared<Walkmesh::AABB>();
     rootAabb->value = AABB(glm::vec3(-1.0f, -1.0f, 0.0f), glm::vec3(1.0f, 1.0f, 0.0f));
     rootAabb->left = std::make_shared<Walkmesh::AABB>();
@@ -47,7 +47,7 @@ TEST(Walkmesh, should_find_ray_walkmesh_intersection__intersection_from_close) {
 
     // when
     float distance = -1.0f;
-    auto face = walkmesh.raycast(std::set<uint32_t> {0}, glm::vec3(-0.5f, 0.25, 1.0f), glm::vec3(0.0f, 0.0f, -1.0f), 10.0f, distance);
+    auto face = walkmesh.raycast(Walkmesh::getSurfaceMask({0}), glm::vec3(-0.5f, 0.25, 1.0f), glm::vec3(0.0f, 0.0f, -1.0f), 10.0f, distance);
 
     // then
     EXPECT_TRUE(static_cast<bool>(face));
@@ -58,10 +58,10 @@ TEST(Walkmesh, should_find_ray_walkmesh_intersection__intersection_from_close) {
 TEST(Walkmesh, should_find_ray_walkmesh_intersection__intersection_from_far) {
     // given
     auto walkmesh = Walkmesh();
-    walkmesh.add(Walkmesh::Face {0, 0, std::vector<glm::vec3> {glm::vec3(-1.0f, 0.0f, 0.0f), glm::vec3(-1.0f, 1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f)}, glm::vec3(1.0f, 0.0f, 0.0f)});
-    walkmesh.add(Walkmesh::Face {1, 0, std::vector<glm::vec3> {glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(-1.0f, 1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f)}, glm::vec3(1.0f, 0.0f, 0.0f)});
-    walkmesh.add(Walkmesh::Face {2, 0, std::vector<glm::vec3> {glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(1.0f, -1.0f, 0.0f)}, glm::vec3(1.0f, 0.0f, 0.0f)});
-    walkmesh.add(Walkmesh::Face {3, 0, std::vector<glm::vec3> {glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(1.0f, -1.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f)}, glm::vec3(1.0f, 0.0f, 0.0f)});
+    walkmesh.add(Walkmesh::Face {0, 0, {glm::vec3(-1.0f, 0.0f, 0.0f), glm::vec3(-1.0f, 1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f)}, glm::vec3(1.0f, 0.0f, 0.0f)});
+    walkmesh.add(Walkmesh::Face {1, 0, {glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(-1.0f, 1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f)}, glm::vec3(1.0f, 0.0f, 0.0f)});
+    walkmesh.add(Walkmesh::Face {2, 0, {glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(1.0f, -1.0f, 0.0f)}, glm::vec3(1.0f, 0.0f, 0.0f)});
+    walkmesh.add(Walkmesh::Face {3, 0, {glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(1.0f, -1.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f)}, glm::vec3(1.0f, 0.0f, 0.0f)});
     auto rootAabb = std::make_shared<Walkmesh::AABB>();
     rootAabb->value = AABB(glm::vec3(-1.0f, -1.0f, 0.0f), glm::vec3(1.0f, 1.0f, 0.0f));
     rootAabb->left = std::make_shared<Walkmesh::AABB>();
@@ -80,7 +80,7 @@ TEST(Walkmesh, should_find_ray_walkmesh_intersection__intersection_from_far) {
 
     // when
     float distance = -1.0f;
-    auto face = walkmesh.raycast(std::set<uint32_t> {0}, glm::vec3(-0.5f, 0.25, 20.0f), glm::vec3(0.0f, 0.0f, -1.0f), 10.0f, distance);
+    auto face = walkmesh.raycast(Walkmesh::getSurfaceMask({0}), glm::vec3(-0.5f, 0.25, 20.0f), glm::vec3(0.0f, 0.0f, -1.0f), 10.0f, distance);
 
     // then
     EXPECT_TRUE(!static_cast<bool>(face));
@@ -89,10 +89,10 @@ TEST(Walkmesh, should_find_ray_walkmesh_intersection__intersection_from_far) {
 TEST(Walkmesh, should_find_ray_walkmesh_intersection__no_intersection) {
     // given
     auto walkmesh = Walkmesh();
-    walkmesh.add(Walkmesh::Face {0, 0, std::vector<glm::vec3> {glm::vec3(-1.0f, 0.0f, 0.0f), glm::vec3(-1.0f, 1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f)}, glm::vec3(1.0f, 0.0f, 0.0f)});
-    walkmesh.add(Walkmesh::Face {1, 0, std::vector<glm::vec3> {glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(-1.0f, 1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f)}, glm::vec3(1.0f, 0.0f, 0.0f)});
-    walkmesh.add(Walkmesh::Face {2, 0, std::vector<glm::vec3> {glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(1.0f, -1.0f, 0.0f)}, glm::vec3(1.0f, 0.0f, 0.0f)});
-    walkmesh.add(Walkmesh::Face {3, 0, std::vector<glm::vec3> {glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(1.0f, -1.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f)}, glm::vec3(1.0f, 0.0f, 0.0f)});
+    walkmesh.add(Walkmesh::Face {0, 0, {glm::vec3(-1.0f, 0.0f, 0.0f), glm::vec3(-1.0f, 1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f)}, glm::vec3(1.0f, 0.0f, 0.0f)});
+    walkmesh.add(Walkmesh::Face {1, 0, {glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(-1.0f, 1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f)}, glm::vec3(1.0f, 0.0f, 0.0f)});
+    walkmesh.add(Walkmesh::Face {2, 0, {glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(1.0f, -1.0f, 0.0f)}, glm::vec3(1.0f, 0.0f, 0.0f)});
+    walkmesh.add(Walkmesh::Face {3, 0, {glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(1.0f, -1.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f)}, glm::vec3(1.0f, 0.0f, 0.0f)});
     auto rootAabb = std::make_shared<Walkmesh::AABB>();
     rootAabb->value = AABB(glm::vec3(-1.0f, -1.0f, 0.0f), glm::vec3(1.0f, 1.0f, 0.0f));
     rootAabb->left = std::make_shared<Walkmesh::AABB>();
@@ -111,8 +111,93 @@ TEST(Walkmesh, should_find_ray_walkmesh_intersection__no_intersection) {
 
     // when
     float distance = -1.0f;
-    auto face = walkmesh.raycast(std::set<uint32_t> {0}, glm::vec3(-0.5f, 0.25, 1.0f), glm::vec3(1.0f, 0.0f, 0.0f), 10.0f, distance);
+    auto face = walkmesh.raycast(Walkmesh::getSurfaceMask({0}), glm::vec3(-0.5f, 0.25, 1.0f), glm::vec3(1.0f, 0.0f, 0.0f), 10.0f, distance);
 
     // then
     EXPECT_TRUE(!static_cast<bool>(face));
 }
+
+TEST(Walkmesh, should_find_nearest_intersection_with_walkmesh_without_aabb_tree) {
+    // given
+    auto walkmesh = Walkmesh();
+    walkmesh.add(Walkmesh::Face {0, 1, {glm::vec3(-1.0f, -1.0f, 0.0f), glm::vec3(1.0f, -1.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f)}, glm::vec3(0.0f, 0.0f, 1.0f)});
+    walkmesh.add(Walkmesh::Face {1, 2, {glm::vec3(-1.0f, -1.0f, 1.0f), glm::vec3(1.0f, -1.0f, 1.0f), glm::vec3(0.0f, 1.0f, 1.0f)}, glm::vec3(0.0f, 0.0f, 1.0f)});
+    walkmesh.add(Walkmesh::Face {2, 1, {glm::vec3(-1.0f, -1.0f, 2.0f), glm::vec3(1.0f, -1.0f, 2.0f), glm::vec3(0.0f, 1.0f, 2.0f)}, glm::vec3(0.0f, 0.0f, 1.0f)});
+
+    // when
+    float distance = -1.0f;
+    auto face = walkmesh.raycast(Walkmesh::getSurfaceMask({1}), glm::vec3(0.0f, 0.0f, 3.0f), glm::vec3(0.0f, 0.0f, -1.0f), 10.0f, distance);
+    float distanceAll = -1.0f;
+    auto faceAll = walkmesh.raycast(Walkmesh::getSurfaceMask({1, 2}), glm::vec3(0.0f, 0.0f, 0.5f), glm::vec3(0.0f, 0.0f, 1.0f), 10.0f, distanceAll);
+
+    // then
+    ASSERT_TRUE(static_cast<bool>(face));
+    EXPECT_EQ(2, face->index);
+    EXPECT_NEAR(1.0f, distance, 1e-5);
+    ASSERT_TRUE(static_cast<bool>(faceAll));
+    EXPECT_EQ(1, faceAll->index);
+    EXPECT_NEAR(0.5f, distanceAll, 1e-5);
+}
+
+TEST(Walkmesh, should_find_same_intersections_with_and_without_aabb_tree) {
+    // given
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> height(0.0f, 1.0f);
+    std::uniform_int_distribution<uint32_t> material(0, 3);
+    int size = 16;
+    auto bruteForce = Walkmesh();
+    auto withTree = Walkmesh();
+    std::vector<std::shared_ptr<Walkmesh::AABB>> leaves;
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            auto v00 = glm::vec3(x, y, height(random));
+            auto v10 = glm::vec3(x + 1.0f, y, height(random));
+            auto v11 = glm::vec3(x + 1.0f, y + 1.0f, height(random));
+            auto face = Walkmesh::Face {static_cast<int>(leaves.size()), material(random), {v00, v10, v11}, glm::vec3(0.0f, 0.0f, 1.0f)};
+            auto leaf = std::make_shared<Walkmesh::AABB>();
+            leaf->faceIdx = face.index;
+            leaves.push_back(leaf);
+            bruteForce.add(Walkmesh::Face(face));
+            withTree.add(std::move(face));
+        }
+    }
+    while (leaves.size() > 1) {
+        std::vector<std::shared_ptr<Walkmesh::AABB>> parents;
+        for (size_t i = 0; i + 1 < leaves.size(); i += 2) {
+            auto parent = std::make_shared<Walkmesh::AABB>();
+            parent->left = leaves[i];
+            parent->right = leaves[i + 1];
+            parents.push_back(parent);
+        }
+        if (leaves.size() % 2 == 1) {
+            parents.push_back(leaves.back());
+        }
+        leaves = std::move(parents);
+    }
+    withTree.setRootAABB(leaves.front());
+    auto surfaces = Walkmesh::getSurfaceMask({0, 1, 2});
+
+    // when
+    int numMismatches = 0;
+    int numHits = 0;
+    std::uniform_real_distribution<float> coord(0.0f, static_cast<float>(size));
+    for (int i = 0; i < 1000; ++i) {
+        glm::vec3 origin(coord(random), coord(random), 2.0f);
+        glm::vec3 dir(glm::normalize(glm::vec3(coord(random), coord(random), 0.0f) - origin));
+        float expectedDistance = 0.0f;
+        float distance = 0.0f;
+        auto expectedFace = bruteForce.raycast(surfaces, origin, dir, 100.0f, expectedDistance);
+        auto face = withTree.raycast(surfaces, origin, dir, 100.0f, distance);
+        if (static_cast<bool>(expectedFace) != static_cast<bool>(face) ||
+            (face && (face->index != expectedFace->index || glm::abs(distance - expectedDistance) > 1e-5f))) {
+            ++numMismatches;
+        }
+        if (face) {
+            ++numHits;
+        }
+    }
+
+    // then
+    EXPECT_EQ(0, numMismatches);
+    EXPECT_GT(numHits, 0);
+}
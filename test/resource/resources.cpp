@@ -17,6 +17,9 @@
 
 #include <gtest/gtest.h>
 
+#include "reone/resource/container/memory.h"
+#include "reone/resource/format/erfwriter.h"
+#include "reone/resource/format/rimwriter.h"
 #include "reone/resource/resources.h"
 #include "reone/system/logutil.h"
 #include "reone/system/stream/fileoutput.h"
@@ -110,3 +113,208 @@ TEST(Resources, should_index_providers_and_get_resources_without_caching) {
 
     std::filesystem::remove_all(tmpDirPath);
 }
+
+TEST(Resources, should_find_resource_views_in_memory_mapped_erf) {
+    // given
+
+    auto tmpDirPath = std::filesystem::temp_directory_path();
+    tmpDirPath.append("reone_test_resources_mapped");
+    std::filesystem::create_directory(tmpDirPath);
+
+    auto erfPath = tmpDirPath;
+    erfPath.append("sample.erf");
+    auto erfWriter = ErfWriter();
+    erfWriter.add(ErfWriter::Resource {"sample", ResType::Txt, ByteBuffer {'H', 'e', 'l', 'l', 'o'}});
+    erfWriter.save(ErfWriter::FileType::ERF, erfPath);
+
+    auto resources = Resources();
+    resources.setMemoryMapped(true);
+
+    auto expectedResData = ByteBuffer {'H', 'e', 'l', 'l', 'o'};
+
+    // when
+
+    resources.addERF(erfPath, true);
+
+    auto actualView = resources.findView(ResourceId("sample", ResType::Txt));
+    auto actualRes = resources.find(ResourceId("sample", ResType::Txt));
+    resources.clear();
+
+    // then
+
+    EXPECT_TRUE(static_cast<bool>(actualView));
+    EXPECT_TRUE(actualView->local);
+    auto actualViewData = ByteBuffer(actualView->data, actualView->data + actualView->size);
+    EXPECT_EQ(expectedResData, actualViewData) << notEqualMessage(expectedResData, actualViewData);
+    EXPECT_TRUE(static_cast<bool>(actualRes));
+    EXPECT_EQ(expectedResData, actualRes->data) << notEqualMessage(expectedResData, actualRes->data);
+
+    // cleanup
+
+    actualView.reset();
+    std::filesystem::remove_all(tmpDirPath);
+}
+
+TEST(Resources, should_find_resources_concurrently) {
+    // given
+
+    auto tmpDirPath = std::filesystem::temp_directory_path();
+    tmpDirPath.append("reone_test_resources_concurrent");
+    std::filesystem::create_directory(tmpDirPath);
+
+    static constexpr int kNumResources = 64;
+    static constexpr int kNumThreads = 8;
+    static constexpr int kNumLookupsPerThread = 2000;
+
+    auto erfPath = tmpDirPath;
+    erfPath.append("sample.erf");
+    auto rimPath = tmpDirPath;
+    rimPath.append("sample.rim");
+    auto erfWriter = ErfWriter();
+    auto rimWriter = RimWriter();
+    for (int i = 0; i < kNumResources; ++i) {
+        auto resRef = str(boost::format("erf%02d") % i);
+        erfWriter.add(ErfWriter::Resource {resRef, ResType::Txt, ByteBuffer(i + 1, static_cast<char>(i))});
+        resRef = str(boost::format("rim%02d") % i);
+        rimWriter.add(RimWriter::Resource {resRef, ResType::Txt, ByteBuffer(i + 1, static_cast<char>(i))});
+    }
+    erfWriter.save(ErfWriter::FileType::ERF, erfPath);
+    rimWriter.save(rimPath);
+
+    auto resources = Resources();
+    resources.addERF(erfPath);
+    resources.setMemoryMapped(true);
+    resources.addRIM(rimPath);
+
+    // when
+
+    std::atomic_int numMismatches {0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kNumThreads; ++t) {
+        threads.emplace_back([&resources, &numMismatches, t]() {
+            for (int i = 0; i < kNumLookupsPerThread; ++i) {
+                int resIdx = (i * 7 + t) % kNumResources;
+                auto prefix = (i % 2 == 0) ? "erf" : "rim";
+                auto resRef = str(boost::format("%s%02d") % prefix % resIdx);
+                auto res = resources.find(ResourceId(resRef, ResType::Txt));
+                if (!res || res->data != ByteBuffer(resIdx + 1, static_cast<char>(resIdx))) {
+                    ++numMismatches;
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    resources.clear();
+
+    // then
+
+    EXPECT_EQ(0, numMismatches);
+
+    // cleanup
+
+    std::filesystem::remove_all(tmpDirPath);
+}
+
+TEST(Resources, should_prioritize_last_added_container_and_fall_back_after_clearing_local) {
+    // given
+
+    auto global = std::make_unique<MemoryResourceContainer>();
+    global->add(ResourceId("sample", ResType::Txt), ByteBuffer {'G'});
+    auto local = std::make_unique<MemoryResourceContainer>();
+    local->add(ResourceId("sample", ResType::Txt), ByteBuffer {'L'});
+    local->add(ResourceId("localonly", ResType::Txt), ByteBuffer {'O'});
+
+    auto resources = Resources();
+    resources.add(std::move(global));
+    resources.add(std::move(local), true);
+
+    // when
+
+    auto actualRes1 = resources.find(ResourceId("sample", ResType::Txt));
+    resources.clearLocal();
+    auto actualRes2 = resources.find(ResourceId("sample", ResType::Txt));
+    auto actualRes3 = resources.find(ResourceId("localonly", ResType::Txt));
+
+    // then
+
+    EXPECT_TRUE(static_cast<bool>(actualRes1));
+    EXPECT_EQ(ByteBuffer {'L'}, actualRes1->data);
+    EXPECT_TRUE(actualRes1->local);
+    EXPECT_TRUE(static_cast<bool>(actualRes2));
+    EXPECT_EQ(ByteBuffer {'G'}, actualRes2->data);
+    EXPECT_FALSE(actualRes2->local);
+    EXPECT_TRUE(!static_cast<bool>(actualRes3));
+}
+
+TEST(Resources, should_prefetch_resources_into_bounded_cache) {
+    // given
+
+    auto container = std::make_unique<MemoryResourceContainer>();
+    container->add(ResourceId("first", ResType::Txt), ByteBuffer(8, 'A'));
+    container->add(ResourceId("second", ResType::Txt), ByteBuffer(8, 'B'));
+    container->add(ResourceId("third", ResType::Txt), ByteBuffer(8, 'C'));
+
+    auto resources = Resources();
+    resources.add(std::move(container));
+    resources.setPrefetchCapacity(16);
+
+    auto threadPool = ThreadPool(2);
+    threadPool.init();
+
+    // when
+
+    auto futures = resources.prefetch(
+        std::vector<ResourceId> {
+            ResourceId("first", ResType::Txt),
+            ResourceId("second", ResType::Txt),
+            ResourceId("missing", ResType::Txt)},
+        threadPool);
+    auto found1 = futures[0].get();
+    auto found2 = futures[1].get();
+    auto found3 = futures[2].get();
+    futures = resources.prefetch(std::vector<ResourceId> {ResourceId("third", ResType::Txt)}, threadPool);
+    auto found4 = futures[0].get();
+    auto firstPrefetched = resources.isPrefetched(ResourceId("first", ResType::Txt));
+    auto secondPrefetched = resources.isPrefetched(ResourceId("second", ResType::Txt));
+    auto actualView = resources.findView(ResourceId("third", ResType::Txt));
+    auto thirdPrefetched = resources.isPrefetched(ResourceId("third", ResType::Txt));
+
+    // then
+
+    EXPECT_TRUE(found1);
+    EXPECT_TRUE(found2);
+    EXPECT_FALSE(found3);
+    EXPECT_TRUE(found4);
+    EXPECT_FALSE(firstPrefetched);
+    EXPECT_TRUE(secondPrefetched);
+    EXPECT_FALSE(thirdPrefetched);
+    EXPECT_TRUE(static_cast<bool>(actualView));
+    EXPECT_EQ(8ll, actualView->size);
+    EXPECT_EQ('C', actualView->data[0]);
+}
+
+TEST(Resources, should_not_wait_for_prefetches_dropped_by_thread_pool) {
+    // given
+
+    auto threadPool = ThreadPool(0);
+    threadPool.init();
+
+    auto container = std::make_unique<MemoryResourceContainer>();
+    container->add(ResourceId("first", ResType::Txt), ByteBuffer(8, 'A'));
+
+    auto resources = std::make_unique<Resources>();
+    resources->add(std::move(container));
+
+    auto futures = resources->prefetch(std::vector<ResourceId> {ResourceId("first", ResType::Txt)}, threadPool);
+
+    // when
+
+    threadPool.deinit();
+    resources.reset();
+
+    // then
+
+    EXPECT_THROW(futures[0].get(), std::future_error);
+}
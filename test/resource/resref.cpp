@@ -50,3 +50,17 @@ TEST(ResRef, should_be_comparable) {
     EXPECT_GT(resRef3, resRef1);
     EXPECT_GT(resRef3, resRef2);
 }
+
+TEST(ResRef, should_hash_equal_values_equally) {
+    // given
+    ResRef resRef1("MixedCase");
+    ResRef resRef2(std::string("mixedcase"));
+    ResRef resRef3("mixedcase2");
+
+    // expect
+    EXPECT_EQ(resRef1.hash(), resRef2.hash());
+    EXPECT_NE(resRef1.hash(), resRef3.hash());
+    EXPECT_EQ("mixedcase", resRef1.view());
+    EXPECT_EQ(9ll, resRef1.length());
+    EXPECT_TRUE(ResRef().empty());
+}
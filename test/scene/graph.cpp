@@ -0,0 +1,502 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "reone/graphics/format/bwmreader.h"
+#include "reone/graphics/options.h"
+#include "reone/graphics/walkmesh.h"
+#include "reone/scene/collision.h"
+#include "reone/scene/graphs.h"
+#include "reone/scene/node/walkmesh.h"
+#include "reone/system/binarywriter.h"
+#include "reone/system/stream/memoryinput.h"
+#include "reone/system/stream/memoryoutput.h"
+#include "reone/system/threadpool.h"
+
+#include "../fixtures/audio.h"
+#include "../fixtures/graphics.h"
+#include "../fixtures/resource.h"
+#include "../fixtures/scene.h"
+
+using namespace reone;
+using namespace reone::audio;
+using namespace reone::graphics;
+using namespace reone::resource;
+using namespace reone::scene;
+
+static constexpr uint32_t kFloorMaterial = 1;
+static constexpr uint32_t kWallMaterial = 2;
+
+static constexpr float kElevationTestZ = 1024.0f;
+static constexpr float kMaxCollisionDistanceWalk = 8.0f;
+static constexpr float kMaxCollisionDistanceLineOfSight = 16.0f;
+
+static const std::set<uint32_t> kWalkableSurfaces {kFloorMaterial};
+static const std::set<uint32_t> kWalkcheckSurfaces {kFloorMaterial, kWallMaterial};
+static const std::set<uint32_t> kLineOfSightSurfaces {kWallMaterial};
+
+class TestUser : public IUser {
+};
+
+static void appendQuad(std::vector<Walkmesh::Face> &faces, const glm::vec3 &v00, const glm::vec3 &v10, const glm::vec3 &v11, const glm::vec3 &v01, uint32_t material) {
+    auto normal = glm::normalize(glm::cross(v10 - v00, v01 - v00));
+    for (auto &vertices : {std::array<glm::vec3, 3> {v00, v10, v11}, std::array<glm::vec3, 3> {v00, v11, v01}}) {
+        Walkmesh::Face face;
+        face.index = static_cast<int>(faces.size());
+        face.material = material;
+        face.vertices = vertices;
+        face.normal = normal;
+        faces.push_back(std::move(face));
+    }
+}
+
+static void appendFloor(std::vector<Walkmesh::Face> &faces, const glm::vec2 &min, const glm::vec2 &max, float z, float quadSize) {
+    for (float y = min.y; y < max.y; y += quadSize) {
+        for (float x = min.x; x < max.x; x += quadSize) {
+            appendQuad(
+                faces,
+                glm::vec3(x, y, z),
+                glm::vec3(x + quadSize, y, z),
+                glm::vec3(x + quadSize, y + quadSize, z),
+                glm::vec3(x, y + quadSize, z),
+                kFloorMaterial);
+        }
+    }
+}
+
+static void appendWall(std::vector<Walkmesh::Face> &faces, const glm::vec2 &start, const glm::vec2 &end, float minZ, float maxZ) {
+    appendQuad(
+        faces,
+        glm::vec3(start, minZ),
+        glm::vec3(end, minZ),
+        glm::vec3(end, maxZ),
+        glm::vec3(start, maxZ),
+        kWallMaterial);
+}
+
+/**
+ * Area walkmeshes can only be loaded from WOK, so faces are serialized
+ * together with an AABB tree, built by splitting faces in halves.
+ */
+static std::shared_ptr<Walkmesh> makeAreaWalkmesh(const std::vector<Walkmesh::Face> &faces) {
+    struct AABBNode {
+        glm::vec3 min {std::numeric_limits<float>::max()};
+        glm::vec3 max {std::numeric_limits<float>::lowest()};
+        int faceIdx {-1};
+        uint32_t left {0};
+        uint32_t right {0};
+    };
+    std::vector<AABBNode> aabbs;
+    std::function<uint32_t(size_t, size_t)> buildAABB = [&](size_t begin, size_t end) {
+        auto aabbIdx = static_cast<uint32_t>(aabbs.size());
+        aabbs.push_back(AABBNode());
+        for (size_t i = begin; i < end; ++i) {
+            for (auto &vertex : faces[i].vertices) {
+                aabbs[aabbIdx].min = glm::min(aabbs[aabbIdx].min, vertex);
+                aabbs[aabbIdx].max = glm::max(aabbs[aabbIdx].max, vertex);
+            }
+        }
+        if (end - begin == 1) {
+            aabbs[aabbIdx].faceIdx = static_cast<int>(begin);
+            return aabbIdx;
+        }
+        size_t mid = (begin + end) / 2;
+        uint32_t left = buildAABB(begin, mid);
+        uint32_t right = buildAABB(mid, end);
+        aabbs[aabbIdx].left = left;
+        aabbs[aabbIdx].right = right;
+        return aabbIdx;
+    };
+    buildAABB(0, faces.size());
+
+    auto numFaces = static_cast<uint32_t>(faces.size());
+    uint32_t offVertices = 136;
+    uint32_t offIndices = offVertices + 9 * sizeof(float) * numFaces;
+    uint32_t offMaterials = offIndices + 3 * sizeof(uint32_t) * numFaces;
+    uint32_t offNormals = offMaterials + sizeof(uint32_t) * numFaces;
+    uint32_t offAabb = offNormals + 3 * sizeof(float) * numFaces;
+
+    ByteBuffer bytes;
+    auto stream = MemoryOutputStream(bytes);
+    auto writer = BinaryWriter(stream);
+    writer.writeString("BWM V1.0");
+    writer.writeUint32(1); // type (WOK)
+    for (int i = 0; i < 15; ++i) {
+        writer.writeFloat(0.0f); // use positions and position
+    }
+    writer.writeUint32(3 * numFaces);
+    writer.writeUint32(offVertices);
+    writer.writeUint32(numFaces);
+    writer.writeUint32(offIndices);
+    writer.writeUint32(offMaterials);
+    writer.writeUint32(offNormals);
+    writer.writeUint32(0); // offset to planar distances
+    writer.writeUint32(static_cast<uint32_t>(aabbs.size()));
+    writer.writeUint32(offAabb);
+    for (int i = 0; i < 7; ++i) {
+        writer.writeUint32(0); // unknown, adjacencies, edges and perimeters
+    }
+    for (auto &face : faces) {
+        for (auto &vertex : face.vertices) {
+            writer.writeFloat(vertex.x);
+            writer.writeFloat(vertex.y);
+            writer.writeFloat(vertex.z);
+        }
+    }
+    for (uint32_t i = 0; i < 3 * numFaces; ++i) {
+        writer.writeUint32(i);
+    }
+    for (auto &face : faces) {
+        writer.writeUint32(face.material);
+    }
+    for (auto &face : faces) {
+        writer.writeFloat(face.normal.x);
+        writer.writeFloat(face.normal.y);
+        writer.writeFloat(face.normal.z);
+    }
+    for (auto &aabb : aabbs) {
+        for (auto &bound : {aabb.min, aabb.max}) {
+            writer.writeFloat(bound.x);
+            writer.writeFloat(bound.y);
+            writer.writeFloat(bound.z);
+        }
+        writer.writeInt32(aabb.faceIdx);
+        writer.writeUint32(0); // unknown
+        writer.writeUint32(0); // most significant plane
+        writer.writeUint32(aabb.left);
+        writer.writeUint32(aabb.right);
+    }
+
+    auto wok = MemoryInputStream(bytes);
+    auto reader = BwmReader(wok);
+    reader.load();
+    return reader.walkmesh();
+}
+
+static std::shared_ptr<Walkmesh> makePlaceableWalkmesh(std::vector<Walkmesh::Face> faces) {
+    auto walkmesh = std::make_shared<Walkmesh>();
+    for (auto &face : faces) {
+        walkmesh->add(std::move(face));
+    }
+    return walkmesh;
+}
+
+/**
+ * Scene graph with walkmesh roots exercising every branch of the broad phase:
+ *
+ * - large area walkmesh, spanning multiple cells of the grid, with a wall
+ * - small area walkmesh next to it, with an elevated floor and a wall
+ * - disabled area walkmesh above the large one
+ * - placeable walkmesh, which is tested regardless of the grid
+ */
+struct TestScene {
+    GraphicsOptions graphicsOpt;
+    MockRenderPipelineFactory pipelineFactory;
+    TestGraphicsModule graphicsModule;
+    TestAudioModule audioModule;
+    TestResourceModule resourceModule;
+    std::unique_ptr<SceneGraph> sceneGraph;
+
+    std::vector<std::shared_ptr<Walkmesh>> walkmeshes;
+    std::vector<std::shared_ptr<WalkmeshSceneNode>> roots;
+    TestUser placeableUser;
+
+    TestScene() {
+        graphicsModule.init();
+        audioModule.init();
+        resourceModule.init();
+        sceneGraph = std::make_unique<SceneGraph>("test", pipelineFactory, graphicsOpt, graphicsModule.services(), audioModule.services(), resourceModule.services(), nullptr);
+        sceneGraph->setWalkableSurfaces(kWalkableSurfaces);
+        sceneGraph->setWalkcheckSurfaces(kWalkcheckSurfaces);
+        sceneGraph->setLineOfSightSurfaces(kLineOfSightSurfaces);
+
+        std::vector<Walkmesh::Face> largeRoom;
+        appendFloor(largeRoom, glm::vec2(0.0f), glm::vec2(60.0f, 20.0f), 0.0f, 5.0f);
+        appendWall(largeRoom, glm::vec2(30.0f, 0.0f), glm::vec2(30.0f, 10.0f), 0.0f, 3.0f);
+        addRoot(makeAreaWalkmesh(largeRoom));
+
+        std::vector<Walkmesh::Face> smallRoom;
+        appendFloor(smallRoom, glm::vec2(60.0f, 0.0f), glm::vec2(80.0f, 20.0f), 1.0f, 5.0f);
+        appendWall(smallRoom, glm::vec2(70.0f, 0.0f), glm::vec2(70.0f, 20.0f), 0.0f, 4.0f);
+        addRoot(makeAreaWalkmesh(smallRoom));
+
+        std::vector<Walkmesh::Face> disabledRoom;
+        appendFloor(disabledRoom, glm::vec2(10.0f, 5.0f), glm::vec2(20.0f, 15.0f), 2.0f, 5.0f);
+        appendWall(disabledRoom, glm::vec2(15.0f, 5.0f), glm::vec2(15.0f, 15.0f), 0.0f, 3.0f);
+        addRoot(makeAreaWalkmesh(disabledRoom))->setEnabled(false);
+
+        std::vector<Walkmesh::Face> placeable;
+        appendWall(placeable, glm::vec2(0.0f, -1.0f), glm::vec2(0.0f, 1.0f), 0.0f, 2.0f);
+        auto placeableRoot = addRoot(makePlaceableWalkmesh(std::move(placeable)), glm::translate(glm::vec3(40.0f, 15.0f, 0.0f)));
+        placeableRoot->setUser(placeableUser);
+    }
+
+    std::shared_ptr<WalkmeshSceneNode> addRoot(std::shared_ptr<Walkmesh> walkmesh, glm::mat4 transform = glm::mat4(1.0f)) {
+        auto root = std::make_shared<WalkmeshSceneNode>(
+            *walkmesh,
+            *sceneGraph,
+            graphicsModule.services(),
+            audioModule.services(),
+            resourceModule.services());
+        root->setLocalTransform(std::move(transform));
+        sceneGraph->addRoot(root);
+        walkmeshes.push_back(std::move(walkmesh));
+        roots.push_back(root);
+        return root;
+    }
+
+    // Brute force collision tests over all roots
+
+    bool testElevation(const glm::vec2 &position, Collision &outCollision) const {
+        glm::vec3 origin(position, kElevationTestZ);
+        glm::vec3 down(0.0f, 0.0f, -1.0f);
+        float minDistance = std::numeric_limits<float>::max();
+        bool walkable = false;
+        for (auto &root : roots) {
+            if (!root->isEnabled()) {
+                continue;
+            }
+            if (!root->walkmesh().isAreaWalkmesh() && root->getSquareDistanceTo2D(position) > kMaxCollisionDistanceWalk * kMaxCollisionDistanceWalk) {
+                continue;
+            }
+            float distance = 0.0f;
+            auto face = root->walkmesh().raycast(
+                Walkmesh::getSurfaceMask(kWalkcheckSurfaces),
+                glm::vec3(root->absoluteTransformInverse() * glm::vec4(origin, 1.0f)),
+                down,
+                2.0f * kElevationTestZ,
+                distance);
+            if (!face || distance >= minDistance) {
+                continue;
+            }
+            walkable = kWalkableSurfaces.count(face->material) > 0;
+            if (walkable) {
+                outCollision.user = root->user();
+                outCollision.intersection = origin + distance * down;
+                outCollision.material = face->material;
+            }
+            minDistance = distance;
+        }
+        return walkable;
+    }
+
+    bool testLineOfSight(const glm::vec3 &origin, const glm::vec3 &dest, Collision &outCollision) const {
+        auto dir = glm::normalize(dest - origin);
+        float minDistance = std::numeric_limits<float>::max();
+        for (auto &root : roots) {
+            if (!root->isEnabled()) {
+                continue;
+            }
+            auto &walkmesh = root->walkmesh();
+            if (walkmesh.isAreaWalkmesh()) {
+                if (!walkmesh.contains(origin) && !walkmesh.contains(dest)) {
+                    continue;
+                }
+            } else if (root->getSquareDistanceTo(origin) > kMaxCollisionDistanceLineOfSight * kMaxCollisionDistanceLineOfSight) {
+                continue;
+            }
+            float distance = 0.0f;
+            auto face = walkmesh.raycast(
+                Walkmesh::getSurfaceMask(kLineOfSightSurfaces),
+                glm::vec3(root->absoluteTransformInverse() * glm::vec4(origin, 1.0f)),
+                glm::vec3(root->absoluteTransformInverse() * glm::vec4(dir, 0.0f)),
+                glm::length(dest - origin),
+                distance);
+            if (!face || distance > minDistance) {
+                continue;
+            }
+            outCollision.user = root->user();
+            outCollision.intersection = origin + distance * dir;
+            outCollision.material = face->material;
+            minDistance = distance;
+        }
+        return minDistance != std::numeric_limits<float>::max();
+    }
+
+    bool testWalk(const glm::vec3 &origin, const glm::vec3 &dest, const IUser *excludeUser, Collision &outCollision) const {
+        auto dir = glm::normalize(dest - origin);
+        float minDistance = std::numeric_limits<float>::max();
+        for (auto &root : roots) {
+            if (!root->isEnabled() || root->user() == excludeUser) {
+                continue;
+            }
+            if (!root->walkmesh().isAreaWalkmesh() && root->getSquareDistanceTo(origin) > kMaxCollisionDistanceWalk * kMaxCollisionDistanceWalk) {
+                continue;
+            }
+            float distance = 0.0f;
+            auto face = root->walkmesh().raycast(
+                Walkmesh::getSurfaceMask(kWalkcheckSurfaces),
+                glm::vec3(root->absoluteTransformInverse() * glm::vec4(origin, 1.0f)),
+                glm::vec3(root->absoluteTransformInverse() * glm::vec4(dir, 0.0f)),
+                kMaxCollisionDistanceWalk,
+                distance);
+            if (!face || distance > glm::length(dest - origin) || distance > minDistance) {
+                continue;
+            }
+            outCollision.user = root->user();
+            outCollision.intersection = origin + distance * dir;
+            outCollision.material = face->material;
+            minDistance = distance;
+        }
+        return minDistance != std::numeric_limits<float>::max();
+    }
+
+    // END Brute force collision tests over all roots
+};
+
+static std::vector<CollisionQuery> makeQueries(size_t count, float minZ, float maxZ, float minLength, float maxLength) {
+    auto random = std::mt19937(1);
+    auto x = std::uniform_real_distribution<float>(-5.0f, 85.0f);
+    auto y = std::uniform_real_distribution<float>(-5.0f, 25.0f);
+    auto z = std::uniform_real_distribution<float>(minZ, maxZ);
+    auto angle = std::uniform_real_distribution<float>(0.0f, glm::two_pi<float>());
+    auto length = std::uniform_real_distribution<float>(minLength, maxLength);
+    std::vector<CollisionQuery> queries;
+    for (size_t i = 0; i < count; ++i) {
+        CollisionQuery query;
+        query.origin = glm::vec3(x(random), y(random), z(random));
+        // Every other query starts next to the placeable
+        if (i % 2 == 1) {
+            query.origin = glm::vec3(40.0f + 0.1f * (query.origin.x - 40.0f), 15.0f + 0.2f * (query.origin.y - 10.0f), query.origin.z);
+        }
+        float a = angle(random);
+        query.dest = query.origin + length(random) * glm::vec3(glm::cos(a), glm::sin(a), 0.0f);
+        queries.push_back(std::move(query));
+    }
+    return queries;
+}
+
+static void expectSameCollision(bool expectedResult, const Collision &expected, bool actualResult, const Collision &actual) {
+    ASSERT_EQ(expectedResult, actualResult);
+    if (!expectedResult) {
+        return;
+    }
+    EXPECT_EQ(expected.user, actual.user);
+    EXPECT_EQ(expected.material, actual.material);
+    EXPECT_NEAR(expected.intersection.x, actual.intersection.x, 1e-3f);
+    EXPECT_NEAR(expected.intersection.y, actual.intersection.y, 1e-3f);
+    EXPECT_NEAR(expected.intersection.z, actual.intersection.z, 1e-3f);
+}
+
+static void expectBatchElevationMatchesSingleAndBruteForce(IThreadPool *threadPool) {
+    // given
+    auto scene = TestScene();
+    auto queries = makeQueries(400, 0.0f, 0.0f, 0.0f, 0.0f);
+
+    // when
+    scene.sceneGraph->testElevationBatch(queries, threadPool);
+
+    // then
+    int numElevated = 0;
+    for (auto &query : queries) {
+        Collision single;
+        bool singleResult = scene.sceneGraph->testElevation(glm::vec2(query.origin), single);
+        Collision bruteForce;
+        bool bruteForceResult = scene.testElevation(glm::vec2(query.origin), bruteForce);
+        expectSameCollision(singleResult, single, query.result, query.collision);
+        expectSameCollision(bruteForceResult, bruteForce, query.result, query.collision);
+        if (query.result) {
+            EXPECT_GT(glm::abs(query.collision.intersection.z - 2.0f), 1e-3f);
+            if (glm::abs(query.collision.intersection.z - 1.0f) < 1e-3f) {
+                ++numElevated;
+            }
+        }
+    }
+    EXPECT_GT(numElevated, 0);
+}
+
+static void expectBatchLineOfSightMatchesSingleAndBruteForce(IThreadPool *threadPool) {
+    // given
+    auto scene = TestScene();
+    auto queries = makeQueries(400, 0.5f, 2.5f, 1.0f, 60.0f);
+
+    // when
+    scene.sceneGraph->testLineOfSightBatch(queries, threadPool);
+
+    // then
+    int numBlockedByPlaceable = 0;
+    for (auto &query : queries) {
+        Collision single;
+        bool singleResult = scene.sceneGraph->testLineOfSight(query.origin, query.dest, single);
+        Collision bruteForce;
+        bool bruteForceResult = scene.testLineOfSight(query.origin, query.dest, bruteForce);
+        expectSameCollision(singleResult, single, query.result, query.collision);
+        expectSameCollision(bruteForceResult, bruteForce, query.result, query.collision);
+        if (query.result && query.collision.user == &scene.placeableUser) {
+            ++numBlockedByPlaceable;
+        }
+    }
+    EXPECT_GT(numBlockedByPlaceable, 0);
+}
+
+static void expectBatchWalkMatchesSingleAndBruteForce(IThreadPool *threadPool) {
+    // given
+    auto scene = TestScene();
+    auto queries = makeQueries(400, 0.5f, 0.5f, 0.5f, 10.0f);
+    for (size_t i = 0; i < queries.size(); i += 4) {
+        queries[i].excludeUser = &scene.placeableUser;
+    }
+
+    // when
+    scene.sceneGraph->testWalkBatch(queries, threadPool);
+
+    // then
+    int numBlockedByPlaceable = 0;
+    for (auto &query : queries) {
+        Collision single;
+        bool singleResult = scene.sceneGraph->testWalk(query.origin, query.dest, query.excludeUser, single);
+        Collision bruteForce;
+        bool bruteForceResult = scene.testWalk(query.origin, query.dest, query.excludeUser, bruteForce);
+        expectSameCollision(singleResult, single, query.result, query.collision);
+        expectSameCollision(bruteForceResult, bruteForce, query.result, query.collision);
+        if (query.result && query.collision.user == &scene.placeableUser) {
+            ++numBlockedByPlaceable;
+        }
+    }
+    EXPECT_GT(numBlockedByPlaceable, 0);
+}
+
+TEST(SceneGraph, should_test_elevation_in_batch_as_single_queries_over_all_roots) {
+    expectBatchElevationMatchesSingleAndBruteForce(nullptr);
+}
+
+TEST(SceneGraph, should_test_elevation_in_parallel_batch_as_single_queries_over_all_roots) {
+    ThreadPool threadPool;
+    threadPool.init();
+    expectBatchElevationMatchesSingleAndBruteForce(&threadPool);
+}
+
+TEST(SceneGraph, should_test_line_of_sight_in_batch_as_single_queries_over_all_roots) {
+    expectBatchLineOfSightMatchesSingleAndBruteForce(nullptr);
+}
+
+TEST(SceneGraph, should_test_line_of_sight_in_parallel_batch_as_single_queries_over_all_roots) {
+    ThreadPool threadPool;
+    threadPool.init();
+    expectBatchLineOfSightMatchesSingleAndBruteForce(&threadPool);
+}
+
+TEST(SceneGraph, should_test_walk_in_batch_as_single_queries_over_all_roots) {
+    expectBatchWalkMatchesSingleAndBruteForce(nullptr);
+}
+
+TEST(SceneGraph, should_test_walk_in_parallel_batch_as_single_queries_over_all_roots) {
+    ThreadPool threadPool;
+    threadPool.init();
+    expectBatchWalkMatchesSingleAndBruteForce(&threadPool);
+}
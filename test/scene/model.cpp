@@ -53,7 +53,7 @@ TEST(ModelSceneNode, should_build_from_model) {
     auto resourceModule = TestResourceModule();
     resourceModule.init();
 
-    auto scene = std::make_unique<SceneGraph>("test", pipelineFactory, graphicsOpt, graphicsModule.services(), audioModule.services(), resourceModule.services());
+    auto scene = std::make_unique<SceneGraph>("test", pipelineFactory, graphicsOpt, graphicsModule.services(), audioModule.services(), resourceModule.services(), nullptr);
 
     auto rootNode = std::make_shared<ModelNode>(0, "root_node", glm::vec3(0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), true, nullptr);
 
@@ -120,7 +120,7 @@ TEST(ModelSceneNode, should_play_single_fire_forget_animation) {
     auto resourceModule = TestResourceModule();
     resourceModule.init();
 
-    auto scene = std::make_unique<SceneGraph>("test", pipelineFactory, graphicsOpt, graphicsModule.services(), audioModule.services(), resourceModule.services());
+    auto scene = std::make_unique<SceneGraph>("test", pipelineFactory, graphicsOpt, graphicsModule.services(), audioModule.services(), resourceModule.services(), nullptr);
 
     auto rootNode = std::make_shared<ModelNode>(0, "root_node", glm::vec3(0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), true, nullptr);
 
@@ -159,6 +159,60 @@ TEST(ModelSceneNode, should_play_single_fire_forget_animation) {
     EXPECT_NEAR(3.0f, rootPosition.z, 1e-5);
 }
 
+TEST(ModelSceneNode, should_not_advance_animations_evaluated_ahead_of_update) {
+    // given
+    auto graphicsOpt = GraphicsOptions();
+    auto pipelineFactory = MockRenderPipelineFactory();
+
+    auto graphicsModule = TestGraphicsModule();
+    graphicsModule.init();
+
+    auto audioModule = TestAudioModule();
+    audioModule.init();
+
+    auto resourceModule = TestResourceModule();
+    resourceModule.init();
+
+    auto scene = std::make_unique<SceneGraph>("test", pipelineFactory, graphicsOpt, graphicsModule.services(), audioModule.services(), resourceModule.services(), nullptr);
+
+    auto rootNode = std::make_shared<ModelNode>(0, "root_node", glm::vec3(0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), true, nullptr);
+
+    auto animRootNode = std::make_shared<ModelNode>(0, "root_node", glm::vec3(0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), false, nullptr);
+    animRootNode->vectorTracks()[ControllerTypes::position].add(0.0f, glm::vec3(0.0f));
+    animRootNode->vectorTracks()[ControllerTypes::position].add(1.0f, glm::vec3(1.0f, 2.0f, 3.0f));
+
+    auto animations = std::vector<std::shared_ptr<Animation>> {
+        std::make_shared<Animation>("some_animation", 1.0f, 0.5f, "root_node", animRootNode, std::vector<Animation::Event>())};
+
+    auto model = Model("some_model", 0, rootNode, animations, "", 1.0f);
+
+    auto modelSceneNode = std::make_shared<ModelSceneNode>(
+        model,
+        ModelUsage::Creature,
+        *scene,
+        graphicsModule.services(),
+        audioModule.services(),
+        resourceModule.services());
+
+    // when
+    modelSceneNode->init();
+    modelSceneNode->playAnimation("some_animation", nullptr, AnimationProperties::fromFlags(AnimationFlags::loop));
+    modelSceneNode->evaluateAnimations(0.25f);
+    modelSceneNode->update(0.25f);
+    modelSceneNode->update(0.25f);
+
+    // then
+    auto &channels = modelSceneNode->animationChannels();
+    EXPECT_EQ(1ll, channels.size());
+    EXPECT_NEAR(0.5f, channels[0].time, 1e-5);
+    auto rootSceneNode = modelSceneNode->getNodeByName("root_node");
+    EXPECT_TRUE(static_cast<bool>(rootSceneNode));
+    auto &rootPosition = rootSceneNode->localTransform()[3];
+    EXPECT_NEAR(0.5f, rootPosition.x, 1e-5);
+    EXPECT_NEAR(1.0f, rootPosition.y, 1e-5);
+    EXPECT_NEAR(1.5f, rootPosition.z, 1e-5);
+}
+
 TEST(ModelSceneNode, should_play_single_looping_animation) {
     // given
     auto graphicsOpt = GraphicsOptions();
@@ -173,7 +227,7 @@ TEST(ModelSceneNode, should_play_single_looping_animation) {
     auto resourceModule = TestResourceModule();
     resourceModule.init();
 
-    auto scene = std::make_unique<SceneGraph>("test", pipelineFactory, graphicsOpt, graphicsModule.services(), audioModule.services(), resourceModule.services());
+    auto scene = std::make_unique<SceneGraph>("test", pipelineFactory, graphicsOpt, graphicsModule.services(), audioModule.services(), resourceModule.services(), nullptr);
 
     auto rootNode = std::make_shared<ModelNode>(0, "root_node", glm::vec3(0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), true, nullptr);
 
@@ -225,7 +279,7 @@ TEST(ModelSceneNode, should_play_two_overlayed_animations) {
     auto resourceModule = TestResourceModule();
     resourceModule.init();
 
-    auto scene = std::make_unique<SceneGraph>("test", pipelineFactory, graphicsOpt, graphicsModule.services(), audioModule.services(), resourceModule.services());
+    auto scene = std::make_unique<SceneGraph>("test", pipelineFactory, graphicsOpt, graphicsModule.services(), audioModule.services(), resourceModule.services(), nullptr);
 
     auto rootNode = std::make_shared<ModelNode>(0, "root_node", glm::vec3(0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), true, nullptr);
     auto dummyNode = std::make_shared<ModelNode>(1, "dummy_node", glm::vec3(0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), true, rootNode.get());
@@ -295,7 +349,7 @@ TEST(ModelSceneNode, hould_transition_between_two_animations) {
     auto resourceModule = TestResourceModule();
     resourceModule.init();
 
-    auto scene = std::make_unique<SceneGraph>("test", pipelineFactory, graphicsOpt, graphicsModule.services(), audioModule.services(), resourceModule.services());
+    auto scene = std::make_unique<SceneGraph>("test", pipelineFactory, graphicsOpt, graphicsModule.services(), audioModule.services(), resourceModule.services(), nullptr);
 
     auto rootNode = std::make_shared<ModelNode>(0, "root_node", glm::vec3(0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), true, nullptr);
 
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "reone/graphics/modelnode.h"
+#include "reone/scene/node/dummy.h"
+
+#include "../fixtures/audio.h"
+#include "../fixtures/graphics.h"
+#include "../fixtures/resource.h"
+#include "../fixtures/scene.h"
+
+using namespace reone;
+using namespace reone::audio;
+using namespace reone::graphics;
+using namespace reone::resource;
+using namespace reone::scene;
+
+TEST(SceneNode, should_propagate_local_transform_to_descendants) {
+    // given
+    auto graphicsModule = TestGraphicsModule();
+    graphicsModule.init();
+    auto audioModule = TestAudioModule();
+    audioModule.init();
+    auto resourceModule = TestResourceModule();
+    resourceModule.init();
+    auto sceneGraph = MockSceneGraph();
+
+    auto modelNode = ModelNode(0, "node", glm::vec3(0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), false, nullptr);
+    auto parent = DummySceneNode(modelNode, sceneGraph, graphicsModule.services(), audioModule.services(), resourceModule.services());
+    auto child = DummySceneNode(modelNode, sceneGraph, graphicsModule.services(), audioModule.services(), resourceModule.services());
+    auto grandChild = DummySceneNode(modelNode, sceneGraph, graphicsModule.services(), audioModule.services(), resourceModule.services());
+    parent.addChild(child);
+    child.addChild(grandChild);
+    child.setLocalTransform(glm::translate(glm::vec3(0.0f, 1.0f, 0.0f)));
+    grandChild.setLocalTransform(glm::scale(glm::vec3(2.0f)));
+
+    // when
+    parent.setLocalTransform(glm::translate(glm::vec3(1.0f, 0.0f, 0.0f)));
+
+    // then
+    auto expectedTransform = glm::translate(glm::vec3(1.0f, 1.0f, 0.0f)) * glm::scale(glm::vec3(2.0f));
+    auto &absTransform = grandChild.absoluteTransform();
+    auto &absTransformInv = grandChild.absoluteTransformInverse();
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            EXPECT_NEAR(expectedTransform[i][j], absTransform[i][j], 1e-5);
+        }
+    }
+    auto identity = absTransform * absTransformInv;
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            EXPECT_NEAR(i == j ? 1.0f : 0.0f, identity[i][j], 1e-5);
+        }
+    }
+}
+
+TEST(SceneNode, should_reset_absolute_transform_of_removed_child) {
+    // given
+    auto graphicsModule = TestGraphicsModule();
+    graphicsModule.init();
+    auto audioModule = TestAudioModule();
+    audioModule.init();
+    auto resourceModule = TestResourceModule();
+    resourceModule.init();
+    auto sceneGraph = MockSceneGraph();
+
+    auto modelNode = ModelNode(0, "node", glm::vec3(0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), false, nullptr);
+    auto parent = DummySceneNode(modelNode, sceneGraph, graphicsModule.services(), audioModule.services(), resourceModule.services());
+    auto child = DummySceneNode(modelNode, sceneGraph, graphicsModule.services(), audioModule.services(), resourceModule.services());
+    parent.setLocalTransform(glm::translate(glm::vec3(1.0f, 2.0f, 3.0f)));
+    parent.addChild(child);
+    EXPECT_NEAR(1.0f, child.origin().x, 1e-5);
+
+    // when
+    parent.removeChild(child);
+
+    // then
+    auto origin = child.origin();
+    EXPECT_NEAR(0.0f, origin.x, 1e-5);
+    EXPECT_NEAR(0.0f, origin.y, 1e-5);
+    EXPECT_NEAR(0.0f, origin.z, 1e-5);
+}
+
+TEST(SceneNode, should_detach_child_from_previous_parent) {
+    // given
+    auto graphicsModule = TestGraphicsModule();
+    graphicsModule.init();
+    auto audioModule = TestAudioModule();
+    audioModule.init();
+    auto resourceModule = TestResourceModule();
+    resourceModule.init();
+    auto sceneGraph = MockSceneGraph();
+
+    auto modelNode = ModelNode(0, "node", glm::vec3(0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), false, nullptr);
+    auto oldParent = DummySceneNode(modelNode, sceneGraph, graphicsModule.services(), audioModule.services(), resourceModule.services());
+    auto newParent = DummySceneNode(modelNode, sceneGraph, graphicsModule.services(), audioModule.services(), resourceModule.services());
+    auto child1 = DummySceneNode(modelNode, sceneGraph, graphicsModule.services(), audioModule.services(), resourceModule.services());
+    auto child2 = DummySceneNode(modelNode, sceneGraph, graphicsModule.services(), audioModule.services(), resourceModule.services());
+    oldParent.addChild(child1);
+    oldParent.addChild(child2);
+
+    // when
+    newParent.addChild(child1);
+
+    // then
+    EXPECT_EQ(1ll, oldParent.children().size());
+    EXPECT_EQ(&child2, oldParent.children()[0]);
+    EXPECT_EQ(1ll, newParent.children().size());
+    EXPECT_EQ(&newParent, child1.parent());
+}
+
+TEST(SceneNode, should_only_compute_absolute_transforms_of_invalidated_subtrees) {
+    // given
+    auto graphicsModule = TestGraphicsModule();
+    graphicsModule.init();
+    auto audioModule = TestAudioModule();
+    audioModule.init();
+    auto resourceModule = TestResourceModule();
+    resourceModule.init();
+    auto sceneGraph = MockSceneGraph();
+
+    auto modelNode = ModelNode(0, "node", glm::vec3(0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), false, nullptr);
+    auto root = DummySceneNode(modelNode, sceneGraph, graphicsModule.services(), audioModule.services(), resourceModule.services());
+    auto child1 = DummySceneNode(modelNode, sceneGraph, graphicsModule.services(), audioModule.services(), resourceModule.services());
+    auto child2 = DummySceneNode(modelNode, sceneGraph, graphicsModule.services(), audioModule.services(), resourceModule.services());
+    auto grandChild = DummySceneNode(modelNode, sceneGraph, graphicsModule.services(), audioModule.services(), resourceModule.services());
+    root.addChild(child1);
+    root.addChild(child2);
+    child1.addChild(grandChild);
+    root.computeAbsoluteTransforms();
+    EXPECT_FALSE(root.hasInvalidatedAbsoluteTransforms());
+
+    // when
+    grandChild.setLocalTransform(glm::translate(glm::vec3(1.0f, 0.0f, 0.0f)));
+
+    // then
+    EXPECT_TRUE(root.hasInvalidatedAbsoluteTransforms());
+    EXPECT_TRUE(child1.hasInvalidatedAbsoluteTransforms());
+    EXPECT_FALSE(child2.hasInvalidatedAbsoluteTransforms());
+    root.computeAbsoluteTransforms();
+    EXPECT_FALSE(root.hasInvalidatedAbsoluteTransforms());
+    EXPECT_FALSE(grandChild.hasInvalidatedAbsoluteTransforms());
+    EXPECT_NEAR(1.0f, grandChild.origin().x, 1e-5);
+}
+
+TEST(SceneNode, should_mark_new_parent_when_adding_invalidated_child) {
+    // given
+    auto graphicsModule = TestGraphicsModule();
+    graphicsModule.init();
+    auto audioModule = TestAudioModule();
+    audioModule.init();
+    auto resourceModule = TestResourceModule();
+    resourceModule.init();
+    auto sceneGraph = MockSceneGraph();
+
+    auto modelNode = ModelNode(0, "node", glm::vec3(0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), false, nullptr);
+    auto parent = DummySceneNode(modelNode, sceneGraph, graphicsModule.services(), audioModule.services(), resourceModule.services());
+    auto child = DummySceneNode(modelNode, sceneGraph, graphicsModule.services(), audioModule.services(), resourceModule.services());
+    child.setLocalTransform(glm::translate(glm::vec3(1.0f, 0.0f, 0.0f)));
+    parent.computeAbsoluteTransforms();
+    EXPECT_FALSE(parent.hasInvalidatedAbsoluteTransforms());
+
+    // when
+    parent.addChild(child);
+
+    // then
+    EXPECT_TRUE(parent.hasInvalidatedAbsoluteTransforms());
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "reone/script/program.h"
+#include "reone/script/verifier.h"
+
+#include "../fixtures/script.h"
+
+using namespace reone;
+using namespace reone::script;
+
+using testing::Return;
+using testing::ReturnRef;
+
+TEST(ScriptVerifier, should_verify_program_with_subroutine) {
+    // given
+    auto program = ScriptProgram("some_program");
+    program.add(Instruction(InstructionType::RSADDI)); // 13
+    program.add(Instruction::newCONSTI(5));            // 15
+    program.add(Instruction::newJSR(8));               // 21
+    program.add(Instruction(InstructionType::RETN));   // 27
+    program.add(Instruction::newCPTOPSP(-4, 4));       // 29
+    program.add(Instruction::newCONSTI(2));            // 37
+    program.add(Instruction(InstructionType::MULII));  // 43
+    program.add(Instruction::newCPDOWNSP(-12, 4));     // 45
+    program.add(Instruction::newMOVSP(-8));            // 53
+    program.add(Instruction(InstructionType::RETN));   // 59
+
+    auto routines = MockRoutines();
+    EXPECT_CALL(routines, getNumRoutines()).WillRepeatedly(Return(0));
+    auto verifier = ScriptVerifier(routines);
+
+    // expect
+    EXPECT_NO_THROW(verifier.verify(program));
+}
+
+TEST(ScriptVerifier, should_verify_routine_call) {
+    // given
+    auto program = ScriptProgram("some_program");
+    program.add(Instruction::newCONSTS("some_tag"));
+    program.add(Instruction::newACTION(0, 1));
+    program.add(Instruction::newCONSTO(kObjectInvalid));
+    program.add(Instruction(InstructionType::EQUALOO));
+
+    auto routine = std::make_shared<MockRoutine>(
+        "GetObjectByTag",
+        VariableType::Object,
+        Variable::ofObject(kObjectInvalid),
+        std::vector<VariableType> {VariableType::String});
+    auto routines = MockRoutines();
+    EXPECT_CALL(routines, getNumRoutines()).WillRepeatedly(Return(1));
+    EXPECT_CALL(routines, get(0)).WillRepeatedly(ReturnRef(*routine));
+    auto verifier = ScriptVerifier(routines);
+
+    // expect
+    EXPECT_NO_THROW(verifier.verify(program));
+}
+
+TEST(ScriptVerifier, should_reject_type_mismatch) {
+    // given
+    auto program = ScriptProgram("some_program");
+    program.add(Instruction::newCONSTI(1));
+    program.add(Instruction::newCONSTS("some_tag"));
+    program.add(Instruction(InstructionType::ADDII));
+
+    auto routines = MockRoutines();
+    EXPECT_CALL(routines, getNumRoutines()).WillRepeatedly(Return(0));
+    auto verifier = ScriptVerifier(routines);
+
+    // expect
+    EXPECT_THROW(verifier.verify(program), std::runtime_error);
+}
+
+TEST(ScriptVerifier, should_reject_inconsistent_stack_at_join) {
+    // given
+    auto program = ScriptProgram("some_program");
+    program.add(Instruction::newCONSTI(0));          // 13
+    program.add(Instruction::newJZ(12));             // 19
+    program.add(Instruction::newCONSTI(1));          // 25
+    program.add(Instruction(InstructionType::RETN)); // 31
+
+    auto routines = MockRoutines();
+    EXPECT_CALL(routines, getNumRoutines()).WillRepeatedly(Return(0));
+    auto verifier = ScriptVerifier(routines);
+
+    // expect
+    EXPECT_THROW(verifier.verify(program), std::runtime_error);
+}
+
+TEST(ScriptVerifier, should_reject_type_mismatch_after_stored_state) {
+    // given
+    auto program = ScriptProgram("some_program");
+    program.add(Instruction::newCONSTI(3));              // 13
+    program.add(Instruction(InstructionType::SAVEBP));   // 19
+    program.add(Instruction::newCONSTI(7));              // 21
+    program.add(Instruction::newSTORE_STATE(4, 4));      // 27
+    program.add(Instruction::newJMP(30));                // 37
+    program.add(Instruction::newCPTOPBP(-4, 4));         // 43
+    program.add(Instruction::newCONSTS("some_tag"));     // 51
+    program.add(Instruction(InstructionType::ADDII));    // 63
+    program.add(Instruction(InstructionType::RETN));     // 65
+    program.add(Instruction(InstructionType::RETN));     // 67
+
+    auto routines = MockRoutines();
+    EXPECT_CALL(routines, getNumRoutines()).WillRepeatedly(Return(0));
+    auto verifier = ScriptVerifier(routines);
+
+    // expect
+    EXPECT_THROW(verifier.verify(program), std::runtime_error);
+}
@@ -17,6 +17,7 @@
 
 #include <gtest/gtest.h>
 
+#include "reone/script/enginetype.h"
 #include "reone/script/executioncontext.h"
 #include "reone/script/executionstate.h"
 #include "reone/script/program.h"
@@ -460,3 +461,136 @@ TEST(VirtualMachine, should_run_script_program__structs) {
     // then
     EXPECT_EQ(1, result);
 }
+
+TEST(VirtualMachine, should_resume_script_program_from_saved_state) {
+    // given
+    auto program = std::make_shared<ScriptProgram>("some_program");
+    program->add(Instruction::newCONSTI(1));           // 13
+    program->add(Instruction::newCONSTI(2));           // 19
+    program->add(Instruction(InstructionType::ADDII)); // 25
+
+    auto savedState = std::make_shared<ExecutionState>();
+    savedState->program = program;
+    savedState->locals.push_back(Variable::ofInt(40));
+    savedState->insOffset = 19;
+
+    auto context = std::make_unique<ExecutionContext>();
+    context->savedState = std::move(savedState);
+
+    auto machine = VirtualMachine(program, std::move(context));
+
+    // when
+    auto result = machine.run();
+
+    // then
+    EXPECT_EQ(42, result);
+    EXPECT_EQ(1, machine.getStackSize());
+}
+
+TEST(VirtualMachine, should_halt_script_program_on_invalid_jump_target) {
+    // given
+    auto program = std::make_shared<ScriptProgram>("some_program");
+    program->add(Instruction::newCONSTI(1));
+    program->add(Instruction::newJMP(3));
+    program->add(Instruction::newCONSTI(2));
+
+    auto context = std::make_unique<ExecutionContext>();
+    auto machine = VirtualMachine(program, std::move(context));
+
+    // when
+    auto result = machine.run();
+
+    // then
+    EXPECT_EQ(-1, result);
+    EXPECT_EQ(1, machine.getStackSize());
+}
+
+TEST(VirtualMachine, should_run_script_program__strings_and_engine_types) {
+    // given
+    auto program = std::make_shared<ScriptProgram>("some_program");
+    program->add(Instruction::newCONSTS("some_"));            // "some_"
+    program->add(Instruction::newCONSTS("tag"));              // "some_", "tag"
+    program->add(Instruction(InstructionType::ADDSS));        // "some_tag"
+    program->add(Instruction::newCPTOPSP(-4, 4));             // "some_tag", "some_tag"
+    program->add(Instruction::newCONSTS("some_tag"));         // "some_tag", "some_tag", "some_tag"
+    program->add(Instruction(InstructionType::EQUALSS));      // "some_tag", 1
+    program->add(Instruction::newACTION(0, 0));               // "some_tag", 1, effect
+    program->add(Instruction::newCPTOPSP(-4, 4));             // "some_tag", 1, effect, effect
+    program->add(Instruction(InstructionType::EQUALEFFEFF));  // "some_tag", 1, 1
+    program->add(Instruction(InstructionType::RSADDEFF));     // "some_tag", 1, 1, null effect
+    program->add(Instruction::newACTION(0, 0));               // "some_tag", 1, 1, null effect, effect
+    program->add(Instruction(InstructionType::NEQUALEFFEFF)); // "some_tag", 1, 1, 1
+
+    auto effect = std::make_shared<EngineType>();
+    auto routine = std::make_shared<MockRoutine>(
+        "EffectSomething",
+        VariableType::Effect,
+        Variable::ofEffect(effect),
+        std::vector<VariableType>());
+    auto routines = MockRoutines();
+    EXPECT_CALL(routines, get(0))
+        .WillRepeatedly(ReturnRef(*routine));
+
+    auto context = std::make_unique<ExecutionContext>();
+    context->routines = &routines;
+
+    auto machine = VirtualMachine(program, std::move(context));
+
+    // when
+    auto result = machine.run();
+
+    // then
+    EXPECT_EQ(1, result);
+    EXPECT_EQ(4, machine.getStackSize());
+    EXPECT_EQ(std::string("some_tag"), machine.getStackVariable(0).strValue);
+    EXPECT_EQ(1, machine.getStackVariable(1).intValue);
+    EXPECT_EQ(1, machine.getStackVariable(2).intValue);
+}
+
+TEST(VirtualMachine, should_run_verified_script_program) {
+    // given
+    auto program = std::make_shared<ScriptProgram>("some_program");
+    program->add(Instruction(InstructionType::RSADDI));
+    program->add(Instruction::newCONSTI(5));
+    program->add(Instruction::newJSR(8));
+    program->add(Instruction(InstructionType::RETN));
+    program->add(Instruction::newCPTOPSP(-4, 4));
+    program->add(Instruction::newCONSTI(2));
+    program->add(Instruction(InstructionType::MULII));
+    program->add(Instruction::newCPDOWNSP(-12, 4));
+    program->add(Instruction::newMOVSP(-8));
+    program->add(Instruction(InstructionType::RETN));
+    program->setVerified(true);
+
+    auto context = std::make_unique<ExecutionContext>();
+    auto machine = VirtualMachine(program, std::move(context));
+
+    // when
+    auto result = machine.run();
+
+    // then
+    EXPECT_EQ(10, result);
+    EXPECT_EQ(1, machine.getStackSize());
+}
+
+TEST(VirtualMachine, should_run_script_program_again_after_reset) {
+    // given
+    auto program = std::make_shared<ScriptProgram>("some_program");
+    program->add(Instruction::newCONSTS("some_tag"));
+    program->add(Instruction::newCONSTI(1));
+    program->add(Instruction::newCONSTI(2));
+    program->add(Instruction(InstructionType::ADDII));
+
+    auto context = std::make_unique<ExecutionContext>();
+    auto machine = VirtualMachine(program, std::move(context));
+    machine.run();
+
+    // when
+    machine.reset(program);
+    auto result = machine.run();
+
+    // then
+    EXPECT_EQ(3, result);
+    EXPECT_EQ(2, machine.getStackSize());
+    EXPECT_EQ(std::string("some_tag"), machine.getStackVariable(0).strValue);
+}
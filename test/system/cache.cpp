@@ -87,3 +87,19 @@ TEST(Cache, should_clear_cached_items) {
     // then
     EXPECT_TRUE(value && (*value) == 2);
 }
+
+TEST(Cache, should_add_value_unless_key_is_cached) {
+    // given
+    Cache<int, int> cache;
+    cache.add(1, std::make_shared<int>(10));
+
+    // when
+    cache.add(1, std::make_shared<int>(20));
+    cache.add(2, std::make_shared<int>(30));
+
+    // then
+    EXPECT_TRUE(cache.contains(1));
+    EXPECT_TRUE(cache.contains(2));
+    EXPECT_FALSE(cache.contains(3));
+    EXPECT_EQ(10, *cache.getOrAdd(1, []() { return std::make_shared<int>(0); }));
+}
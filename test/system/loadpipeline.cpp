@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "reone/system/loadpipeline.h"
+#include "reone/system/threadpool.h"
+
+using namespace reone;
+
+TEST(LoadPipeline, should_decode_on_workers_upload_on_caller_and_report_stage_timings) {
+    // given
+    ThreadPool pool(2);
+    pool.init();
+
+    auto callerThreadId = std::this_thread::get_id();
+    std::vector<std::string> rooms {"room01", "room02", "room03"};
+    std::map<std::string, std::string> roomTextures;
+    std::set<std::string> uploadedTextures;
+    std::atomic_int numDecodedOnCaller {0};
+    int numUploadedOffCaller = 0;
+    std::vector<float> progressValues;
+
+    auto pipeline = LoadPipeline(pool);
+    pipeline.addStage("rooms", [&](LoadPipeline::Stage &stage) {
+        for (auto &room : rooms) {
+            stage.addJob([&, room]() -> LoadPipeline::UploadFunc {
+                if (std::this_thread::get_id() == callerThreadId) {
+                    ++numDecodedOnCaller;
+                }
+                auto texture = room + "_lm";
+                return [&, room, texture]() {
+                    if (std::this_thread::get_id() != callerThreadId) {
+                        ++numUploadedOffCaller;
+                    }
+                    roomTextures[room] = texture;
+                };
+            });
+        }
+    });
+    pipeline.addStage("textures", [&](LoadPipeline::Stage &stage) {
+        for (auto &[_, texture] : roomTextures) {
+            stage.addJob([&, texture = texture]() -> LoadPipeline::UploadFunc {
+                return [&, texture]() {
+                    uploadedTextures.insert(texture);
+                };
+            });
+        }
+    });
+
+    // when
+    pipeline.run([&progressValues](float progress) {
+        progressValues.push_back(progress);
+    });
+
+    // then
+    EXPECT_EQ(0, numDecodedOnCaller);
+    EXPECT_EQ(0, numUploadedOffCaller);
+    EXPECT_EQ((std::set<std::string> {"room01_lm", "room02_lm", "room03_lm"}), uploadedTextures);
+    ASSERT_EQ(6ll, progressValues.size());
+    EXPECT_TRUE(std::is_sorted(progressValues.begin(), progressValues.end()));
+    EXPECT_FLOAT_EQ(0.5f, progressValues[2]);
+    EXPECT_FLOAT_EQ(1.0f, progressValues.back());
+    auto &timings = pipeline.timings();
+    ASSERT_EQ(2ll, timings.size());
+    for (auto &stage : timings) {
+        EXPECT_EQ(3, stage.numJobs);
+        EXPECT_GE(stage.decodeMs, 0.0f);
+        EXPECT_GE(stage.uploadMs, 0.0f);
+        RecordProperty(stage.name + "_decode_ms", std::to_string(stage.decodeMs));
+        RecordProperty(stage.name + "_upload_ms", std::to_string(stage.uploadMs));
+    }
+    EXPECT_EQ("rooms", timings[0].name);
+    EXPECT_EQ("textures", timings[1].name);
+}
+
+TEST(LoadPipeline, should_rethrow_decode_exception_after_draining_stage) {
+    // given
+    ThreadPool pool(2);
+    pool.init();
+
+    std::atomic_int numDecoded {0};
+    bool nextStageResolved = false;
+
+    auto pipeline = LoadPipeline(pool);
+    pipeline.addStage("failing", [&numDecoded](LoadPipeline::Stage &stage) {
+        for (int i = 0; i < 4; ++i) {
+            stage.addJob([&numDecoded, i]() -> LoadPipeline::UploadFunc {
+                ++numDecoded;
+                if (i == 1) {
+                    throw std::runtime_error("corrupt resource");
+                }
+                return nullptr;
+            });
+        }
+    });
+    pipeline.addStage("skipped", [&nextStageResolved](LoadPipeline::Stage &stage) {
+        nextStageResolved = true;
+    });
+
+    // when
+    EXPECT_THROW(pipeline.run(), std::runtime_error);
+
+    // then
+    EXPECT_EQ(4, numDecoded);
+    EXPECT_FALSE(nextStageResolved);
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2020-2023 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "reone/system/memorymappedfile.h"
+
+#include "../checkutil.h"
+
+using namespace reone;
+
+TEST(MemoryMappedFile, should_map_file_contents) {
+    // given
+
+    auto tmpPath = std::filesystem::temp_directory_path();
+    tmpPath.append("reone_test_memory_mapped_file");
+    auto tmpFile = std::ofstream(tmpPath);
+    tmpFile.write("Hello, world!", 13);
+    tmpFile.close();
+
+    auto file = MemoryMappedFile(tmpPath);
+    auto expectedContents = std::string("Hello, world!");
+
+    // when
+
+    file.init();
+    auto contents = std::string(file.data(), file.size());
+
+    // then
+
+    EXPECT_EQ(13ll, file.size());
+    EXPECT_EQ(expectedContents, contents) << notEqualMessage(expectedContents, contents);
+
+    // cleanup
+
+    std::filesystem::remove(tmpPath);
+}
@@ -75,3 +75,46 @@ TEST(ThreadPool, should_cancel_enqueued_task) {
     // then
     EXPECT_TRUE(exited);
 }
+
+TEST(ThreadPool, should_process_all_ranges_in_parallel_for) {
+    // given
+    ThreadPool pool;
+    pool.init();
+    std::vector<int> values(1000, 0);
+
+    // when
+    parallelFor(pool, values.size(), 64, [&values](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            values[i] += static_cast<int>(i);
+        }
+    });
+
+    // then
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(static_cast<int>(i), values[i]);
+    }
+}
+
+TEST(ThreadPool, should_not_block_on_busy_thread_pool_in_parallel_for) {
+    // given
+    ThreadPool pool(1);
+    pool.init();
+    std::atomic_bool released {false};
+    pool.enqueue([&released](auto &) {
+        while (!released) {
+            std::this_thread::yield();
+        }
+    });
+    std::atomic_int sum {0};
+
+    // when
+    parallelFor(pool, 100, 10, [&sum](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            sum += static_cast<int>(i);
+        }
+    });
+    released = true;
+
+    // then
+    EXPECT_EQ(4950, sum);
+}